@@ -20,10 +20,27 @@
 #include "stat.h"
 #include "util.h"
 #include "hpctimer.h"
+#include "rootpolicy.h"
+#include "histogram.h"
+#include "bootstrap.h"
+#include "straggler.h"
 #include "bench_coll_tab.h"
 
 #define TEST_SLOTLEN_SCALE 1.1
 
+enum {
+    PROCSTAT_TOPK = 5,              /* Slowest processes in per process report */
+    PROCDUMP_LINELEN = 256,         /* Bytes per process in dump file */
+    PROCDUMP_HEADER_LEN = 512
+};
+
+static MPI_File procdump_fh = MPI_FILE_NULL;
+static MPI_Offset procdump_offset = 0;
+
+static double median_ci_relwidth(double *exectime, int n, MPI_Comm comm);
+static int report_write_collbench_procstat(colltest_params_t *params,
+                                           double mean);
+
 /* run_collbench: Runs benchmark for collective operation */
 int run_collbench(collbench_t *bench)
 {
@@ -37,6 +54,14 @@ int run_collbench(collbench_t *bench)
     report_write_collbench_header(bench);
     if (mpiperf_perprocreport)
         report_write_collbench_procstat_header(bench);
+    if (mpiperf_procdump)
+        report_write_collbench_procdump_header(bench);
+    if (mpiperf_synctype == SYNC_TIME)
+        report_write_rootstat_header(bench->name);
+    if (mpiperf_histreport && IS_MASTER_RANK) {
+        fprintf(mpiperf_histstream, "# Benchmark: %s\n", bench->name);
+        histogram_write_header(mpiperf_histstream);
+    }
 
     /* For each communicator size */
     for (params.nprocs = mpiperf_nprocs_min;
@@ -67,7 +92,10 @@ int run_collbench(collbench_t *bench)
         }
     }
 
+    rootpolicy_stat_free();
     timeslot_finalize();
+    if (mpiperf_procdump)
+        report_collbench_procdump_close();
     MPI_Barrier(MPI_COMM_WORLD);
     benchtime = hpctimer_wtime() - benchtime;
     if (IS_MASTER_RANK) {
@@ -82,9 +110,10 @@ int run_collbench(collbench_t *bench)
  */
 int run_collbench_test(collbench_t *bench, colltest_params_t *params)
 {
-    int nruns, ncorrectruns;
+    int nruns, ncorrectruns, nwarmupruns;
     double time, *exectime = NULL;
     stat_sample_t *procstat = NULL;
+    histogram_t *prochist = NULL;
 
     MPI_Barrier(MPI_COMM_WORLD);
     logger_log("Test (nprocs = %d, count = %d) is started",
@@ -92,28 +121,45 @@ int run_collbench_test(collbench_t *bench, colltest_params_t *params)
 
     if (params->comm != MPI_COMM_NULL) {
         /* This process participates in measures */
-        if (mpiperf_perprocreport)
+        if (mpiperf_perprocreport || mpiperf_procdump)
             procstat = stat_sample_create();
+        if (mpiperf_histreport)
+            prochist = histogram_create();
 
         if (mpiperf_synctype == SYNC_TIME) {
             run_collbench_test_synctime(bench, params, &exectime, &nruns,
-                                        &ncorrectruns, procstat);
+                                        &ncorrectruns, &nwarmupruns, procstat,
+                                        prochist);
             report_write_colltest_synctime(bench, params, exectime, nruns,
-                                           ncorrectruns);
+                                           ncorrectruns, nwarmupruns);
+            if (bench->report)
+                bench->report();
+            report_write_rootstat(params->nprocs, params->count);
+            if (mpiperf_nstragglers > 0)
+                report_write_stragglers(params->comm, params->nprocs, params->count);
             if (mpiperf_perprocreport)
                 report_write_collbench_procstat_synctime(bench, params, procstat);
+            if (mpiperf_histreport)
+                report_write_collbench_histogram(bench, params, prochist);
         } else {
             run_collbench_test_nosync(bench, params, &time, &nruns, procstat);
             report_write_colltest_nosync(bench, params, time, nruns);
+            if (bench->report)
+                bench->report();
             if (mpiperf_perprocreport)
                 report_write_collbench_procstat_nosync(bench, params, procstat);
         }
 
-        if (mpiperf_perprocreport)
-            stat_sample_free(procstat);
+        histogram_free(prochist);
         free(exectime);
     }
 
+    /* All processes take part in collective write */
+    if (mpiperf_procdump)
+        report_write_collbench_procdump(bench, params, procstat);
+    if (procstat)
+        stat_sample_free(procstat);
+
     return MPIPERF_SUCCESS;
 }
 
@@ -129,36 +175,57 @@ int run_collbench_test(collbench_t *bench, colltest_params_t *params)
  */
 int run_collbench_test_synctime(collbench_t *bench, colltest_params_t *params,
                                 double **exectime, int *nmeasurements,
-                                int *ncorrect_measurements, stat_sample_t *procstat)
+                                int *ncorrect_measurements,
+                                int *nwarmup_measurements, stat_sample_t *procstat,
+                                histogram_t *prochist)
 {
     int i, stage, stage_nruns, nruns, ncorrectruns, exectime_size, nerrors;
-    double *stage_exectime = NULL, *exectime_reduced = NULL;
-    int *stagerc = NULL, *stagerc_reduced = NULL;
-    double stagetime, stagetime_max, slotlen;
-    stat_sample_t *timestat;
-
-    if ( (timestat = stat_sample_create()) == NULL) {
-        exit_error("No enough memory");
-    }
+    int nwarmupruns, nsteadyruns, commrank;
+    double *stage_exectime = NULL;
+    straggler_t *stage_straggler = NULL, *straggler_reduced = NULL;
+    int *stagerc = NULL, *stagerc_reduced = NULL, *stageroot = NULL;
+    double stagetime, stagetime_max, slotlen, rse;
+    double *run_localtime = NULL;
+    straggler_t *run_straggler = NULL;
+    int *run_root = NULL;
 
     /* Result execution time (exectime[i] - maximum time off all process) */
     exectime_size = TEST_STAGE_NRUNS;
     *exectime = xrealloc(*exectime, sizeof(**exectime) * exectime_size);
 
+    /*
+     * Local time, root and straggler of correct runs: they are added
+     * to per root, straggler and per process statistics after removing
+     * of transient prefix
+     */
+    run_localtime = xmalloc(sizeof(*run_localtime) * exectime_size);
+    run_straggler = xmalloc(sizeof(*run_straggler) * exectime_size);
+    run_root = xmalloc(sizeof(*run_root) * exectime_size);
+
     stage_nruns = TEST_STAGE_NRUNS_INIT;
     stage_exectime = xrealloc(stage_exectime, sizeof(*stage_exectime) *
                               TEST_STAGE_NRUNS);
     stagerc = xrealloc(stagerc, sizeof(*stagerc) * TEST_STAGE_NRUNS);
     stagerc_reduced = xrealloc(stagerc_reduced, sizeof(*stagerc_reduced) *
                                TEST_STAGE_NRUNS);
-    exectime_reduced = xrealloc(exectime_reduced, sizeof(*exectime_reduced) *
-                                TEST_STAGE_NRUNS);
+    stage_straggler = xrealloc(stage_straggler, sizeof(*stage_straggler) *
+                               TEST_STAGE_NRUNS);
+    straggler_reduced = xrealloc(straggler_reduced, sizeof(*straggler_reduced) *
+                                 TEST_STAGE_NRUNS);
+    stageroot = xrealloc(stageroot, sizeof(*stageroot) * TEST_STAGE_NRUNS);
+
+    params->root = rootpolicy_reset(params->nprocs);
+    rootpolicy_stat_reset(params->nprocs);
+    straggler_stat_reset();
+    MPI_Comm_rank(params->comm, &commrank);
 
     if (bench->init)
         bench->init(params);
 
     nruns = 0;
     ncorrectruns = 0;
+    nwarmupruns = 0;
+    rse = 0.0;
 
     slotlen = 0.0;
     timeslot_initialize_test(params->comm);
@@ -174,6 +241,7 @@ int run_collbench_test_synctime(collbench_t *bench, colltest_params_t *params,
         stagetime = hpctimer_wtime();
 
         for (i = 0; i < stage_nruns; i++) {
+            params->root = stageroot[i] = rootpolicy_next(params->nprocs);
             stagerc[i] = bench->collop(params, &stage_exectime[i]);
         }
 
@@ -196,26 +264,30 @@ int run_collbench_test_synctime(collbench_t *bench, colltest_params_t *params,
         /* Gather results (time and err. codes) of previous stage */
         MPI_Allreduce(stagerc, stagerc_reduced, stage_nruns,
                       MPI_INT, MPI_MAX, params->comm);
-        MPI_Allreduce(stage_exectime, exectime_reduced, stage_nruns,
-                      MPI_DOUBLE, MPI_MAX, params->comm);
+        for (i = 0; i < stage_nruns; i++)
+            straggler_set(&stage_straggler[i], stage_exectime[i], commrank);
+        straggler_allreduce(stage_straggler, straggler_reduced, stage_nruns,
+                            params->comm);
 
         /* Allocate memory for stage results */
         if (exectime_size < (ncorrectruns + stage_nruns)) {
             exectime_size *= TEST_REALLOC_GROWSTEP;
             *exectime = xrealloc(*exectime, sizeof(**exectime) * exectime_size);
+            run_localtime = xrealloc(run_localtime, sizeof(*run_localtime) *
+                                     exectime_size);
+            run_straggler = xrealloc(run_straggler, sizeof(*run_straggler) *
+                                     exectime_size);
+            run_root = xrealloc(run_root, sizeof(*run_root) * exectime_size);
         }
 
         nerrors = 0;
         for (i = 0; i < stage_nruns; i++) {
             if (stagerc_reduced[i] == MEASURE_SUCCESS) {
                 /* Add result to global list */
-                (*exectime)[ncorrectruns++] = exectime_reduced[i];
-                stat_sample_add(timestat, exectime_reduced[i]);
-
-                if (procstat) {
-                    /* Add to perprocess report */
-                    stat_sample_add(procstat, stage_exectime[i]);
-                }
+                run_localtime[ncorrectruns] = stage_exectime[i];
+                run_straggler[ncorrectruns] = straggler_reduced[i];
+                run_root[ncorrectruns] = stageroot[i];
+                (*exectime)[ncorrectruns++] = straggler_reduced[i].max;
                 logger_log("Measured time (stage %d, run %d): %.6f",
                            stage, i, stage_exectime[i]);
             } else {
@@ -228,19 +300,38 @@ int run_collbench_test_synctime(collbench_t *bench, colltest_params_t *params,
             }
         }
 
-        logger_log("Stage %d is finished: %d runs, %d invalid runs, RSE = %.2f",
-                   stage, stage_nruns, nerrors, stat_sample_stderr_rel(timestat));
+        /*
+         * Transient prefix (warmup) is detected on the whole sequence after
+         * each stage and is not counted in exit condition. All processes
+         * have the same exectime, so decisions are the same.
+         */
+        if (mpiperf_warmupdetect)
+            nwarmupruns = stat_dataset_transient_length(*exectime, ncorrectruns);
+        nsteadyruns = ncorrectruns - nwarmupruns;
+        rse = (nsteadyruns > 0) ?
+              stat_stderr_rel(*exectime + nwarmupruns, nsteadyruns) : 0.0;
+
+        logger_log("Stage %d is finished: %d runs, %d invalid runs, %d warmup runs, RSE = %.2f",
+                   stage, stage_nruns, nerrors, nwarmupruns, rse);
 
         /* Check exit condition */
         if (mpiperf_test_exit_cond == TEST_EXIT_COND_NRUNS) {
-            if ((ncorrectruns >= mpiperf_nmeasures_max ||
+            if ((nsteadyruns >= mpiperf_nmeasures_max ||
                 nruns >= mpiperf_nruns_max) && (nruns >= mpiperf_nruns_min))
             {
                 break;
             }
         } else if (mpiperf_test_exit_cond == TEST_EXIT_COND_STDERR) {
-            if (((stat_sample_stderr_rel(timestat) <= mpiperf_rse_max) &&
-                 ncorrectruns >= mpiperf_nruns_min) || (nruns >= mpiperf_nruns_max))
+            if (((rse <= mpiperf_rse_max) &&
+                 nsteadyruns >= mpiperf_nruns_min) || (nruns >= mpiperf_nruns_max))
+            {
+                break;
+            }
+        } else if (mpiperf_test_exit_cond == TEST_EXIT_COND_MEDIAN_CI) {
+            if ((nsteadyruns >= mpiperf_nruns_min &&
+                 median_ci_relwidth(*exectime + nwarmupruns, nsteadyruns,
+                                    params->comm) <= mpiperf_ciw_max) ||
+                (nruns >= mpiperf_nruns_max))
             {
                 break;
             }
@@ -255,11 +346,29 @@ int run_collbench_test_synctime(collbench_t *bench, colltest_params_t *params,
 
     } /* stages */
 
-    logger_log("Test is finished: %d runs, %d correct runs, RSE = %.2f",
-               nruns, ncorrectruns, stat_sample_stderr_rel(timestat));
+    /* Statistics of runs after transient prefix */
+    for (i = nwarmupruns; i < ncorrectruns; i++) {
+        rootpolicy_stat_add(run_root[i], run_straggler[i].max);
+        straggler_stat_add(&run_straggler[i], commrank);
+        if (procstat) {
+            /* Add to perprocess report */
+            stat_sample_add(procstat, run_localtime[i]);
+        }
+        if (prochist)
+            histogram_add(prochist, run_localtime[i]);
+    }
+
+    /* Remove transient prefix */
+    nsteadyruns = ncorrectruns - nwarmupruns;
+    for (i = 0; i < nsteadyruns; i++)
+        (*exectime)[i] = (*exectime)[i + nwarmupruns];
+
+    logger_log("Test is finished: %d runs, %d correct runs, %d warmup runs, RSE = %.2f",
+               nruns, ncorrectruns, nwarmupruns, rse);
 
     *nmeasurements = nruns;
-    *ncorrect_measurements = ncorrectruns;
+    *ncorrect_measurements = nsteadyruns;
+    *nwarmup_measurements = nwarmupruns;
 
     if (bench->free)
         bench->free();
@@ -267,8 +376,12 @@ int run_collbench_test_synctime(collbench_t *bench, colltest_params_t *params,
     free(stage_exectime);
     free(stagerc);
     free(stagerc_reduced);
-    free(exectime_reduced);
-    stat_sample_free(timestat);
+    free(stageroot);
+    free(stage_straggler);
+    free(straggler_reduced);
+    free(run_localtime);
+    free(run_straggler);
+    free(run_root);
 
     return MPIPERF_SUCCESS;
 }
@@ -286,6 +399,7 @@ int run_collbench_test_nosync(collbench_t *bench, colltest_params_t *params,
     double t, time;
     int i;
 
+    params->root = rootpolicy_reset(params->nprocs);
     if (bench->init)
         bench->init(params);
 
@@ -297,6 +411,7 @@ int run_collbench_test_nosync(collbench_t *bench, colltest_params_t *params,
     mpiperf_is_measure_started = 1;
     t = hpctimer_wtime();
     for (i = 0; i < mpiperf_nruns_max; i++) {
+        params->root = rootpolicy_next(params->nprocs);
         bench->collop(params, &time);
     }
     t = (hpctimer_wtime() - t) / mpiperf_nruns_max;
@@ -348,18 +463,29 @@ int report_write_collbench_header(collbench_t *bench)
         printf("#   Procs - total number of processes\n");
         printf("#   Count - count of elements in send/recv buffer\n");
         printf("#   TRuns - total number of measurements (valid and invalid measurements)\n");
-        printf("#   CRuns - number of correct measurements (only valid)\n");
+        printf("#   WRuns - number of correct measurements of warmup transient (discarded, -J)\n");
+        printf("#   CRuns - number of correct measurements (only valid, after warmup transient)\n");
         printf("#   FRuns - number of correct measurements after statistical analysis (removing of outliers)\n");
         printf("#   Mean - arithmetic mean of execution time (based on FRuns)\n");
         printf("#   RSE - relative standard error (StdErr / Mean)\n");
         printf("#   StdErr - standard error of the mean: StdDev / sqrt(FRuns)\n");
         printf("#   Min - minimal value\n");
         printf("#   Max - miximal value\n");
-        printf("#   CL - confidence level: 90%%, 95%% or 99%%\n");
+        printf("#   CL - confidence level (-C)\n");
         printf("#   Err - error of measurements: t_student * StdErr\n");
         printf("#   CI LB - lower bound of confidence interval: Mean - Err\n");
         printf("#   CI UB - upper bound of confidence interval: Mean + Err\n");
         printf("#   RelErr - relative error of measurements: Err / Mean\n");
+        printf("#   Median, P90, P99, P99.9 - quantiles of execution time (based on CRuns)\n");
+        if (mpiperf_bootstrap_nreplicates > 0) {
+            printf("#   Median LB, ..., P99.9 UB - bounds of bootstrap confidence intervals of quantiles (percentile method, CL)\n");
+        }
+        printf("#   State - stationarity of CRuns: ok, drift (CUSUM of mean) or period (autocorrelation)\n");
+        if (mpiperf_nstragglers > 0) {
+            printf("#   Straggler - process which was the slowest in runs of test (top %d by excess time),\n",
+                   mpiperf_nstragglers);
+            printf("#     excess - sum of differences between times of the slowest and the second slowest processes\n");
+        }
 
         if (mpiperf_synctype == SYNC_TIME) {
             printf("#\n");
@@ -369,15 +495,19 @@ int report_write_collbench_header(collbench_t *bench)
             printf("#\n");
             printf("# ------------------------------------------------------------------\n");
             printf("# Benchmark: %s\n", bench->name);
-            printf("# Confidence level (CL): %d%%\n", mpiperf_confidence_level);
+            printf("# Confidence level (CL): %g%%\n", mpiperf_confidence_level);
             printf("# ------------------------------------------------------------------\n");
             if (mpiperf_timescale == TIMESCALE_SEC) {
-                printf("# [Procs] [Count]     [TRuns] [CRuns] [FRuns] [Mean]       [RSE]      [StdErr]     [Min]        [Max]        [Err]        [CI LB]      [CI UB]      [RelErr]\n");
+                printf("# [Procs] [Count]     [TRuns] [WRuns] [CRuns] [FRuns] [Mean]       [RSE]      [StdErr]     [Min]        [Max]        [Err]        [CI LB]      [CI UB]      [RelErr]   [Median]     [P90]        [P99]        [P99.9]      [State]");
+                if (mpiperf_bootstrap_nreplicates > 0)
+                    printf(" [Median LB]  [Median UB]  [P90 LB]     [P90 UB]     [P99 LB]     [P99 UB]     [P99.9 LB]   [P99.9 UB]");
             } else {
                 /* usec */
-                printf("# [Procs] [Count]     [TRuns] [CRuns] [FRuns] [Mean]         [RSE]      [StdErr]       [Min]          [Max]          [Err]          [CI LB]        [CI UB]        [RelErr]\n");
+                printf("# [Procs] [Count]     [TRuns] [WRuns] [CRuns] [FRuns] [Mean]         [RSE]      [StdErr]       [Min]          [Max]          [Err]          [CI LB]        [CI UB]        [RelErr]   [Median]       [P90]          [P99]          [P99.9]        [State]");
+                if (mpiperf_bootstrap_nreplicates > 0)
+                    printf(" [Median LB]    [Median UB]    [P90 LB]       [P90 UB]       [P99 LB]       [P99 UB]       [P99.9 LB]     [P99.9 UB]");
             }
-            printf("#\n");
+            printf("\n#\n");
         } else {
             printf("#\n");
             printf("# ------------------------------------------------------------------\n");
@@ -397,45 +527,80 @@ int report_write_collbench_header(collbench_t *bench)
 }
 
 int report_write_colltest_synctime(collbench_t *bench, colltest_params_t *params,
-                                   double *exectime, int nruns, int ncorrectruns)
+                                   double *exectime, int nruns, int ncorrectruns,
+                                   int nwarmupruns)
 {
     double exectime_mean, exectime_stderr, exectime_rse, exectime_min,
            exectime_max, exectime_errrel;
     double exectime_ci_lb = 0.0, exectime_ci_ub = 0.0, exectime_err = 0.0;
-    int nresultruns = 0;
+    double quantiles[STAT_NQUANTILES];
+    double quantile_lb[STAT_NQUANTILES], quantile_ub[STAT_NQUANTILES];
+    int i, nresultruns = 0, stationarity;
     stat_sample_t *sample;
-    const char *fmt = NULL;
+    const char *fmt = NULL, *bootstrap_fmt = "\n";
     double timescale;
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
-        fmt = "  %-7d %-11d %-7d %-7d %-7d %-12.6f %-10.2f %-12.6f %-12.6f "
-              "%-12.6f %-12.6f %-12.6f %-12.6f %-10.2f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-7d %-7d %-12.6f %-10.2f %-12.6f %-12.6f "
+              "%-12.6f %-12.6f %-12.6f %-12.6f %-10.2f %-12.6f %-12.6f "
+              "%-12.6f %-12.6f %-7s";
+        if (mpiperf_bootstrap_nreplicates > 0) {
+            bootstrap_fmt = " %-12.6f %-12.6f %-12.6f %-12.6f %-12.6f %-12.6f "
+                            "%-12.6f %-12.6f\n";
+        }
         timescale = 1.0;
     } else {
         /* usec */
-        fmt = "  %-7d %-11d %-7d %-7d %-7d %-14.2f %-10.2f %-14.2f %-14.2f "
-            "%-14.2f %-14.2f %-14.2f %-14.2f %-10.2f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-7d %-7d %-14.2f %-10.2f %-14.2f %-14.2f "
+            "%-14.2f %-14.2f %-14.2f %-14.2f %-10.2f %-14.2f %-14.2f "
+            "%-14.2f %-14.2f %-7s";
+        if (mpiperf_bootstrap_nreplicates > 0) {
+            bootstrap_fmt = " %-14.2f %-14.2f %-14.2f %-14.2f %-14.2f %-14.2f "
+                            "%-14.2f %-14.2f\n";
+        }
         timescale = 1E6;
     }
 
     if (ncorrectruns == 0 && IS_MASTER_RANK) {
-        printf(fmt, params->nprocs, params->count, nruns, 0, 0, 0.0, 0.0,
-               0.0, 0, 0.0, 0.0, 0.0, 0.0, 0.0);
+        printf(fmt, params->nprocs, params->count, nruns, nwarmupruns, 0, 0,
+               0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+               0.0, "-");
+        printf(bootstrap_fmt, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
         return MPIPERF_SUCCESS;
     }
 
+    if (mpiperf_bootstrap_nreplicates > 0 && ncorrectruns > 0) {
+        /* Replicates are computed by all processes (exectime is the same) */
+        bootstrap_quantiles_ci(exectime, ncorrectruns,
+                               mpiperf_bootstrap_nreplicates,
+                               mpiperf_confidence_level, params->comm, NULL,
+                               quantile_lb, quantile_ub);
+        for (i = 0; i < STAT_NQUANTILES; i++) {
+            quantile_lb[i] *= timescale;
+            quantile_ub[i] *= timescale;
+        }
+    }
+
     if (IS_MASTER_RANK) {
         if ( (sample = stat_sample_create()) == NULL)
             return MPIPERF_FAILURE;
 
+        /* Order of runs is changed by removing of outliers */
+        stationarity = stat_dataset_stationarity(exectime, ncorrectruns);
+
+        /*
+         * Quantiles are computed exactly before removing of outliers (tails),
+         * by the same estimator as bootstrap intervals
+         */
+        stat_dataset_quantiles(exectime, ncorrectruns, quantiles);
+        for (i = 0; i < STAT_NQUANTILES; i++)
+            quantiles[i] *= timescale;
+
         /* Remove outliers */
         nresultruns = ncorrectruns;
         if (mpiperf_statanalysis) {
-            /* Remove 25% of minimal values and 25% of maximal values */
-            nresultruns = stat_dataset_remove_outliers(exectime,
-                                                       ncorrectruns,
-                                                       OUTLIERS_FILTER_MIN,
-                                                       OUTLIERS_FILTER_MAX);
+            nresultruns = stat_dataset_filter_outliers(exectime, ncorrectruns,
+                                                       &mpiperf_outliers);
         }
 
         stat_sample_add_dataset(sample, exectime, nresultruns);
@@ -446,7 +611,7 @@ int report_write_colltest_synctime(collbench_t *bench, colltest_params_t *params
         exectime_max = stat_sample_max(sample) * timescale;
 
         /* Build confidence interval */
-        stat_sample_confidence_interval(sample, mpiperf_confidence_level_type,
+        stat_sample_confidence_interval(sample, mpiperf_confidence_level,
                                         &exectime_ci_lb, &exectime_ci_ub,
                                         &exectime_err);
         exectime_ci_lb *= timescale;
@@ -454,10 +619,18 @@ int report_write_colltest_synctime(collbench_t *bench, colltest_params_t *params
         exectime_err *= timescale;
         exectime_errrel = (exectime_err > 0.0) ? exectime_err / exectime_mean : 0.0;
 
-        printf(fmt, params->nprocs, params->count, nruns, ncorrectruns,
-               nresultruns, exectime_mean, exectime_rse, exectime_stderr,
-               exectime_min, exectime_max, exectime_err, exectime_ci_lb,
-               exectime_ci_ub, exectime_errrel);
+        printf(fmt, params->nprocs, params->count, nruns, nwarmupruns,
+               ncorrectruns, nresultruns, exectime_mean, exectime_rse,
+               exectime_stderr, exectime_min, exectime_max, exectime_err,
+               exectime_ci_lb, exectime_ci_ub, exectime_errrel,
+               quantiles[STAT_QUANTILE_MEDIAN], quantiles[STAT_QUANTILE_P90],
+               quantiles[STAT_QUANTILE_P99], quantiles[STAT_QUANTILE_P999],
+               stat_stationarity_name(stationarity));
+        printf(bootstrap_fmt,
+               quantile_lb[STAT_QUANTILE_MEDIAN], quantile_ub[STAT_QUANTILE_MEDIAN],
+               quantile_lb[STAT_QUANTILE_P90], quantile_ub[STAT_QUANTILE_P90],
+               quantile_lb[STAT_QUANTILE_P99], quantile_ub[STAT_QUANTILE_P99],
+               quantile_lb[STAT_QUANTILE_P999], quantile_ub[STAT_QUANTILE_P999]);
 
         stat_sample_free(sample);
     }
@@ -503,196 +676,275 @@ int report_write_collbench_procstat_header(collbench_t *bench)
     fprintf(mpiperf_repstream, "# Characteristics of measurements:\n");
     fprintf(mpiperf_repstream, "#   Procs - total number of processes\n");
     fprintf(mpiperf_repstream, "#   Count - count of elements in send/recv buffer\n");
-    fprintf(mpiperf_repstream, "#   Rank - rank of process\n");
-    fprintf(mpiperf_repstream, "#   CRuns - number of correct measurements (only valid runs)\n");
-    fprintf(mpiperf_repstream, "#   Mean - arithmetic mean of execution time (based on FRuns)\n");
-    fprintf(mpiperf_repstream, "#   RSE - relative standard error (StdErr / Mean)\n");
-    fprintf(mpiperf_repstream, "#   StdErr - standard error of the mean: StdDev / sqrt(FRuns)\n");
-    fprintf(mpiperf_repstream, "#   Min - minimal value\n");
-    fprintf(mpiperf_repstream, "#   Max - miximal value\n");
-    fprintf(mpiperf_repstream, "#   CL - confidence level: 90%%, 95%% or 99%%\n");
-    fprintf(mpiperf_repstream, "#   Err - error of measurements: t_student * StdErr\n");
-    fprintf(mpiperf_repstream, "#   CI LB - lower bound of confidence interval: Mean - Err\n");
-    fprintf(mpiperf_repstream, "#   CI UB - upper bound of confidence interval: Mean + Err\n");
-    fprintf(mpiperf_repstream, "#   RelErr - relative error of measurements: Err / Mean\n");
+    fprintf(mpiperf_repstream, "#   Min, Median, Max, Mean - distribution of Mean of processes\n");
+    fprintf(mpiperf_repstream, "#     (Median is estimated by merged histogram of Mean of processes)\n");
+    fprintf(mpiperf_repstream, "#   Slowest - top %d processes with maximal Mean: rank:Mean\n",
+            PROCSTAT_TOPK);
+    fprintf(mpiperf_repstream, "# Each line is followed by histogram of Mean of processes:\n");
+    fprintf(mpiperf_repstream, "#   [Procs] [Count] [LB] [UB] [Runs] [Fraction] [Cumulative],\n");
+    fprintf(mpiperf_repstream, "#   where Runs is a number of processes with Mean in [LB, UB)\n");
     fprintf(mpiperf_repstream, "#\n");
 
     if (mpiperf_synctype == SYNC_TIME) {
         fprintf(mpiperf_repstream, "# Value of Mean in process i is computed as\n");
         fprintf(mpiperf_repstream, "# mean_of_runs(t[i][1], ..., t[i][CRuns])),\n");
         fprintf(mpiperf_repstream, "# where t[i][j] is a time of process i at measure j = 1, 2, ..., CRuns\n");
-        fprintf(mpiperf_repstream, "#\n");
-        fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
-        fprintf(mpiperf_repstream, "# Benchmark: %s \n", bench->name);
-        fprintf(mpiperf_repstream, "# Confidence level (CL): %d%%\n", mpiperf_confidence_level);
-        fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
-
-        if (mpiperf_timescale == TIMESCALE_SEC) {
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [CRuns] [Mean]       [RSE]      [StdErr]     [Min]        [Max]       [Err]        [CI LB]      [CI UB]      [RelErr]\n");
-        } else {
-            /* usec */
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [CRuns] [Mean]         [RSE]      [StdErr]       [Min]          [Max]         [Err]          [CI LB]        [CI UB]        [RelErr]\n");
-        }
     } else {
-        /* NOSYNC */
-        fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
-        fprintf(mpiperf_repstream, "# Benchmark: %s \n", bench->name);
         fprintf(mpiperf_repstream, "# Pipelined measurements\n");
-        fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
-        if (mpiperf_timescale == TIMESCALE_SEC) {
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [Mean]\n");
-        } else {
-            /* usec */
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [Mean]\n");
-        }
+    }
+    fprintf(mpiperf_repstream, "#\n");
+    fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
+    fprintf(mpiperf_repstream, "# Benchmark: %s \n", bench->name);
+    fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fprintf(mpiperf_repstream, "# [Procs] [Count]     [Min]        [Median]     [Max]        [Mean]       [Slowest]\n");
+    } else {
+        /* usec */
+        fprintf(mpiperf_repstream, "# [Procs] [Count]     [Min]          [Median]       [Max]          [Mean]         [Slowest]\n");
     }
     fprintf(mpiperf_repstream, "#\n");
     return MPIPERF_SUCCESS;
 }
 
-int report_write_collbench_procstat_synctime(collbench_t *bench,
-                                             colltest_params_t *params,
-                                             stat_sample_t *procstat)
+/*
+ * report_write_collbench_procstat: Writes distribution of Mean of processes
+ *                                  (one MPI_Reduce of histograms) and top-k
+ *                                  slowest processes (k MPI_Allreduce with
+ *                                  MPI_MAXLOC). Memory and output do not
+ *                                  depend on number of processes.
+ */
+static int report_write_collbench_procstat(colltest_params_t *params,
+                                           double mean)
 {
-    enum { NSTAT_PARAMS = 9 };
-    double statparams[NSTAT_PARAMS], *allstat = NULL;
-    double lb, ub, err, errrel;
-    const char *fmt = NULL;
-    double timescale = 0;
-    int i;
+    struct {
+        double val;
+        int rank;
+    } in, out;
+    histogram_t *hist, *allhist = NULL;
+    char slowest[PROCSTAT_TOPK * 32];
+    const char *fmt = NULL, *slowest_fmt = NULL;
+    double timescale;
+    int i, k, len, rank;
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
-        fmt = "  %-7d %-11d %-7d %-7d %-12.6f %-10.2f %-12.6f %-12.6f %-12.6f"
-              "%-12.6f %-12.6f %-12.6f %-10.2f\n";
+        fmt = "  %-7d %-11d %-12.6f %-12.6f %-12.6f %-12.6f %s\n";
+        slowest_fmt = "%s%d:%.6f";
         timescale = 1.0;
     } else {
         /* usec */
-        fmt = "  %-7d %-11d %-7d %-7d %-14.2f %-10.2f %-14.2f %-14.2f %-14.2f"
-              "%-14.2f %-14.2f %-14.2f %-10.2f\n";
+        fmt = "  %-7d %-11d %-14.2f %-14.2f %-14.2f %-14.2f %s\n";
+        slowest_fmt = "%s%d:%.2f";
         timescale = 1E6;
     }
 
+    if ( (hist = histogram_create()) == NULL)
+        exit_error("Can't allocate memory for histogram");
     if (IS_MASTER_RANK) {
-        allstat = xmalloc(sizeof(*allstat) * NSTAT_PARAMS * params->nprocs);
+        if ( (allhist = histogram_create()) == NULL)
+            exit_error("Can't allocate memory for histogram");
+    }
+    histogram_add(hist, mean);
+    histogram_reduce(hist, allhist, mpiperf_master_rank, params->comm);
+
+    /* Selected process takes part in next rounds with value -1 */
+    MPI_Comm_rank(params->comm, &rank);
+    in.val = mean;
+    in.rank = rank;
+    k = (params->nprocs < PROCSTAT_TOPK) ? params->nprocs : PROCSTAT_TOPK;
+    len = 0;
+    slowest[0] = '\0';
+    for (i = 0; i < k; i++) {
+        MPI_Allreduce(&in, &out, 1, MPI_DOUBLE_INT, MPI_MAXLOC, params->comm);
+        if (out.rank == rank)
+            in.val = -1.0;
+        if (IS_MASTER_RANK && len < (int)sizeof(slowest)) {
+            len += snprintf(slowest + len, sizeof(slowest) - len, slowest_fmt,
+                            (i > 0) ? " " : "", out.rank, out.val * timescale);
+        }
     }
-
-    stat_sample_confidence_interval(procstat, mpiperf_confidence_level_type, &lb, &ub, &err);
-    statparams[0] = stat_sample_mean(procstat) * timescale;
-    statparams[1] = stat_sample_stderr(procstat) * timescale;
-    statparams[2] = stat_sample_stderr_rel(procstat);
-    statparams[3] = stat_sample_min(procstat) * timescale;
-    statparams[4] = stat_sample_max(procstat) * timescale;
-    statparams[5] = (double)stat_sample_size(procstat);
-    statparams[6] = lb * timescale;
-    statparams[7] = ub * timescale;
-    statparams[8] = err * timescale;
-
-    /* Gather statistics: T_mem  = O(n) */
-    MPI_Gather(statparams, NSTAT_PARAMS, MPI_DOUBLE, allstat, NSTAT_PARAMS,
-               MPI_DOUBLE, mpiperf_master_rank, params->comm);
 
     if (IS_MASTER_RANK) {
-        for (i = 0; i < params->nprocs; i++) {
-            if ((int)allstat[i * NSTAT_PARAMS + 5] > 0) {
-                /* Sample is not empty: samplesize > 0 */
-                errrel = 0.0;
-                if (allstat[i * NSTAT_PARAMS + 8] > 0.0) {
-                    /* err > 0 */
-                    errrel = allstat[i * NSTAT_PARAMS + 8] /
-                             allstat[i * NSTAT_PARAMS + 0];
-                }
-                fprintf(mpiperf_repstream, fmt, params->nprocs, params->count, i,
-                        (int)allstat[i * NSTAT_PARAMS + 5], /* Runs */
-                        allstat[i * NSTAT_PARAMS + 0],      /* Mean */
-                        allstat[i * NSTAT_PARAMS + 2],      /* RSE */
-                        allstat[i * NSTAT_PARAMS + 1],      /* StdErr */
-                        allstat[i * NSTAT_PARAMS + 3],      /* Min */
-                        allstat[i * NSTAT_PARAMS + 4],      /* Max */
-                        allstat[i * NSTAT_PARAMS + 8],      /* Err */
-                        allstat[i * NSTAT_PARAMS + 6],      /* CI LB */
-                        allstat[i * NSTAT_PARAMS + 7],      /* CI UB */
-                        errrel                              /* Err / Mean */
-                       );
-            } else {
-                /* Empty sample */
-                fprintf(mpiperf_repstream, fmt, params->nprocs, params->count, i,
-                        0,    /* Runs */
-                        0.0,  /* Mean */
-                        0.0,  /* RSE */
-                        0.0,  /* StdErr */
-                        0.0,  /* Min */
-                        0.0,  /* Max */
-                        0.0,  /* Err */
-                        0.0,  /* CI LB */
-                        0.0,  /* CI UB */
-                        0.0   /* Err / Mean */
-                       );
-            }
-        } /* for nprocs */
-
-        /* Other processes did't participate in test */
-        /*
-        for (i = params->nprocs; i < mpiperf_commsize; i++) {
-            fprintf(mpiperf_repstream, fmt, params->nprocs, params->count, i,
-                    0,
-                    0.0,
-                    0.0,
-                    0.0,
-                    0.0,
-                    0.0,
-                    0.0,
-                    0.0,
-                    0.0,
-                    0.0
-                   );
-        }
-        */
-        /*
-        fprintf(mpiperf_repstream, "\n");
-        */
+        fprintf(mpiperf_repstream, fmt, params->nprocs, params->count,
+                histogram_min(allhist) * timescale,
+                histogram_quantile(allhist, 0.5) * timescale,
+                histogram_max(allhist) * timescale,
+                histogram_mean(allhist) * timescale, slowest);
+        histogram_write(allhist, mpiperf_repstream, params->nprocs,
+                        params->count, timescale);
+        histogram_free(allhist);
     }
+    histogram_free(hist);
+    return MPIPERF_SUCCESS;
+}
 
+int report_write_collbench_procstat_synctime(collbench_t *bench,
+                                             colltest_params_t *params,
+                                             stat_sample_t *procstat)
+{
+    return report_write_collbench_procstat(params, stat_sample_mean(procstat));
+}
+
+/*
+ * report_write_collbench_procdump_header: Creates per process dump file
+ *                                         (collective on MPI_COMM_WORLD).
+ */
+int report_write_collbench_procdump_header(collbench_t *bench)
+{
+    char header[PROCDUMP_HEADER_LEN];
+    int len;
+
+    if (MPI_File_open(MPI_COMM_WORLD, mpiperf_procdumpfile,
+                      MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                      &procdump_fh) != MPI_SUCCESS)
+    {
+        exit_error("Can't open per process dump file: %s", mpiperf_procdumpfile);
+    }
+    MPI_File_set_size(procdump_fh, 0);
+
+    len = snprintf(header, sizeof(header),
+        "# Benchmark: %s\n"
+        "# Per process statistics (one line of %d bytes per process)\n"
+        "# Time scale: %s\n"
+        "# [Procs] [Count] [Rank] [CRuns] [Mean] [RSE] [StdErr] [Min] [Max]"
+        " [Err] [CI LB] [CI UB] [RelErr] [Median] [P90] [P99] [P99.9]\n",
+        bench->name, PROCDUMP_LINELEN,
+        (mpiperf_timescale == TIMESCALE_SEC) ? "seconds" : "microseconds");
     if (IS_MASTER_RANK) {
-        free(allstat);
+        MPI_File_write_at(procdump_fh, 0, header, len, MPI_CHAR,
+                          MPI_STATUS_IGNORE);
     }
+    procdump_offset = len;
     return MPIPERF_SUCCESS;
 }
 
-int report_write_collbench_procstat_nosync(collbench_t *bench,
-                                           colltest_params_t *params,
-                                           stat_sample_t *procstat)
+/*
+ * report_write_collbench_procdump: Writes line of each process of test
+ *                                  by collective MPI-IO at offset of rank
+ *                                  (processes without procstat write
+ *                                  nothing). Collective on MPI_COMM_WORLD.
+ */
+int report_write_collbench_procdump(collbench_t *bench,
+                                    colltest_params_t *params,
+                                    stat_sample_t *procstat)
 {
-    double exectime, *allstat = NULL;
+    enum { NSTAT_PARAMS = 9 + STAT_NQUANTILES };
+    char line[PROCDUMP_LINELEN + 1];
+    double stat[NSTAT_PARAMS], timescale;
     const char *fmt = NULL;
-    double timescale = 0;
-    int i;
+    int i, len = 0, rank = 0;
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
-        fmt = "  %-7d %-11d %-7d %-7d %-12.6f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-12.6f %-10.2f %-12.6f %-12.6f %-12.6f "
+              "%-12.6f %-12.6f %-12.6f %-10.2f %-12.6f %-12.6f %-12.6f %-12.6f";
         timescale = 1.0;
     } else {
         /* usec */
-        fmt = "  %-7d %-11d %-7d %-7d %-14.2f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-14.2f %-10.2f %-14.2f %-14.2f %-14.2f "
+              "%-14.2f %-14.2f %-14.2f %-10.2f %-14.2f %-14.2f %-14.2f %-14.2f";
         timescale = 1E6;
     }
 
-    if (IS_MASTER_RANK) {
-        allstat = xmalloc(sizeof(*allstat) * mpiperf_commsize);
+    if (procstat) {
+        MPI_Comm_rank(params->comm, &rank);
+        for (i = 0; i < NSTAT_PARAMS; i++)
+            stat[i] = 0.0;
+        if (stat_sample_size(procstat) > 0) {
+            stat_sample_confidence_interval(procstat, mpiperf_confidence_level,
+                                            &stat[6], &stat[7], &stat[5]);
+            stat[0] = stat_sample_mean(procstat);
+            stat[1] = stat_sample_stderr_rel(procstat);
+            stat[2] = stat_sample_stderr(procstat);
+            stat[3] = stat_sample_min(procstat);
+            stat[4] = stat_sample_max(procstat);
+            stat[8] = (stat[5] > 0.0) ? stat[5] / stat[0] : 0.0;
+            for (i = 0; i < STAT_NQUANTILES; i++)
+                stat[9 + i] = stat_sample_quantile(procstat, i);
+        }
+        len = snprintf(line, sizeof(line), fmt, params->nprocs, params->count,
+                       rank, stat_sample_size(procstat),
+                       stat[0] * timescale,     /* Mean */
+                       stat[1],                 /* RSE */
+                       stat[2] * timescale,     /* StdErr */
+                       stat[3] * timescale,     /* Min */
+                       stat[4] * timescale,     /* Max */
+                       stat[5] * timescale,     /* Err */
+                       stat[6] * timescale,     /* CI LB */
+                       stat[7] * timescale,     /* CI UB */
+                       stat[8],                 /* Err / Mean */
+                       stat[9] * timescale,     /* Median */
+                       stat[10] * timescale,    /* P90 */
+                       stat[11] * timescale,    /* P99 */
+                       stat[12] * timescale);   /* P99.9 */
+        /* Fixed length of lines: offset of process is known without scan */
+        for (i = (len < PROCDUMP_LINELEN) ? len : PROCDUMP_LINELEN - 1;
+             i < PROCDUMP_LINELEN - 1; i++)
+        {
+            line[i] = ' ';
+        }
+        line[PROCDUMP_LINELEN - 1] = '\n';
+        len = PROCDUMP_LINELEN;
     }
+    MPI_File_write_at_all(procdump_fh,
+                          procdump_offset + (MPI_Offset)rank * PROCDUMP_LINELEN,
+                          line, len, MPI_CHAR, MPI_STATUS_IGNORE);
+    procdump_offset += (MPI_Offset)params->nprocs * PROCDUMP_LINELEN;
+    return MPIPERF_SUCCESS;
+}
 
-    exectime = stat_sample_mean(procstat) * timescale;
-    MPI_Gather(&exectime, 1, MPI_DOUBLE, allstat, 1, MPI_DOUBLE,
-               mpiperf_master_rank, params->comm);
+void report_collbench_procdump_close()
+{
+    MPI_File_close(&procdump_fh);
+}
+
+/*
+ * report_write_collbench_histogram: Merges histograms of time of processes
+ *                                   and writes distribution of time
+ *                                   of the whole job (raw samples are not
+ *                                   gathered).
+ */
+int report_write_collbench_histogram(collbench_t *bench,
+                                     colltest_params_t *params,
+                                     histogram_t *prochist)
+{
+    histogram_t *hist = NULL;
+    double timescale;
 
+    timescale = (mpiperf_timescale == TIMESCALE_SEC) ? 1.0 : 1E6;
     if (IS_MASTER_RANK) {
-        for (i = 0; i < params->nprocs; i++) {
-            fprintf(mpiperf_repstream, fmt, params->nprocs, params->count, i,
-                    mpiperf_nruns_max, allstat[i]);
-        }
+        if ( (hist = histogram_create()) == NULL)
+            exit_error("Can't allocate memory for histogram");
     }
-
+    histogram_reduce(prochist, hist, mpiperf_master_rank, params->comm);
     if (IS_MASTER_RANK) {
-        free(allstat);
+        histogram_write(hist, mpiperf_histstream, params->nprocs,
+                        params->count, timescale);
+        histogram_free(hist);
     }
     return MPIPERF_SUCCESS;
 }
+
+int report_write_collbench_procstat_nosync(collbench_t *bench,
+                                           colltest_params_t *params,
+                                           stat_sample_t *procstat)
+{
+    return report_write_collbench_procstat(params, stat_sample_mean(procstat));
+}
+
+/*
+ * median_ci_relwidth: Returns half-width of bootstrap confidence interval
+ *                     of median relative to median (collective operation).
+ */
+static double median_ci_relwidth(double *exectime, int n, MPI_Comm comm)
+{
+    double est[STAT_NQUANTILES], lb[STAT_NQUANTILES], ub[STAT_NQUANTILES];
+    int nreplicates;
+
+    nreplicates = (mpiperf_bootstrap_nreplicates > 0) ?
+                  mpiperf_bootstrap_nreplicates : BOOTSTRAP_NREPLICATES_DEFAULT;
+    bootstrap_quantiles_ci(exectime, n, nreplicates, mpiperf_confidence_level,
+                           comm, est, lb, ub);
+    if (est[STAT_QUANTILE_MEDIAN] <= 0.0)
+        return 0.0;
+    return (ub[STAT_QUANTILE_MEDIAN] - lb[STAT_QUANTILE_MEDIAN]) / 2.0 /
+           est[STAT_QUANTILE_MEDIAN];
+}
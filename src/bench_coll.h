@@ -10,18 +10,21 @@
 #include <mpi.h>
 
 #include "stat.h"
+#include "histogram.h"
 
 /* Test parameters */
 typedef struct {
     MPI_Comm comm;
     int nprocs;
     int count;
+    int root;       /* Root of rooted collectives (see rootpolicy.h) */
 } colltest_params_t;
 
 typedef int (*collbench_init_ptr_t)(colltest_params_t *params);
 typedef void (*collbench_free_ptr_t)();
 typedef void (*collbench_printinfo_ptr_t)();
 typedef int (*collbench_op_ptr_t)(colltest_params_t *params, double *time);
+typedef void (*collbench_report_ptr_t)();
 
 /* Benchmark */
 typedef struct {
@@ -30,6 +33,7 @@ typedef struct {
     collbench_free_ptr_t free;            /* Called after measures */
     collbench_printinfo_ptr_t printinfo;
     collbench_op_ptr_t collop;            /* Pointer to measure function */
+    collbench_report_ptr_t report;        /* Called after result of test */
 } collbench_t;
 
 extern collbench_t collbenchtab[];
@@ -42,21 +46,31 @@ int run_collbench_test(collbench_t *bench, colltest_params_t *params);
 int run_collbench_test_synctime(collbench_t *bench, colltest_params_t *params,
                                 double **exectime, int *nmeasurements,
                                 int *ncorrect_measurements,
-                                stat_sample_t *procstat);
+                                int *nwarmup_measurements,
+                                stat_sample_t *procstat, histogram_t *prochist);
 int run_collbench_test_nosync(collbench_t *bench, colltest_params_t *params,
                               double *exectime, int *nmeasurements,
                               stat_sample_t *procstat);
 
 int report_write_collbench_header(collbench_t *bench);
 int report_write_colltest_synctime(collbench_t *bench, colltest_params_t *params,
-                                   double *exectime, int nruns, int ncorrectruns);
+                                   double *exectime, int nruns, int ncorrectruns,
+                                   int nwarmupruns);
 int report_write_colltest_nosync(collbench_t *bench, colltest_params_t *params,
                                  double exectime_local, int nruns);
 
 int report_write_collbench_procstat_header(collbench_t *bench);
+int report_write_collbench_procdump_header(collbench_t *bench);
+int report_write_collbench_procdump(collbench_t *bench,
+                                    colltest_params_t *params,
+                                    stat_sample_t *procstat);
+void report_collbench_procdump_close();
 int report_write_collbench_procstat_synctime(collbench_t *bench,
                                              colltest_params_t *params,
                                              stat_sample_t *procstat);
+int report_write_collbench_histogram(collbench_t *bench,
+                                     colltest_params_t *params,
+                                     histogram_t *prochist);
 int report_write_collbench_procstat_nosync(collbench_t *bench,
                                            colltest_params_t *params,
                                            stat_sample_t *procstat);
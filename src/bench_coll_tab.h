@@ -18,6 +18,11 @@
 #include "coll/exscan.h"
 #include "coll/gather.h"
 #include "coll/gatherv.h"
+#include "coll/neighbor_allgather.h"
+#include "coll/neighbor_allgatherv.h"
+#include "coll/neighbor_alltoall.h"
+#include "coll/neighbor_alltoallv.h"
+#include "coll/neighbor_alltoallw.h"
 #include "coll/reduce_scatter_block.h"
 #include "coll/reduce_scatter.h"
 #include "coll/reduce.h"
@@ -104,7 +109,45 @@ collbench_t collbenchtab[] = {
       (collbench_printinfo_ptr_t)bench_gatherv_printinfo,
       (collbench_op_ptr_t)measure_gatherv_sync
     },
-#if MPICH2_NUMVERSION >= 10401301 || (OMPI_MAJOR_VERSION > 0 && OMPI_MINOR_VERSION > 6)
+#ifdef HAVE_NEIGHBOR_COLL
+    {
+      "Neighbor_allgather",
+      (collbench_init_ptr_t)bench_neighbor_allgather_init,
+      (collbench_free_ptr_t)bench_neighbor_allgather_free,
+      (collbench_printinfo_ptr_t)bench_neighbor_allgather_printinfo,
+      (collbench_op_ptr_t)measure_neighbor_allgather_sync
+    },
+    {
+      "Neighbor_allgatherv",
+      (collbench_init_ptr_t)bench_neighbor_allgatherv_init,
+      (collbench_free_ptr_t)bench_neighbor_allgatherv_free,
+      (collbench_printinfo_ptr_t)bench_neighbor_allgatherv_printinfo,
+      (collbench_op_ptr_t)measure_neighbor_allgatherv_sync
+    },
+    {
+      "Neighbor_alltoall",
+      (collbench_init_ptr_t)bench_neighbor_alltoall_init,
+      (collbench_free_ptr_t)bench_neighbor_alltoall_free,
+      (collbench_printinfo_ptr_t)bench_neighbor_alltoall_printinfo,
+      (collbench_op_ptr_t)measure_neighbor_alltoall_sync
+    },
+    {
+      "Neighbor_alltoallv",
+      (collbench_init_ptr_t)bench_neighbor_alltoallv_init,
+      (collbench_free_ptr_t)bench_neighbor_alltoallv_free,
+      (collbench_printinfo_ptr_t)bench_neighbor_alltoallv_printinfo,
+      (collbench_op_ptr_t)measure_neighbor_alltoallv_sync
+    },
+    {
+      "Neighbor_alltoallw",
+      (collbench_init_ptr_t)bench_neighbor_alltoallw_init,
+      (collbench_free_ptr_t)bench_neighbor_alltoallw_free,
+      (collbench_printinfo_ptr_t)bench_neighbor_alltoallw_printinfo,
+      (collbench_op_ptr_t)measure_neighbor_alltoallw_sync
+    },
+#endif
+#if MPI_VERSION >= 3 || MPICH2_NUMVERSION >= 10401301 || \
+    (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION > 6))
     {
       "Reduce_scatter_block",
       (collbench_init_ptr_t)bench_reduce_scatter_block_init,
@@ -169,6 +212,22 @@ collbench_t collbenchtab[] = {
       (collbench_printinfo_ptr_t)bench_waitpatternnull_printinfo,
       (collbench_op_ptr_t)measure_waitpatternnull_sync
     },
+    {
+      "NoiseFWQ",
+      (collbench_init_ptr_t)bench_noisefwq_init,
+      (collbench_free_ptr_t)bench_noise_free,
+      (collbench_printinfo_ptr_t)bench_noisefwq_printinfo,
+      (collbench_op_ptr_t)measure_noisefwq_sync,
+      (collbench_report_ptr_t)bench_noise_report
+    },
+    {
+      "NoiseFTQ",
+      (collbench_init_ptr_t)bench_noiseftq_init,
+      (collbench_free_ptr_t)bench_noise_free,
+      (collbench_printinfo_ptr_t)bench_noiseftq_printinfo,
+      (collbench_op_ptr_t)measure_noiseftq_sync,
+      (collbench_report_ptr_t)bench_noise_report
+    },
 };
 
 #endif /* BENCH_COLL_TAB_H */
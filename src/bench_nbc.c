@@ -20,6 +20,9 @@
 #include "logger.h"
 #include "util.h"
 #include "hpctimer.h"
+#include "rootpolicy.h"
+#include "progress.h"
+#include "compkernel.h"
 #include "bench_nbc_tab.h"
 
 #define TEST_SLOTLEN_SCALE 1.1
@@ -36,23 +39,55 @@ enum {
     TESTS_PER_COMPTIME = 10
 };
 
+/* Progress of current run is made by progress thread (-A) */
+static int nbcbench_progress = 0;
+
+/* Sweep of MPI_Test frequency (-f) is measured instead of overlap */
+#define NBCBENCH_IS_TESTSWEEP \
+    (mpiperf_nbc_testsweep > 0 && mpiperf_nbcbench_mode == NBCBENCH_OVERLAP)
+
+/* Throughput of k outstanding operations (-n) is measured */
+#define NBCBENCH_IS_OUTSTANDING (mpiperf_nbc_noutstanding > 0)
+
 /* run_nbcbench: Runs benchmark for NBC operation */
 int run_nbcbench(nbcbench_t *bench)
 {
     double benchtime;
     nbctest_params_t params;
 
-    if (mpiperf_synctype == SYNC_NONE) {
-        exit_error("nosync mode is not supported for NBC operations");
+    if (NBCBENCH_IS_OUTSTANDING) {
+        if (bench->multiop == NULL) {
+            exit_error("Outstanding operations (-n) are not supported by %s",
+                       bench->name);
+        }
+        if (mpiperf_synctype == SYNC_NONE) {
+            exit_error("Outstanding operations (-n) are not supported in nosync mode");
+        }
     }
 
     benchtime = hpctimer_wtime();
     timeslot_initialize();
+    if (!NBCBENCH_IS_OUTSTANDING && mpiperf_nbc_progress && mpiperf_synctype == SYNC_TIME &&
+        mpiperf_nbcbench_mode == NBCBENCH_OVERLAP)
+    {
+        progress_initialize();
+    }
 
     report_write_header();
     report_write_nbcbench_header(bench);
-    if (mpiperf_perprocreport)
+    if (mpiperf_perprocreport && !NBCBENCH_IS_TESTSWEEP &&
+        !NBCBENCH_IS_OUTSTANDING)
+    {
         report_write_nbcbench_procstat_header(bench);
+    }
+    if (mpiperf_nbcbench_mode == NBCBENCH_BLOCKING &&
+        mpiperf_synctype == SYNC_TIME && !NBCBENCH_IS_OUTSTANDING)
+    {
+        report_write_rootstat_header(bench->name);
+    }
+
+    params.testinterval = -1.0;
+    params.noutstanding = 1;
 
     /* For each communicator size */
     for (params.nprocs = mpiperf_nprocs_min;
@@ -65,7 +100,13 @@ int run_nbcbench(nbcbench_t *bench)
              params.count <= mpiperf_count_max; )
         {
             /* Test NBC collective operation for given nprocs and count */
-            if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP)
+            if (mpiperf_synctype == SYNC_NONE)
+                run_nbcbench_nosync(bench, &params);
+            else if (NBCBENCH_IS_OUTSTANDING)
+                run_nbcbench_outstanding(bench, &params);
+            else if (NBCBENCH_IS_TESTSWEEP)
+                run_nbcbench_testsweep(bench, &params);
+            else if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP)
                 run_nbcbench_overlap(bench, &params);
             else
                 run_nbcbench_blocking(bench, &params);
@@ -86,6 +127,8 @@ int run_nbcbench(nbcbench_t *bench)
         }
     }
 
+    rootpolicy_stat_free();
+    progress_finalize();
     timeslot_finalize();
     MPI_Barrier(MPI_COMM_WORLD);
     benchtime = hpctimer_wtime() - benchtime;
@@ -97,13 +140,14 @@ int run_nbcbench(nbcbench_t *bench)
 
 /*
  * run_nbcbench_overlap: Measures execution time of the NBC operation
- *                       in overlap mode.
+ *                       in overlap mode. With progress thread (-A) each
+ *                       compute time is measured without and with it.
  */
 int run_nbcbench_overlap(nbcbench_t *bench, nbctest_params_t *params)
 {
     double blockingtime, blockingtime_local;
     double comptime_min, comptime_max, comptime_step;
-    int nruns, ncorrectruns;
+    int nruns, ncorrectruns, progress;
     stat_sample_t *inittimestat, *waittimestat, *comptimestat, *totaltimestat,
                   *overlapstat;
 
@@ -157,39 +201,154 @@ int run_nbcbench_overlap(nbcbench_t *bench, nbctest_params_t *params)
         for (params->comptime = comptime_min; params->comptime <= comptime_max;
              params->comptime += comptime_step)
         {
+            for (progress = 0; progress <= mpiperf_nbc_progress; progress++) {
+                nbcbench_progress = progress;
+                stat_sample_clean(inittimestat);
+                stat_sample_clean(waittimestat);
+                stat_sample_clean(comptimestat);
+                stat_sample_clean(totaltimestat);
+                stat_sample_clean(overlapstat);
+
+                run_nbcbench_overlap_test(bench, params, blockingtime_local,
+                                          &nruns, &ncorrectruns, inittimestat,
+                                          waittimestat, comptimestat,
+                                          totaltimestat, overlapstat, NULL,
+                                          NULL);
+
+                report_write_nbcbench_overlap(bench, params, nruns,
+                                              ncorrectruns, blockingtime,
+                                              inittimestat, waittimestat,
+                                              comptimestat, totaltimestat,
+                                              overlapstat);
+
+                if (mpiperf_perprocreport) {
+                    report_write_nbcbench_procstat_overlap(bench, params, nruns,
+                                                           ncorrectruns,
+                                                           blockingtime_local,
+                                                           inittimestat,
+                                                           waittimestat,
+                                                           comptimestat,
+                                                           totaltimestat,
+                                                           overlapstat);
+                }
+            }
+            nbcbench_progress = 0;
+        }
+        stat_sample_free(inittimestat);
+        stat_sample_free(waittimestat);
+        stat_sample_free(comptimestat);
+        stat_sample_free(totaltimestat);
+        stat_sample_free(overlapstat);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * run_nbcbench_testsweep: Measures overlap of the NBC operation for
+ *                         different intervals between MPI_Test calls.
+ *
+ * Compute time is COMPTIME_SCALE * BlockingTime. Interval is changed from
+ * infinity (no MPI_Test calls) to CompTime / 2, CompTime / 4, ... down to
+ * value of -f option. Interval with maximal overlap is reported.
+ */
+int run_nbcbench_testsweep(nbcbench_t *bench, nbctest_params_t *params)
+{
+    double blockingtime, blockingtime_local, interval_min;
+    double overlap, bestoverlap = 0.0, bestinterval = 0.0;
+    int nruns, ncorrectruns, stop;
+    stat_sample_t *inittimestat, *waittimestat, *comptimestat, *totaltimestat,
+                  *overlapstat, *ntestsstat, *testtimestat;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    logger_log("Test (nprocs = %d, count = %d) is started",
+               params->nprocs, params->count);
+
+    if (params->comm != MPI_COMM_NULL) {
+        /* This process participates in measures */
+
+        inittimestat = stat_sample_create();
+        waittimestat = stat_sample_create();
+        comptimestat = stat_sample_create();
+        totaltimestat = stat_sample_create();
+        overlapstat = stat_sample_create();
+        ntestsstat = stat_sample_create();
+        testtimestat = stat_sample_create();
+        if (inittimestat == NULL || waittimestat == NULL || comptimestat == NULL
+            || totaltimestat == NULL || overlapstat == NULL ||
+            ntestsstat == NULL || testtimestat == NULL)
+        {
+            exit_error("Can't allocate memory for statistic");
+        }
+
+        /* Measure NBC operation time in blocking mode */
+        nbcbench_measure_blocking_time(bench, params, &blockingtime,
+                                       &blockingtime_local);
+        logger_log("Blocking time global: %.6f sec, local: %.6f sec",
+                   blockingtime, blockingtime_local);
+        if (blockingtime < 1E-6)
+            blockingtime = 1E-9;
+        if (blockingtime_local < 1E-6)
+            blockingtime_local = 1E-9;
+
+        params->comptime = blockingtime * COMPTIME_SCALE;
+        interval_min = mpiperf_nbc_testsweep * 1E-6;
+
+        /* For each interval: 0 (no MPI_Test calls), CompTime / 2, ... */
+        params->testinterval = 0.0;
+        for (stop = 0; !stop; ) {
             stat_sample_clean(inittimestat);
             stat_sample_clean(waittimestat);
             stat_sample_clean(comptimestat);
             stat_sample_clean(totaltimestat);
             stat_sample_clean(overlapstat);
+            stat_sample_clean(ntestsstat);
+            stat_sample_clean(testtimestat);
 
             run_nbcbench_overlap_test(bench, params, blockingtime_local,
                                       &nruns, &ncorrectruns, inittimestat,
-                                      waittimestat, comptimestat, totaltimestat,
-                                      overlapstat);
-
-            report_write_nbcbench_overlap(bench, params, nruns,
-                                          ncorrectruns, blockingtime,
-                                          inittimestat, waittimestat,
-                                          comptimestat, totaltimestat,
-                                          overlapstat);
-
-            if (mpiperf_perprocreport) {
-                report_write_nbcbench_procstat_overlap(bench, params, nruns,
-                                                       ncorrectruns,
-                                                       blockingtime_local,
-                                                       inittimestat,
-                                                       waittimestat,
-                                                       comptimestat,
-                                                       totaltimestat,
-                                                       overlapstat);
+                                      waittimestat, comptimestat,
+                                      totaltimestat, overlapstat, ntestsstat,
+                                      testtimestat);
+
+            report_write_nbcbench_testsweep(bench, params, nruns, ncorrectruns,
+                                            blockingtime, totaltimestat,
+                                            overlapstat, ntestsstat,
+                                            testtimestat, &overlap);
+            if (params->testinterval == 0.0 || overlap > bestoverlap) {
+                bestoverlap = overlap;
+                bestinterval = params->testinterval;
+            }
+
+            /* Next interval */
+            if (params->testinterval == 0.0) {
+                params->testinterval = stat_fmax2(params->comptime / 2.0,
+                                                  interval_min);
+            } else if (params->testinterval > interval_min) {
+                params->testinterval = stat_fmax2(params->testinterval / 2.0,
+                                                  interval_min);
+            } else {
+                stop = 1;
+            }
+        }
+        params->testinterval = -1.0;
+
+        if (IS_MASTER_RANK) {
+            if (bestinterval > 0.0) {
+                printf("# Best MPI_Test interval (count %d): %.2f usec, overlap %.2f\n",
+                       params->count, bestinterval * 1E6, bestoverlap);
+            } else {
+                printf("# Best MPI_Test interval (count %d): no MPI_Test calls, overlap %.2f\n",
+                       params->count, bestoverlap);
             }
         }
+
         stat_sample_free(inittimestat);
         stat_sample_free(waittimestat);
         stat_sample_free(comptimestat);
         stat_sample_free(totaltimestat);
         stat_sample_free(overlapstat);
+        stat_sample_free(ntestsstat);
+        stat_sample_free(testtimestat);
     }
     return MPIPERF_SUCCESS;
 }
@@ -208,7 +367,9 @@ int run_nbcbench_overlap_test(nbcbench_t *bench,
                               stat_sample_t *waittimestat,
                               stat_sample_t *comptimestat,
                               stat_sample_t *totaltimestat,
-                              stat_sample_t *overlapstat)
+                              stat_sample_t *overlapstat,
+                              stat_sample_t *ntestsstat,
+                              stat_sample_t *testtimestat)
 {
     int i, stage, stage_nruns, nerrors;
     int *stagerc = NULL, *stagerc_reduced = NULL;
@@ -230,6 +391,7 @@ int run_nbcbench_overlap_test(nbcbench_t *bench,
     stagerc_reduced = xrealloc(stagerc_reduced, sizeof(*stagerc_reduced) *
                                TEST_STAGE_NRUNS);
 
+    params->root = rootpolicy_reset(params->nprocs);
     if (bench->init)
         bench->init(params);
 
@@ -251,6 +413,7 @@ int run_nbcbench_overlap_test(nbcbench_t *bench,
         stagetime = hpctimer_wtime();
 
         for (i = 0; i < stage_nruns; i++) {
+            params->root = rootpolicy_next(params->nprocs);
             stagerc[i] = bench->overlapop(params, &stage_results[i]);
         }
 
@@ -292,6 +455,10 @@ int run_nbcbench_overlap_test(nbcbench_t *bench,
                 stat_sample_add(totaltimestat, stage_results[i].totaltime);
                 stat_sample_add(overlapstat,
                                 1.0 - (stage_results[i].totaltime - params->comptime) / blockingtime);
+                if (ntestsstat)
+                    stat_sample_add(ntestsstat, stage_results[i].ntests);
+                if (testtimestat)
+                    stat_sample_add(testtimestat, stage_results[i].testtime);
                 logger_log("Overlap measure (comptime: %.6f; stage %d; run %d): "
                            "totaltime = %.6f; ntests = %d; ",
                            params->comptime, stage, i, stage_results[i].totaltime,
@@ -322,6 +489,9 @@ int run_nbcbench_overlap_test(nbcbench_t *bench,
             {
                 break;
             }
+        } else if (*nruns >= mpiperf_nruns_max) {
+            /* Bootstrap CI of median is computed for collectives only */
+            break;
         }
 
         /* Adjust timeslot parameters */
@@ -380,6 +550,7 @@ int nbcbench_measure_blocking_time(nbcbench_t *bench, nbctest_params_t *params,
     exectime_reduced = xrealloc(exectime_reduced, sizeof(*exectime_reduced) *
                                 TEST_STAGE_NRUNS);
 
+    params->root = rootpolicy_reset(params->nprocs);
     if (bench->init)
         bench->init(params);
 
@@ -401,6 +572,7 @@ int nbcbench_measure_blocking_time(nbcbench_t *bench, nbctest_params_t *params,
         stagetime = hpctimer_wtime();
 
         for (i = 0; i < stage_nruns; i++) {
+            params->root = rootpolicy_next(params->nprocs);
             stagerc[i] = bench->blockingop(params, &stage_results[i]);
         }
 
@@ -489,33 +661,69 @@ int nbcbench_measure_blocking_time(nbcbench_t *bench, nbctest_params_t *params,
     return MPIPERF_SUCCESS;
 }
 
+/* nbcbench_test: Calls MPI_Test and accounts its time. */
+static void nbcbench_test(MPI_Request *request, nbctest_result_t *result)
+{
+    double t;
+    int flag;
+
+    t = hpctimer_wtime();
+    MPI_Test(request, &flag, MPI_STATUS_IGNORE);
+    result->testtime += hpctimer_wtime() - t;
+    result->ntests++;
+}
+
 int nbcbench_simulate_computing(nbctest_params_t *params,
                                 MPI_Request *request, nbctest_result_t *result)
 {
     double test_callstep, test_calltime;
     double t, tt, endtime;
-    int flag;
+    int i, nunits, dotest;
 
     result->ntests = 0;
+    result->testtime = 0.0;
     if (params->comptime <= 0.0) {
         result->realcomptime = 0.0;
         return MPIPERF_SUCCESS;
     }
 
-    /* TODO: How much test we need to call? Is it depend on message size, nprocs? */
-    test_callstep = params->comptime / TESTS_PER_COMPTIME;
+    /* Frequency of MPI_Test calls can be measured by sweep (-f) */
+    if (params->testinterval < 0.0) {
+        test_callstep = params->comptime / TESTS_PER_COMPTIME;
+    } else {
+        test_callstep = params->testinterval;
+    }
+    dotest = !nbcbench_progress && test_callstep > 0.0;
 
     t = hpctimer_wtime();
     endtime = t + params->comptime;
     test_calltime = t + test_callstep;
 
-    while ((tt = hpctimer_wtime()) < endtime) {
-        if (tt > test_calltime) {
-            MPI_Test(request, &flag, MPI_STATUS_IGNORE);
-            result->ntests++;
-            test_calltime += test_callstep;
+    /* Progress thread calls MPI_Test while we compute */
+    if (nbcbench_progress)
+        progress_start(request);
+
+    if (mpiperf_compkernel == COMPKERNEL_WAIT) {
+        while ((tt = hpctimer_wtime()) < endtime) {
+            if (dotest && tt > test_calltime) {
+                nbcbench_test(request, result);
+                test_calltime += test_callstep;
+            }
+        }
+    } else {
+        /* Fixed amount of work (calibrated for comptime) */
+        nunits = compkernel_nunits(params->comptime);
+        for (i = 0; i < nunits; i++) {
+            compkernel_run_unit();
+            if (dotest && hpctimer_wtime() > test_calltime) {
+                nbcbench_test(request, result);
+                test_calltime += test_callstep;
+            }
         }
     }
+
+    if (nbcbench_progress)
+        result->ntests = progress_stop();
     result->realcomptime = hpctimer_wtime() - t;
     return MPIPERF_SUCCESS;
 }
@@ -551,7 +759,80 @@ int report_write_nbcbench_header(nbcbench_t *bench)
 
     printf("# Characteristics of measurements:\n");
 
-    if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP) {
+    if (mpiperf_synctype == SYNC_NONE) {
+        printf("#   Procs: total number of processes\n");
+        printf("#   Count: count of elements in send/recv buffer\n");
+        printf("#   TRuns: total number of measurements\n");
+        printf("#   Init: mean time of NBC issue\n");
+        printf("#   Wait: mean time of MPI_Wait\n");
+        printf("#   Total: time of loop of TRuns NBC operations (Iop + Wait) / TRuns\n");
+        printf("#\n");
+        printf("# Value of Init, Wait, Total are computed as max_of_all_procs\n");
+        printf("#\n");
+        printf("# -------------------------------------------------------------------------------------\n");
+        printf("# Benchmark: %s\n", bench->name);
+        printf("# Benchmarking mode: pipelined measurements (Iop + Wait)\n");
+        if (mpiperf_timescale == TIMESCALE_SEC) {
+            printf("# [Procs] [Count]     [TRuns] [Init]       [Wait]       [Total]\n");
+        } else {
+            /* usec */
+            printf("# [Procs] [Count]     [TRuns] [Init]         [Wait]         [Total]\n");
+        }
+    } else if (NBCBENCH_IS_OUTSTANDING) {
+        printf("#   Procs: total number of processes\n");
+        printf("#   Count: count of elements in send/recv buffer\n");
+        printf("#   K: number of outstanding operations (separate buffers)\n");
+        printf("#   TRuns: total number of measurements (valid and invalid runs)\n");
+        printf("#   CRuns: number of correct measurements (only valid runs)\n");
+        printf("#   RSE: relative standard error of total time (StdErr / Mean)\n");
+        printf("#   Init: time of issue of K operations\n");
+        printf("#   Wait: time of MPI_Waitall\n");
+        printf("#   Total: time of K operations (K x Iop + Waitall)\n");
+        printf("#   PerOp: Total / K\n");
+        printf("#   Ops/s: K / Total\n");
+        printf("#\n");
+        printf("# Value of Init, Wait, Total are computed as \n");
+        printf("# mean_of_runs(max_of_all_procs(t[0][j], ..., t[Procs - 1][j])),\n");
+        printf("# where t[i][j] is a time of process i at measure j = 1, 2, ..., CRuns\n");
+        printf("#\n");
+        printf("# -------------------------------------------------------------------------------------\n");
+        printf("# Benchmark: %s\n", bench->name);
+        printf("# Benchmarking mode: %d outstanding operations at most (K x Iop + Waitall)\n",
+               mpiperf_nbc_noutstanding);
+        if (mpiperf_timescale == TIMESCALE_SEC) {
+            printf("# [Procs] [Count]     [K]     [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [Total]      [PerOp]      [Ops/s]\n");
+        } else {
+            /* usec */
+            printf("# [Procs] [Count]     [K]     [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [Total]        [PerOp]        [Ops/s]\n");
+        }
+    } else if (NBCBENCH_IS_TESTSWEEP) {
+        printf("#   Procs: total number of processes\n");
+        printf("#   Count: count of elements in send/recv buffer\n");
+        printf("#   BlockingTime: time of NBC in blocking mode (Iop + Wait)\n");
+        printf("#   CompTime: time of computations (%d * BlockingTime)\n", COMPTIME_SCALE);
+        printf("#   TestInterval: interval between MPI_Test calls (0 - no calls)\n");
+        printf("#   TRuns: total number of measurements (valid and invalid runs)\n");
+        printf("#   CRuns: number of correct measurements (only valid runs)\n");
+        printf("#   NTests: number of MPI_Test calls\n");
+        printf("#   TestTime: total time of MPI_Test calls (cost of polling)\n");
+        printf("#   Total: Total time of NBC operation with computations (Iop + Comp + Wait)\n");
+        printf("#   Overlap: 1 - (Total - CompTime) / BlockingTime\n");
+        printf("#\n");
+        printf("# Value of NTests, TestTime, Total, Overlap\n");
+        printf("# are computed as max_of_all_procs(mean_of_runs(t[i][1], ..., t[i][CRuns])),\n");
+        printf("# where t[i][j] is a time (or other value) of process i at measure j = 1, 2, ..., CRuns\n");
+        printf("#\n");
+        printf("# -------------------------------------------------------------------------------------\n");
+        printf("# Benchmark: %s\n", bench->name);
+        printf("# Benchmarking mode: sweep of MPI_Test frequency (minimal interval %d usec)\n",
+               mpiperf_nbc_testsweep);
+        if (mpiperf_timescale == TIMESCALE_SEC) {
+            printf("# [Procs] [Count]     [BlockingTime] [CompTime]   [TestInterval] [TRuns] [CRuns] [NTests] [TestTime]   [Total]      [Overlap]\n");
+        } else {
+            /* usec */
+            printf("# [Procs] [Count]     [BlockingTime] [CompTime]     [TestInterval] [TRuns] [CRuns] [NTests] [TestTime]     [Total]        [Overlap]\n");
+        }
+    } else if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP) {
         printf("#   Procs: total number of processes\n");
         printf("#   Count: count of elements in send/recv buffer\n");
         printf("#   BlockingTime: time of NBC in blocking mode (Iop + Wait)\n");
@@ -564,19 +845,29 @@ int report_write_nbcbench_header(nbcbench_t *bench)
         printf("#   CompTimeReal: real time of waiting loop (for CompTime)\n");
         printf("#   Total: Total time of NBC operation with computations (Iop + Comp + Wait)\n");
         printf("#   Overlap: 1 - (Total - CompTime) / BlockingTime\n");
+        printf("#   Median, P90, P99, P99.9: quantiles of total time\n");
+        if (mpiperf_nbc_progress)
+            printf("#   Progress: progress thread is used (on) or MPI_Test is called by main thread (off)\n");
         printf("#\n");
-        printf("# Value of BlockingTime, Init, Wait, CompTimeReal, Total, Overlap\n");
+        printf("# Value of BlockingTime, Init, Wait, CompTimeReal, Total, Overlap and quantiles\n");
         printf("# are computed as max_of_all_procs(mean_of_runs(t[i][1], ..., t[i][CRuns])),\n");
         printf("# where t[i][j] is a time (or other value) of process i at measure j = 1, 2, ..., CRuns\n");
         printf("#\n");
         printf("# -------------------------------------------------------------------------------------\n");
         printf("# Benchmark: %s\n", bench->name);
         printf("# Benchmarking mode: overlap measure (Iop + Comp + Wait)\n");
+        if (mpiperf_nbc_progress && progress_cpu() >= 0) {
+            printf("# Progress thread: core %d of master\n", progress_cpu());
+        } else if (mpiperf_nbc_progress) {
+            printf("# Progress thread: not pinned (no spare core)\n");
+        }
         if (mpiperf_timescale == TIMESCALE_SEC) {
-            printf("# [Procs] [Count]     [BlockingTime] [CompTime]   [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [CompTimeReal] [Total]      [Overlap]\n");
+            printf("# [Procs] [Count]     [BlockingTime] [CompTime]   [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [CompTimeReal] [Total]      [Overlap] [Median]      [P90]         [P99]         [P99.9]       %s\n",
+                   mpiperf_nbc_progress ? "  [Progress]" : "");
         } else {
             /* usec */
-            printf("# [Procs] [Count]     [BlockingTime] [CompTime]     [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [CompTimeReal] [Total]        [Overlap]\n");
+            printf("# [Procs] [Count]     [BlockingTime] [CompTime]     [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [CompTimeReal] [Total]        [Overlap] [Median]        [P90]           [P99]           [P99.9]         %s\n",
+                   mpiperf_nbc_progress ? "  [Progress]" : "");
         }
     } else {
         /*
@@ -590,6 +881,7 @@ int report_write_nbcbench_header(nbcbench_t *bench)
         printf("#   Init: time of NBC issue\n");
         printf("#   Wait: time of MPI_Wait\n");
         printf("#   Total: Total time of NBC operation (Iop + Wait)\n");
+        printf("#   Median, P90, P99, P99.9: quantiles of total time\n");
         printf("#\n");
         printf("# Value of Init, Wait, Total are computed as \n");
         printf("# mean_of_runs(max_of_all_procs(t[0][j], ..., t[Procs - 1][j])),\n");
@@ -599,10 +891,10 @@ int report_write_nbcbench_header(nbcbench_t *bench)
         printf("# Benchmark: %s\n", bench->name);
         printf("# Benchmarking mode: blocking time (Iop + Wait)\n");
         if (mpiperf_timescale == TIMESCALE_SEC) {
-            printf("# [Procs] [Count]     [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [Total]\n");
+            printf("# [Procs] [Count]     [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [Total]      [Median]     [P90]        [P99]        [P99.9]\n");
         } else {
             /* usec */
-            printf("# [Procs] [Count]     [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [Total]\n");
+            printf("# [Procs] [Count]     [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [Total]        [Median]       [P90]          [P99]          [P99.9]\n");
         }
     }
     printf("# -------------------------------------------------------------------------------------\n");
@@ -616,7 +908,26 @@ int report_write_nbcbench_procstat_header(nbcbench_t *bench)
 
     fprintf(mpiperf_repstream, "# Characteristics of measurements:\n");
 
-    if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP) {
+    if (mpiperf_synctype == SYNC_NONE) {
+        fprintf(mpiperf_repstream, "#   Procs: total number of processes\n");
+        fprintf(mpiperf_repstream, "#   Count: count of elements in send/recv buffer\n");
+        fprintf(mpiperf_repstream, "#   Rank: rank of process\n");
+        fprintf(mpiperf_repstream, "#   TRuns: total number of measurements\n");
+        fprintf(mpiperf_repstream, "#   Init: mean time of NBC issue\n");
+        fprintf(mpiperf_repstream, "#   Wait: mean time of MPI_Wait\n");
+        fprintf(mpiperf_repstream, "#   Total: time of loop of TRuns NBC operations (Iop + Wait) / TRuns\n");
+        fprintf(mpiperf_repstream, "#\n");
+        fprintf(mpiperf_repstream, "# --------------------------------------------------------------------------------------------\n");
+        fprintf(mpiperf_repstream, "# Benchmark: %s\n", bench->name);
+        fprintf(mpiperf_repstream, "# Benchmarking mode: pipelined measurements (Iop + Wait)\n");
+        if (mpiperf_timescale == TIMESCALE_SEC) {
+            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [Init]       [Wait]       [Total]\n");
+        } else {
+            /* usec */
+            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [Init]         [Wait]         [Total]\n");
+        }
+        fprintf(mpiperf_repstream, "# --------------------------------------------------------------------------------------------\n");
+    } else if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP) {
         fprintf(mpiperf_repstream, "#   Procs: total number of processes\n");
         fprintf(mpiperf_repstream, "#   Count: count of elements in send/recv buffer\n");
         fprintf(mpiperf_repstream, "#   Rank: rank of process\n");
@@ -630,6 +941,9 @@ int report_write_nbcbench_procstat_header(nbcbench_t *bench)
         fprintf(mpiperf_repstream, "#   CompTimeReal: real time of waiting loop (for CompTime)\n");
         fprintf(mpiperf_repstream, "#   Total: total time of NBC operation with computations (Iop + Comp + Wait)\n");
         fprintf(mpiperf_repstream, "#   Overlap: 1 - (Total - CompTime) / BlockingTime\n");
+        fprintf(mpiperf_repstream, "#   Median, P90, P99, P99.9: quantiles of total time\n");
+        if (mpiperf_nbc_progress)
+            fprintf(mpiperf_repstream, "#   Progress: progress thread is used (on) or MPI_Test is called by main thread (off)\n");
         fprintf(mpiperf_repstream, "#\n");
         fprintf(mpiperf_repstream, "# Value of BlockingTime, Init, Wait, CompTimeReal, Total, Overlap in process i\n");
         fprintf(mpiperf_repstream, "# are computed as mean_of_runs(t[i][1], ..., t[i][CRuns])),\n");
@@ -639,10 +953,12 @@ int report_write_nbcbench_procstat_header(nbcbench_t *bench)
         fprintf(mpiperf_repstream, "# Benchmark: %s\n", bench->name);
         fprintf(mpiperf_repstream, "# Benchmarking mode: overlap measure (Iop + Comp + Wait)\n");
         if (mpiperf_timescale == TIMESCALE_SEC) {
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [BlockingTime] [CompTime]   [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [CompTimeReal] [Total]      [Overlap]\n");
+            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [BlockingTime] [CompTime]   [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [CompTimeReal] [Total]      [Overlap] [Median]      [P90]         [P99]         [P99.9]       %s\n",
+                    mpiperf_nbc_progress ? "  [Progress]" : "");
         } else {
             /* usec */
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [BlockingTime] [CompTime]     [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [CompTimeReal] [Total]        [Overlap]\n");
+            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [BlockingTime] [CompTime]     [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [CompTimeReal] [Total]        [Overlap] [Median]        [P90]           [P99]           [P99.9]         %s\n",
+                    mpiperf_nbc_progress ? "  [Progress]" : "");
         }
         fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
     } else {
@@ -658,6 +974,7 @@ int report_write_nbcbench_procstat_header(nbcbench_t *bench)
         fprintf(mpiperf_repstream, "#   Init: time of NBC issue\n");
         fprintf(mpiperf_repstream, "#   Wait: time of MPI_Wait\n");
         fprintf(mpiperf_repstream, "#   Total: total time of NBC operation (Iop + Wait)\n");
+        fprintf(mpiperf_repstream, "#   Median, P90, P99, P99.9: quantiles of total time\n");
         fprintf(mpiperf_repstream, "#\n");
         fprintf(mpiperf_repstream, "# Value of Init, Wait, Total in process i\n");
         fprintf(mpiperf_repstream, "# are computed as mean_of_runs(t[i][1], ..., t[i][CRuns])),\n");
@@ -667,10 +984,10 @@ int report_write_nbcbench_procstat_header(nbcbench_t *bench)
         fprintf(mpiperf_repstream, "# Benchmark: %s\n", bench->name);
         fprintf(mpiperf_repstream, "# Benchmarking mode: blocking time (Iop + Wait) measure\n");
         if (mpiperf_timescale == TIMESCALE_SEC) {
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [Total]\n");
+            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [CRuns] [RSE]      [Init]       [Wait]       [Total]      [Median]     [P90]        [P99]        [P99.9]\n");
         } else {
             /* usec */
-            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [Total]\n");
+            fprintf(mpiperf_repstream, "# [Procs] [Count]     [Rank]  [TRuns] [CRuns] [RSE]      [Init]         [Wait]         [Total]        [Median]       [P90]          [P99]          [P99.9]\n");
         }
         fprintf(mpiperf_repstream, "# --------------------------------------------------------------------------------------------\n");
     }
@@ -693,19 +1010,23 @@ int report_write_nbcbench_overlap(nbcbench_t *bench, nbctest_params_t *params,
         COMPTIME = 2,
         TOTALTIME = 3,
         OVERLAP = 4,
-        TOTALRSE = 5
+        TOTALRSE = 5,
+        QUANTILES = 6       /* Quantiles of total time */
     };
-    enum { NSTAT = 6 };
+    enum { NSTAT = 6 + STAT_NQUANTILES };
     double stat[NSTAT], allstat[NSTAT];
-    const char *fmt = NULL;
+    const char *fmt = NULL, *qfmt = NULL;
     double timescale = 0;
+    int i;
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
-        fmt = "  %-7d %-11d %-12.6f   %-12.6f %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f   %-12.6f %-8.2f\n";
+        fmt = "  %-7d %-11d %-12.6f   %-12.6f %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f   %-12.6f %-8.2f";
+        qfmt = "  %-12.6f";
         timescale = 1.0;
     } else {
         /* usec */
-        fmt = "  %-7d %-11d %-14.2f %-14.2f %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f %-14.2f %-8.2f\n";
+        fmt = "  %-7d %-11d %-14.2f %-14.2f %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f %-14.2f %-8.2f";
+        qfmt = "  %-14.2f";
         timescale = 1E6;
     }
 
@@ -715,6 +1036,8 @@ int report_write_nbcbench_overlap(nbcbench_t *bench, nbctest_params_t *params,
     stat[TOTALTIME] = stat_sample_mean(totaltimestat) * timescale;
     stat[OVERLAP] = stat_sample_mean(overlapstat);
     stat[TOTALRSE] = stat_sample_stderr_rel(totaltimestat);
+    for (i = 0; i < STAT_NQUANTILES; i++)
+        stat[QUANTILES + i] = stat_sample_quantile(totaltimestat, i) * timescale;
 
     MPI_Reduce(stat, allstat, NSTAT, MPI_DOUBLE, MPI_MAX, mpiperf_master_rank,
                params->comm);
@@ -726,7 +1049,65 @@ int report_write_nbcbench_overlap(nbcbench_t *bench, nbctest_params_t *params,
            params->comptime * timescale, nruns, ncorrectruns,
            allstat[TOTALRSE], allstat[INITTIME], allstat[WAITTIME],
            allstat[COMPTIME], allstat[TOTALTIME], allstat[OVERLAP]);
+    for (i = 0; i < STAT_NQUANTILES; i++)
+        printf(qfmt, allstat[QUANTILES + i]);
+    if (mpiperf_nbc_progress)
+        printf(" %s", nbcbench_progress ? "on" : "off");
+    printf("\n");
+
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * report_write_nbcbench_testsweep: Writes results for one interval
+ *                                  of MPI_Test calls and returns
+ *                                  overlap on master.
+ */
+int report_write_nbcbench_testsweep(nbcbench_t *bench, nbctest_params_t *params,
+                                    int nruns, int ncorrectruns,
+                                    double blockingtime,
+                                    stat_sample_t *totaltimestat,
+                                    stat_sample_t *overlapstat,
+                                    stat_sample_t *ntestsstat,
+                                    stat_sample_t *testtimestat,
+                                    double *overlap)
+{
+    enum {
+        TOTALTIME = 0,
+        OVERLAP = 1,
+        NTESTS = 2,
+        TESTTIME = 3
+    };
+    enum { NSTAT = 4 };
+    double stat[NSTAT], allstat[NSTAT];
+    const char *fmt = NULL;
+    double timescale = 0;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-12.6f   %-12.6f %-14.6f %-7d %-7d %-8.1f %-12.6f %-12.6f %-8.2f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-14.2f %-14.2f %-14.2f %-7d %-7d %-8.1f %-14.2f %-14.2f %-8.2f\n";
+        timescale = 1E6;
+    }
+
+    stat[TOTALTIME] = stat_sample_mean(totaltimestat) * timescale;
+    stat[OVERLAP] = stat_sample_mean(overlapstat);
+    stat[NTESTS] = stat_sample_mean(ntestsstat);
+    stat[TESTTIME] = stat_sample_mean(testtimestat) * timescale;
+
+    MPI_Reduce(stat, allstat, NSTAT, MPI_DOUBLE, MPI_MAX, mpiperf_master_rank,
+               params->comm);
 
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    *overlap = allstat[OVERLAP];
+    printf(fmt, params->nprocs, params->count, blockingtime * timescale,
+           params->comptime * timescale, params->testinterval * timescale,
+           nruns, ncorrectruns, allstat[NTESTS], allstat[TESTTIME],
+           allstat[TOTALTIME], allstat[OVERLAP]);
     return MPIPERF_SUCCESS;
 }
 
@@ -747,20 +1128,23 @@ int report_write_nbcbench_procstat_overlap(nbcbench_t *bench,
         TOTALTIME = 3,
         OVERLAP = 4,
         BLOCKINGTIME = 5,
-        TOTALRSE = 6
+        TOTALRSE = 6,
+        QUANTILES = 7       /* Quantiles of total time */
     };
-    enum { NSTAT = 8 };
+    enum { NSTAT = 7 + STAT_NQUANTILES };
     double stat[NSTAT], *allstat = NULL;
-    const char *fmt = NULL;
+    const char *fmt = NULL, *qfmt = NULL;
     double timescale = 0;
-    int i;
+    int i, j;
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
-        fmt = "  %-7d %-11d %-7d %-12.6f   %-12.6f %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f   %-12.6f %-8.2f\n";
+        fmt = "  %-7d %-11d %-7d %-12.6f   %-12.6f %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f   %-12.6f %-8.2f";
+        qfmt = "  %-12.6f";
         timescale = 1.0;
     } else {
         /* usec */
-        fmt = "  %-7d %-11d %-7d %-14.2f %-14.2f %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f %-14.2f %-8.2f\n";
+        fmt = "  %-7d %-11d %-7d %-14.2f %-14.2f %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f %-14.2f %-8.2f";
+        qfmt = "  %-14.2f";
         timescale = 1E6;
     }
 
@@ -774,6 +1158,8 @@ int report_write_nbcbench_procstat_overlap(nbcbench_t *bench,
     stat[OVERLAP] = stat_sample_mean(overlapstat);
     stat[BLOCKINGTIME] = blockingtime * timescale;
     stat[TOTALRSE] = stat_sample_stderr_rel(totaltimestat);
+    for (j = 0; j < STAT_NQUANTILES; j++)
+        stat[QUANTILES + j] = stat_sample_quantile(totaltimestat, j) * timescale;
 
     MPI_Gather(stat, NSTAT, MPI_DOUBLE, allstat, NSTAT, MPI_DOUBLE,
                mpiperf_master_rank, params->comm);
@@ -791,6 +1177,11 @@ int report_write_nbcbench_procstat_overlap(nbcbench_t *bench,
                 allstat[i * NSTAT + TOTALTIME],
                 allstat[i * NSTAT + OVERLAP]
         );
+        for (j = 0; j < STAT_NQUANTILES; j++)
+            fprintf(mpiperf_repstream, qfmt, allstat[i * NSTAT + QUANTILES + j]);
+        if (mpiperf_nbc_progress)
+            fprintf(mpiperf_repstream, " %s", nbcbench_progress ? "on" : "off");
+        fprintf(mpiperf_repstream, "\n");
     }
     free(allstat);
     return MPIPERF_SUCCESS;
@@ -834,6 +1225,7 @@ int run_nbcbench_blocking(nbcbench_t *bench, nbctest_params_t *params)
 
         report_write_nbcbench_blocking(bench, params, nruns, ncorrectruns,
                                        inittimestat, waittimestat, totaltimestat);
+        report_write_rootstat(params->nprocs, params->count);
 
         if (mpiperf_perprocreport) {
             report_write_nbcbench_procstat_blocking(bench, params,
@@ -875,6 +1267,7 @@ int run_nbcbench_blocking_test(nbcbench_t *bench,
     double *stage_total = NULL, *total_reduced = NULL;
     double *stage_init = NULL, *init_reduced = NULL;
     double *stage_wait = NULL, *wait_reduced = NULL;
+    int *stageroot = NULL;
 
     stage_total = xrealloc(stage_total, sizeof(double) * TEST_STAGE_NRUNS);
     total_reduced = xrealloc(total_reduced, sizeof(double) * TEST_STAGE_NRUNS);
@@ -890,7 +1283,10 @@ int run_nbcbench_blocking_test(nbcbench_t *bench,
     stagerc = xrealloc(stagerc, sizeof(*stagerc) * TEST_STAGE_NRUNS);
     stagerc_reduced = xrealloc(stagerc_reduced, sizeof(*stagerc_reduced) *
                                TEST_STAGE_NRUNS);
+    stageroot = xrealloc(stageroot, sizeof(*stageroot) * TEST_STAGE_NRUNS);
 
+    params->root = rootpolicy_reset(params->nprocs);
+    rootpolicy_stat_reset(params->nprocs);
     if (bench->init)
         bench->init(params);
 
@@ -912,6 +1308,7 @@ int run_nbcbench_blocking_test(nbcbench_t *bench,
         stagetime = hpctimer_wtime();
 
         for (i = 0; i < stage_nruns; i++) {
+            params->root = stageroot[i] = rootpolicy_next(params->nprocs);
             stagerc[i] = bench->blockingop(params, &stage_results[i]);
         }
 
@@ -953,6 +1350,7 @@ int run_nbcbench_blocking_test(nbcbench_t *bench,
                 (*ncorrectruns)++;
                 stat_sample_add(totaltimestat, total_reduced[i]);
                 stat_sample_add(totaltimestat_local, stage_total[i]);
+                rootpolicy_stat_add(stageroot[i], total_reduced[i]);
 
                 stat_sample_add(inittimestat, init_reduced[i]);
                 stat_sample_add(inittimestat_local, stage_init[i]);
@@ -989,6 +1387,9 @@ int run_nbcbench_blocking_test(nbcbench_t *bench,
             {
                 break;
             }
+        } else if (*nruns >= mpiperf_nruns_max) {
+            /* Bootstrap CI of median is computed for collectives only */
+            break;
         }
 
         /* Adjust timeslot parameters */
@@ -1014,11 +1415,117 @@ int run_nbcbench_blocking_test(nbcbench_t *bench,
     free(wait_reduced);
     free(stagerc_reduced);
     free(stagerc);
+    free(stageroot);
     free(stage_results);
 
     return MPIPERF_SUCCESS;
 }
 
+/*
+ * run_nbcbench_outstanding: Measures time of k = 1, 2, 4, ..., kmax
+ *                           outstanding NBC operations completed
+ *                           by MPI_Waitall (-n).
+ */
+int run_nbcbench_outstanding(nbcbench_t *bench, nbctest_params_t *params)
+{
+    nbcbench_t multibench;
+    int nruns, ncorrectruns, k;
+    stat_sample_t *inittimestat, *waittimestat, *totaltimestat;
+    stat_sample_t *inittimestat_local, *waittimestat_local, *totaltimestat_local;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    logger_log("Test (nprocs = %d, count = %d) is started",
+               params->nprocs, params->count);
+
+    if (params->comm != MPI_COMM_NULL) {
+        /* This process participates in measures */
+
+        inittimestat = stat_sample_create();
+        inittimestat_local = stat_sample_create();
+        waittimestat = stat_sample_create();
+        waittimestat_local = stat_sample_create();
+        totaltimestat = stat_sample_create();
+        totaltimestat_local = stat_sample_create();
+
+        if (inittimestat == NULL || waittimestat == NULL ||
+            totaltimestat == NULL || inittimestat_local == NULL ||
+            waittimestat_local == NULL || totaltimestat_local == NULL)
+        {
+            exit_error("Can't allocate memory for statistic");
+        }
+
+        /* Blocking driver measures k operations as one */
+        multibench = *bench;
+        multibench.blockingop = bench->multiop;
+
+        for (k = 1; ; k = (k * 2 < mpiperf_nbc_noutstanding) ?
+                              k * 2 : mpiperf_nbc_noutstanding)
+        {
+            params->noutstanding = k;
+            stat_sample_clean(inittimestat);
+            stat_sample_clean(waittimestat);
+            stat_sample_clean(totaltimestat);
+            stat_sample_clean(inittimestat_local);
+            stat_sample_clean(waittimestat_local);
+            stat_sample_clean(totaltimestat_local);
+
+            run_nbcbench_blocking_test(&multibench, params, &nruns,
+                                       &ncorrectruns, inittimestat,
+                                       waittimestat, totaltimestat,
+                                       inittimestat_local, waittimestat_local,
+                                       totaltimestat_local);
+
+            report_write_nbcbench_outstanding(bench, params, nruns,
+                                              ncorrectruns, inittimestat,
+                                              waittimestat, totaltimestat);
+            if (k == mpiperf_nbc_noutstanding)
+                break;
+        }
+        params->noutstanding = 1;
+
+        stat_sample_free(inittimestat);
+        stat_sample_free(waittimestat);
+        stat_sample_free(totaltimestat);
+        stat_sample_free(inittimestat_local);
+        stat_sample_free(waittimestat_local);
+        stat_sample_free(totaltimestat_local);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_nbcbench_outstanding(nbcbench_t *bench,
+                                      nbctest_params_t *params,
+                                      int nruns, int ncorrectruns,
+                                      stat_sample_t *inittimestat,
+                                      stat_sample_t *waittimestat,
+                                      stat_sample_t *totaltimestat)
+{
+    const char *fmt = NULL;
+    double timescale = 0, total;
+
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-7d %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f %-12.6f %-12.2f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-7d %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f %-14.2f %-14.2f\n";
+        timescale = 1E6;
+    }
+
+    total = stat_sample_mean(totaltimestat);
+    printf(fmt, params->nprocs, params->count, params->noutstanding,
+           nruns, ncorrectruns, stat_sample_stderr_rel(totaltimestat),
+           stat_sample_mean(inittimestat) * timescale,
+           stat_sample_mean(waittimestat) * timescale,
+           total * timescale, total / params->noutstanding * timescale,
+           (total > 0.0) ? params->noutstanding / total : 0.0);
+
+    return MPIPERF_SUCCESS;
+}
+
 int report_write_nbcbench_blocking(nbcbench_t *bench,
                                    nbctest_params_t *params,
                                    int nruns, int ncorrectruns,
@@ -1033,11 +1540,13 @@ int report_write_nbcbench_blocking(nbcbench_t *bench,
         return MPIPERF_SUCCESS;
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
-        fmt = "  %-7d %-11d %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f "
+              "%-12.6f %-12.6f %-12.6f %-12.6f\n";
         timescale = 1.0;
     } else {
         /* usec */
-        fmt = "  %-7d %-11d %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f "
+              "%-14.2f %-14.2f %-14.2f %-14.2f\n";
         timescale = 1E6;
     }
 
@@ -1045,7 +1554,11 @@ int report_write_nbcbench_blocking(nbcbench_t *bench,
            stat_sample_stderr_rel(totaltimestat),
            stat_sample_mean(inittimestat) * timescale,
            stat_sample_mean(waittimestat) * timescale,
-           stat_sample_mean(totaltimestat) * timescale);
+           stat_sample_mean(totaltimestat) * timescale,
+           stat_sample_quantile(totaltimestat, STAT_QUANTILE_MEDIAN) * timescale,
+           stat_sample_quantile(totaltimestat, STAT_QUANTILE_P90) * timescale,
+           stat_sample_quantile(totaltimestat, STAT_QUANTILE_P99) * timescale,
+           stat_sample_quantile(totaltimestat, STAT_QUANTILE_P999) * timescale);
 
     return MPIPERF_SUCCESS;
 }
@@ -1061,20 +1574,23 @@ int report_write_nbcbench_procstat_blocking(nbcbench_t *bench,
         INITTIME = 0,
         WAITTIME = 1,
         TOTALTIME = 2,
-        TOTALRSE = 3
+        TOTALRSE = 3,
+        QUANTILES = 4       /* Quantiles of total time */
     };
-    enum { NSTAT = 4 };
+    enum { NSTAT = 4 + STAT_NQUANTILES };
     double stat[NSTAT], *allstat = NULL;
     const char *fmt = NULL;
     double timescale = 0;
     int i;
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
-        fmt = "  %-7d %-11d %-7d %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f "
+              "%-12.6f %-12.6f %-12.6f %-12.6f\n";
         timescale = 1.0;
     } else {
         /* usec */
-        fmt = "  %-7d %-11d %-7d %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f\n";
+        fmt = "  %-7d %-11d %-7d %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f "
+              "%-14.2f %-14.2f %-14.2f %-14.2f\n";
         timescale = 1E6;
     }
 
@@ -1085,6 +1601,8 @@ int report_write_nbcbench_procstat_blocking(nbcbench_t *bench,
     stat[WAITTIME] = stat_sample_mean(waittimestat) * timescale;
     stat[TOTALTIME] = stat_sample_mean(totaltimestat) * timescale;
     stat[TOTALRSE] = stat_sample_stderr_rel(totaltimestat);
+    for (i = 0; i < STAT_NQUANTILES; i++)
+        stat[QUANTILES + i] = stat_sample_quantile(totaltimestat, i) * timescale;
 
     MPI_Gather(stat, NSTAT, MPI_DOUBLE, allstat, NSTAT, MPI_DOUBLE,
                mpiperf_master_rank, params->comm);
@@ -1098,9 +1616,163 @@ int report_write_nbcbench_procstat_blocking(nbcbench_t *bench,
                 allstat[i * NSTAT + TOTALRSE],
                 allstat[i * NSTAT + INITTIME],
                 allstat[i * NSTAT + WAITTIME],
-                allstat[i * NSTAT + TOTALTIME]
+                allstat[i * NSTAT + TOTALTIME],
+                allstat[i * NSTAT + QUANTILES + STAT_QUANTILE_MEDIAN],
+                allstat[i * NSTAT + QUANTILES + STAT_QUANTILE_P90],
+                allstat[i * NSTAT + QUANTILES + STAT_QUANTILE_P99],
+                allstat[i * NSTAT + QUANTILES + STAT_QUANTILE_P999]
         );
     }
     free(allstat);
     return MPIPERF_SUCCESS;
 }
+
+/*
+ * run_nbcbench_nosync: Measures execution time of the NBC operation
+ *                      in pipelined mode (Iop + Wait loop).
+ */
+int run_nbcbench_nosync(nbcbench_t *bench, nbctest_params_t *params)
+{
+    nbctest_result_t result;
+    int nruns;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    logger_log("Test (nprocs = %d, count = %d) is started",
+               params->nprocs, params->count);
+
+    if (params->comm != MPI_COMM_NULL) {
+        /* This process participates in measures */
+        run_nbcbench_nosync_test(bench, params, &nruns, &result);
+        report_write_nbcbench_nosync(bench, params, nruns, &result);
+        if (mpiperf_perprocreport) {
+            report_write_nbcbench_procstat_nosync(bench, params, nruns,
+                                                  &result);
+        }
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * run_nbcbench_nosync_test: Measures execution time of the NBC operation
+ *                           in current process.
+ *
+ * This test implements pipelined measurements (without synchronization
+ * of runs): Iop + Wait is executed back-to-back mpiperf_nruns_max times.
+ * Init and wait times are means of runs, total time is a time of loop
+ * divided by number of runs.
+ */
+int run_nbcbench_nosync_test(nbcbench_t *bench, nbctest_params_t *params,
+                             int *nruns, nbctest_result_t *result)
+{
+    nbctest_result_t runresult;
+    double t;
+    int i;
+
+    params->root = rootpolicy_reset(params->nprocs);
+    if (bench->init)
+        bench->init(params);
+
+    /* Warmup */
+    bench->blockingop(params, &runresult);
+    MPI_Barrier(params->comm);
+
+    result->inittime = 0.0;
+    result->waittime = 0.0;
+
+    /* Run measurements */
+    mpiperf_is_measure_started = 1;
+    t = hpctimer_wtime();
+    for (i = 0; i < mpiperf_nruns_max; i++) {
+        params->root = rootpolicy_next(params->nprocs);
+        bench->blockingop(params, &runresult);
+        result->inittime += runresult.inittime;
+        result->waittime += runresult.waittime;
+    }
+    t = hpctimer_wtime() - t;
+    mpiperf_is_measure_started = 0;
+
+    result->totaltime = t / mpiperf_nruns_max;
+    result->inittime /= mpiperf_nruns_max;
+    result->waittime /= mpiperf_nruns_max;
+    *nruns = mpiperf_nruns_max;
+
+    logger_log("Test is finished: %d runs, totaltime = %.6f",
+               *nruns, result->totaltime);
+
+    if (bench->free)
+        bench->free();
+
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_nbcbench_nosync(nbcbench_t *bench, nbctest_params_t *params,
+                                 int nruns, nbctest_result_t *result)
+{
+    enum { NSTAT = 3 };
+    double stat[NSTAT], stat_max[NSTAT];
+    const char *fmt = NULL;
+    double timescale = 0;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-7d %-12.6f %-12.6f %-12.6f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-7d %-14.2f %-14.2f %-14.2f\n";
+        timescale = 1E6;
+    }
+
+    /* Gather maximum times of all processes */
+    stat[0] = result->inittime;
+    stat[1] = result->waittime;
+    stat[2] = result->totaltime;
+    MPI_Reduce(stat, stat_max, NSTAT, MPI_DOUBLE, MPI_MAX,
+               mpiperf_master_rank, params->comm);
+
+    if (IS_MASTER_RANK) {
+        printf(fmt, params->nprocs, params->count, nruns,
+               stat_max[0] * timescale, stat_max[1] * timescale,
+               stat_max[2] * timescale);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_nbcbench_procstat_nosync(nbcbench_t *bench,
+                                          nbctest_params_t *params,
+                                          int nruns, nbctest_result_t *result)
+{
+    enum { NSTAT = 3 };
+    double stat[NSTAT], *allstat = NULL;
+    const char *fmt = NULL;
+    double timescale = 0;
+    int i;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-7d %-7d %-12.6f %-12.6f %-12.6f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-7d %-7d %-14.2f %-14.2f %-14.2f\n";
+        timescale = 1E6;
+    }
+
+    if (IS_MASTER_RANK)
+        allstat = xmalloc(sizeof(*allstat) * NSTAT * params->nprocs);
+
+    stat[0] = result->inittime * timescale;
+    stat[1] = result->waittime * timescale;
+    stat[2] = result->totaltime * timescale;
+    MPI_Gather(stat, NSTAT, MPI_DOUBLE, allstat, NSTAT, MPI_DOUBLE,
+               mpiperf_master_rank, params->comm);
+
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    for (i = 0; i < params->nprocs; i++) {
+        fprintf(mpiperf_repstream, fmt, params->nprocs, params->count, i,
+                nruns, allstat[i * NSTAT], allstat[i * NSTAT + 1],
+                allstat[i * NSTAT + 2]);
+    }
+    free(allstat);
+    return MPIPERF_SUCCESS;
+}
@@ -11,7 +11,8 @@
 
 #include "stat.h"
 
-#if MPICH2_NUMVERSION >= 10500002 || (OMPI_MAJOR_VERSION > 0 && OMPI_MINOR_VERSION > 6)
+#if MPI_VERSION >= 3 || MPICH2_NUMVERSION >= 10500002 || \
+    (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION > 6))
 #define HAVE_NBC
 #endif
 
@@ -41,6 +42,10 @@ typedef struct {
     int nprocs;
     int count;
     double comptime;
+    double testinterval;    /* Interval of MPI_Test calls in computations:
+                               < 0 - default, 0 - no calls (see -f) */
+    int noutstanding;       /* Number of outstanding operations (see -n) */
+    int root;       /* Root of rooted collectives (see rootpolicy.h) */
 } nbctest_params_t;
 
 /* Test results */
@@ -49,6 +54,7 @@ typedef struct {
     double waittime;
     double realcomptime;
     double totaltime;
+    double testtime;        /* Time of MPI_Test calls */
     int ntests;
 } nbctest_result_t;
 
@@ -68,6 +74,8 @@ typedef struct {
     nbcbench_printinfo_ptr_t printinfo;
     nbcbench_collop_blocking_ptr_t blockingop;  /* Measures NBC in blocking mode */
     nbcbench_collop_overlap_ptr_t overlapop;    /* Measures NBC overlap */
+    nbcbench_collop_blocking_ptr_t multiop;     /* Measures k outstanding NBC
+                                                   (k x Iop + Waitall) */
 } nbcbench_t;
 
 extern nbcbench_t nbcbenchtab[];
@@ -85,7 +93,11 @@ int run_nbcbench_overlap_test(nbcbench_t *bench,
                               stat_sample_t *waittimestat,
                               stat_sample_t *comptimestat,
                               stat_sample_t *totaltimestat,
-                              stat_sample_t *overlapstat);
+                              stat_sample_t *overlapstat,
+                              stat_sample_t *ntestsstat,
+                              stat_sample_t *testtimestat);
+int run_nbcbench_testsweep(nbcbench_t *bench, nbctest_params_t *params);
+int run_nbcbench_outstanding(nbcbench_t *bench, nbctest_params_t *params);
 
 int nbcbench_measure_blocking_time(nbcbench_t *bench, nbctest_params_t *params,
                                    double *globaltime, double *localtime);
@@ -105,6 +117,22 @@ int report_write_nbcbench_overlap(nbcbench_t *bench, nbctest_params_t *params,
                                   stat_sample_t *totaltimestat,
                                   stat_sample_t *overlapstat);
 
+int report_write_nbcbench_testsweep(nbcbench_t *bench, nbctest_params_t *params,
+                                    int nruns, int ncorrectruns,
+                                    double blockingtime,
+                                    stat_sample_t *totaltimestat,
+                                    stat_sample_t *overlapstat,
+                                    stat_sample_t *ntestsstat,
+                                    stat_sample_t *testtimestat,
+                                    double *overlap);
+
+int report_write_nbcbench_outstanding(nbcbench_t *bench,
+                                      nbctest_params_t *params,
+                                      int nruns, int ncorrectruns,
+                                      stat_sample_t *inittimestat,
+                                      stat_sample_t *waittimestat,
+                                      stat_sample_t *totaltimestat);
+
 int report_write_nbcbench_procstat_overlap(nbcbench_t *bench,
                                            nbctest_params_t *params,
                                            int nruns, int ncorrectruns,
@@ -141,4 +169,13 @@ int report_write_nbcbench_procstat_blocking(nbcbench_t *bench,
                                             stat_sample_t *waittimestat,
                                             stat_sample_t *totaltimestat);
 
+int run_nbcbench_nosync(nbcbench_t *bench, nbctest_params_t *params);
+int run_nbcbench_nosync_test(nbcbench_t *bench, nbctest_params_t *params,
+                             int *nruns, nbctest_result_t *result);
+int report_write_nbcbench_nosync(nbcbench_t *bench, nbctest_params_t *params,
+                                 int nruns, nbctest_result_t *result);
+int report_write_nbcbench_procstat_nosync(nbcbench_t *bench,
+                                          nbctest_params_t *params,
+                                          int nruns, nbctest_result_t *result);
+
 #endif /* BENCH_NBC_H */
@@ -18,6 +18,11 @@
 #include "nbc/iexscan.h"
 #include "nbc/igather.h"
 #include "nbc/igatherv.h"
+#include "nbc/ineighbor_allgather.h"
+#include "nbc/ineighbor_allgatherv.h"
+#include "nbc/ineighbor_alltoall.h"
+#include "nbc/ineighbor_alltoallv.h"
+#include "nbc/ineighbor_alltoallw.h"
 #include "nbc/ireduce_scatter_block.h"
 #include "nbc/ireduce_scatter.h"
 #include "nbc/ireduce.h"
@@ -92,6 +97,7 @@ nbcbench_t nbcbenchtab[] = {
     (nbcbench_printinfo_ptr_t)bench_iallreduce_printinfo,
     (nbcbench_collop_blocking_ptr_t)measure_iallreduce_blocking,
     (nbcbench_collop_overlap_ptr_t)measure_iallreduce_overlap,
+    (nbcbench_collop_blocking_ptr_t)measure_iallreduce_multi,
 },
 {
     "Ialltoall",
@@ -100,6 +106,7 @@ nbcbench_t nbcbenchtab[] = {
     (nbcbench_printinfo_ptr_t)bench_ialltoall_printinfo,
     (nbcbench_collop_blocking_ptr_t)measure_ialltoall_blocking,
     (nbcbench_collop_overlap_ptr_t)measure_ialltoall_overlap,
+    (nbcbench_collop_blocking_ptr_t)measure_ialltoall_multi,
 },
 {
     "Ialltoallv",
@@ -124,6 +131,7 @@ nbcbench_t nbcbenchtab[] = {
     (nbcbench_printinfo_ptr_t)bench_ibarrier_printinfo,
     (nbcbench_collop_blocking_ptr_t)measure_ibarrier_blocking,
     (nbcbench_collop_overlap_ptr_t)measure_ibarrier_overlap,
+    (nbcbench_collop_blocking_ptr_t)measure_ibarrier_multi,
 },
 {
     "Ibcast",
@@ -132,6 +140,7 @@ nbcbench_t nbcbenchtab[] = {
     (nbcbench_printinfo_ptr_t)bench_ibcast_printinfo,
     (nbcbench_collop_blocking_ptr_t)measure_ibcast_blocking,
     (nbcbench_collop_overlap_ptr_t)measure_ibcast_overlap,
+    (nbcbench_collop_blocking_ptr_t)measure_ibcast_multi,
 },
 {
     "Iexscan",
@@ -204,8 +213,50 @@ nbcbench_t nbcbenchtab[] = {
     (nbcbench_printinfo_ptr_t)bench_iscatterv_printinfo,
     (nbcbench_collop_blocking_ptr_t)measure_iscatterv_blocking,
     (nbcbench_collop_overlap_ptr_t)measure_iscatterv_overlap,
+},
+#ifdef HAVE_NEIGHBOR_COLL
+{
+    "Ineighbor_allgather",
+    (nbcbench_init_ptr_t)bench_ineighbor_allgather_init,
+    (nbcbench_free_ptr_t)bench_ineighbor_allgather_free,
+    (nbcbench_printinfo_ptr_t)bench_ineighbor_allgather_printinfo,
+    (nbcbench_collop_blocking_ptr_t)measure_ineighbor_allgather_blocking,
+    (nbcbench_collop_overlap_ptr_t)measure_ineighbor_allgather_overlap,
+},
+{
+    "Ineighbor_allgatherv",
+    (nbcbench_init_ptr_t)bench_ineighbor_allgatherv_init,
+    (nbcbench_free_ptr_t)bench_ineighbor_allgatherv_free,
+    (nbcbench_printinfo_ptr_t)bench_ineighbor_allgatherv_printinfo,
+    (nbcbench_collop_blocking_ptr_t)measure_ineighbor_allgatherv_blocking,
+    (nbcbench_collop_overlap_ptr_t)measure_ineighbor_allgatherv_overlap,
+},
+{
+    "Ineighbor_alltoall",
+    (nbcbench_init_ptr_t)bench_ineighbor_alltoall_init,
+    (nbcbench_free_ptr_t)bench_ineighbor_alltoall_free,
+    (nbcbench_printinfo_ptr_t)bench_ineighbor_alltoall_printinfo,
+    (nbcbench_collop_blocking_ptr_t)measure_ineighbor_alltoall_blocking,
+    (nbcbench_collop_overlap_ptr_t)measure_ineighbor_alltoall_overlap,
+},
+{
+    "Ineighbor_alltoallv",
+    (nbcbench_init_ptr_t)bench_ineighbor_alltoallv_init,
+    (nbcbench_free_ptr_t)bench_ineighbor_alltoallv_free,
+    (nbcbench_printinfo_ptr_t)bench_ineighbor_alltoallv_printinfo,
+    (nbcbench_collop_blocking_ptr_t)measure_ineighbor_alltoallv_blocking,
+    (nbcbench_collop_overlap_ptr_t)measure_ineighbor_alltoallv_overlap,
+},
+{
+    "Ineighbor_alltoallw",
+    (nbcbench_init_ptr_t)bench_ineighbor_alltoallw_init,
+    (nbcbench_free_ptr_t)bench_ineighbor_alltoallw_free,
+    (nbcbench_printinfo_ptr_t)bench_ineighbor_alltoallw_printinfo,
+    (nbcbench_collop_blocking_ptr_t)measure_ineighbor_alltoallw_blocking,
+    (nbcbench_collop_overlap_ptr_t)measure_ineighbor_alltoallw_overlap,
 }
 #endif
+#endif
 };
 
 #endif /* BENCH_NBC_TAB_H */
@@ -0,0 +1,520 @@
+/*
+ * bench_persistent.c: Functions for benchmarking MPI persistent
+ *                     collective routines (MPI 4.0 *_init).
+ *
+ * Persistent request is created once by *_init routine and then started
+ * many times by MPI_Start. Cost of request creation (setup time) is
+ * measured separately from the cost of MPI_Start + MPI_Wait, which is
+ * measured by NBC drivers (blocking and overlap modes).
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include <mpi.h>
+
+#include "bench_persistent.h"
+#include "bench_nbc.h"
+#include "mpiperf.h"
+#include "stat.h"
+#include "timeslot.h"
+#include "report.h"
+#include "logger.h"
+#include "util.h"
+#include "hpctimer.h"
+#include "rootpolicy.h"
+#include "bench_persistent_tab.h"
+
+enum {
+    COMPTIME_SCALE = 2
+};
+
+/* run_persistentbench: Runs benchmark for persistent collective operation */
+int run_persistentbench(persistentbench_t *bench)
+{
+    double benchtime;
+    nbctest_params_t params;
+
+    if (mpiperf_synctype == SYNC_NONE) {
+        exit_error("nosync mode is not supported for persistent collectives");
+    }
+    if (mpiperf_nbc_noutstanding > 0) {
+        exit_error("Outstanding operations (-n) are not supported for persistent collectives");
+    }
+    if (!rootpolicy_isfixed()) {
+        exit_error("Root of persistent collective is fixed at request creation: "
+                   "use -y fixed[:<rank>]");
+    }
+
+    benchtime = hpctimer_wtime();
+    timeslot_initialize();
+
+    report_write_header();
+    report_write_persistentbench_header(bench);
+    if (mpiperf_perprocreport)
+        report_write_nbcbench_procstat_header(&bench->nbc);
+
+    params.testinterval = -1.0;
+    params.noutstanding = 1;
+
+    /* For each communicator size */
+    for (params.nprocs = mpiperf_nprocs_min;
+         params.nprocs <= mpiperf_nprocs_max; )
+    {
+        params.comm = createcomm(MPI_COMM_WORLD, params.nprocs);
+
+        /* For each data size (count) */
+        for (params.count = mpiperf_count_min;
+             params.count <= mpiperf_count_max; )
+        {
+            if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP)
+                run_persistentbench_overlap(bench, &params);
+            else
+                run_persistentbench_blocking(bench, &params);
+
+            if (mpiperf_count_step_type == STEP_TYPE_MUL) {
+                params.count *= mpiperf_count_step;
+            } else {
+                params.count += mpiperf_count_step;
+            }
+        }
+        if (params.comm != MPI_COMM_NULL)
+            MPI_Comm_free(&params.comm);
+
+        if (mpiperf_nprocs_step_type == STEP_TYPE_MUL) {
+            params.nprocs *= mpiperf_nprocs_step;
+        } else {
+            params.nprocs += mpiperf_nprocs_step;
+        }
+    }
+
+    timeslot_finalize();
+    MPI_Barrier(MPI_COMM_WORLD);
+    benchtime = hpctimer_wtime() - benchtime;
+    if (IS_MASTER_RANK) {
+        report_printf("# Elapsed time: %.6f sec.\n", benchtime);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * persistentbench_measure_setup_time: Measures time of persistent request
+ *                                     creation (*_init routine).
+ *
+ * Request creation is a local operation in most implementations, so
+ * setup time is computed as max_of_all_procs(mean_of_runs(t[i][j])).
+ */
+int persistentbench_measure_setup_time(persistentbench_t *bench,
+                                       nbctest_params_t *params,
+                                       double *globaltime)
+{
+    stat_sample_t *timestat;
+    double time, localtime;
+    int i;
+
+    if ( (timestat = stat_sample_create()) == NULL) {
+        exit_error("No enough memory");
+    }
+
+    params->root = rootpolicy_reset(params->nprocs);
+    if (bench->nbc.init)
+        bench->nbc.init(params);
+
+    for (i = 0; i < mpiperf_nruns_min; i++) {
+        MPI_Barrier(params->comm);
+        if (bench->reqinit(params, &time) == MEASURE_SUCCESS) {
+            stat_sample_add(timestat, time);
+            logger_log("Setup time (run %d): %.6f", i, time);
+        }
+    }
+
+    if (bench->nbc.free)
+        bench->nbc.free();
+
+    localtime = stat_sample_mean(timestat);
+    MPI_Allreduce(&localtime, globaltime, 1, MPI_DOUBLE, MPI_MAX, params->comm);
+    stat_sample_free(timestat);
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * run_persistentbench_blocking: Measures setup time and time of
+ *                               MPI_Start + MPI_Wait.
+ */
+int run_persistentbench_blocking(persistentbench_t *bench,
+                                 nbctest_params_t *params)
+{
+    int nruns, ncorrectruns;
+    double setuptime;
+    stat_sample_t *inittimestat, *waittimestat, *totaltimestat;
+    stat_sample_t *inittimestat_local, *waittimestat_local, *totaltimestat_local;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    logger_log("Test (nprocs = %d, count = %d) is started",
+               params->nprocs, params->count);
+
+    if (params->comm != MPI_COMM_NULL) {
+        /* This process participates in measures */
+        inittimestat = stat_sample_create();
+        inittimestat_local = stat_sample_create();
+        waittimestat = stat_sample_create();
+        waittimestat_local = stat_sample_create();
+        totaltimestat = stat_sample_create();
+        totaltimestat_local = stat_sample_create();
+
+        if (inittimestat == NULL || waittimestat == NULL ||
+            totaltimestat == NULL || inittimestat_local == NULL ||
+            waittimestat_local == NULL || totaltimestat_local == NULL)
+        {
+            exit_error("Can't allocate memory for statistic");
+        }
+
+        persistentbench_measure_setup_time(bench, params, &setuptime);
+        logger_log("Setup time: %.6f sec", setuptime);
+
+        run_nbcbench_blocking_test(&bench->nbc, params, &nruns, &ncorrectruns,
+                                   inittimestat, waittimestat, totaltimestat,
+                                   inittimestat_local, waittimestat_local,
+                                   totaltimestat_local);
+
+        report_write_persistentbench_blocking(bench, params, setuptime,
+                                              nruns, ncorrectruns,
+                                              inittimestat, waittimestat,
+                                              totaltimestat);
+        if (mpiperf_perprocreport) {
+            report_write_nbcbench_procstat_blocking(&bench->nbc, params,
+                                                    nruns, ncorrectruns,
+                                                    inittimestat_local,
+                                                    waittimestat_local,
+                                                    totaltimestat_local);
+        }
+        stat_sample_free(inittimestat);
+        stat_sample_free(waittimestat);
+        stat_sample_free(totaltimestat);
+        stat_sample_free(inittimestat_local);
+        stat_sample_free(waittimestat_local);
+        stat_sample_free(totaltimestat_local);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * run_persistentbench_overlap: Measures setup time and overlap of
+ *                              MPI_Start + Comp + MPI_Wait.
+ */
+int run_persistentbench_overlap(persistentbench_t *bench,
+                                nbctest_params_t *params)
+{
+    double setuptime, blockingtime, blockingtime_local;
+    double comptime_min, comptime_max, comptime_step;
+    int nruns, ncorrectruns;
+    stat_sample_t *inittimestat, *waittimestat, *comptimestat, *totaltimestat,
+                  *overlapstat;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    logger_log("Test (nprocs = %d, count = %d) is started",
+               params->nprocs, params->count);
+
+    if (params->comm != MPI_COMM_NULL) {
+        /* This process participates in measures */
+        inittimestat = stat_sample_create();
+        waittimestat = stat_sample_create();
+        comptimestat = stat_sample_create();
+        totaltimestat = stat_sample_create();
+        overlapstat = stat_sample_create();
+        if (inittimestat == NULL || waittimestat == NULL || comptimestat == NULL
+            || totaltimestat == NULL || overlapstat == NULL)
+        {
+            exit_error("Can't allocate memory for statistic");
+        }
+
+        persistentbench_measure_setup_time(bench, params, &setuptime);
+        logger_log("Setup time: %.6f sec", setuptime);
+
+        /* Measure MPI_Start + MPI_Wait time in blocking mode */
+        nbcbench_measure_blocking_time(&bench->nbc, params, &blockingtime,
+                                       &blockingtime_local);
+        if (blockingtime < 1E-6)
+            blockingtime = 1E-9;
+        if (blockingtime_local < 1E-6)
+            blockingtime_local = 1E-9;
+
+        if (mpiperf_comptime_niters == 1) {
+            comptime_min = blockingtime * COMPTIME_SCALE;
+            comptime_max = blockingtime * COMPTIME_SCALE + 1.0;
+            comptime_step = comptime_max;
+        } else {
+            comptime_min = 0.0;
+            comptime_max = blockingtime * COMPTIME_SCALE;
+            comptime_step = comptime_max / mpiperf_comptime_niters;
+        }
+
+        /* For each comptime */
+        for (params->comptime = comptime_min; params->comptime <= comptime_max;
+             params->comptime += comptime_step)
+        {
+            stat_sample_clean(inittimestat);
+            stat_sample_clean(waittimestat);
+            stat_sample_clean(comptimestat);
+            stat_sample_clean(totaltimestat);
+            stat_sample_clean(overlapstat);
+
+            run_nbcbench_overlap_test(&bench->nbc, params, blockingtime_local,
+                                      &nruns, &ncorrectruns, inittimestat,
+                                      waittimestat, comptimestat, totaltimestat,
+                                      overlapstat, NULL, NULL);
+
+            report_write_persistentbench_overlap(bench, params, setuptime,
+                                                 nruns, ncorrectruns,
+                                                 blockingtime, inittimestat,
+                                                 waittimestat, comptimestat,
+                                                 totaltimestat, overlapstat);
+            if (mpiperf_perprocreport) {
+                report_write_nbcbench_procstat_overlap(&bench->nbc, params,
+                                                       nruns, ncorrectruns,
+                                                       blockingtime_local,
+                                                       inittimestat,
+                                                       waittimestat,
+                                                       comptimestat,
+                                                       totaltimestat,
+                                                       overlapstat);
+            }
+        }
+        stat_sample_free(inittimestat);
+        stat_sample_free(waittimestat);
+        stat_sample_free(comptimestat);
+        stat_sample_free(totaltimestat);
+        stat_sample_free(overlapstat);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * measure_persistent_blocking: Measures MPI_Start + MPI_Wait of
+ *                              persistent request.
+ */
+int measure_persistent_blocking(MPI_Request *req, nbctest_params_t *params,
+                                nbctest_result_t *result)
+{
+    double starttime, endtime;
+    int rc;
+
+    if (*req == MPI_REQUEST_NULL)
+        return MEASURE_FAILURE;
+
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    rc = MPI_Start(req);
+    result->inittime = hpctimer_wtime() - result->inittime;
+    result->waittime = hpctimer_wtime();
+    if (rc == MPI_SUCCESS)
+        rc = MPI_Wait(req, MPI_STATUS_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+    return MEASURE_FAILURE;
+}
+
+/*
+ * measure_persistent_overlap: Measures MPI_Start + Comp + MPI_Wait of
+ *                             persistent request.
+ */
+int measure_persistent_overlap(MPI_Request *req, nbctest_params_t *params,
+                               nbctest_result_t *result)
+{
+    double starttime, endtime;
+    int rc;
+
+    if (*req == MPI_REQUEST_NULL)
+        return MEASURE_FAILURE;
+
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    rc = MPI_Start(req);
+    result->inittime = hpctimer_wtime() - result->inittime;
+    nbcbench_simulate_computing(params, req, result);
+    result->waittime = hpctimer_wtime();
+    if (rc == MPI_SUCCESS)
+        rc = MPI_Wait(req, MPI_STATUS_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+    return MEASURE_FAILURE;
+}
+
+void print_persistentbench_info()
+{
+    int i;
+
+    printf("=== Persistent collective operations ===\n");
+    for (i = 0; i < NELEMS(persistentbenchtab); i++) {
+        if (persistentbenchtab[i].nbc.printinfo) {
+            persistentbenchtab[i].nbc.printinfo(&persistentbenchtab[i]);
+        }
+    }
+}
+
+persistentbench_t *lookup_persistentbench(const char *name)
+{
+    int i;
+
+    for (i = 0; i < NELEMS(persistentbenchtab); i++) {
+        if (strcasecmp(persistentbenchtab[i].nbc.name, name) == 0) {
+            return &persistentbenchtab[i];
+        }
+    }
+    return NULL;
+}
+
+int report_write_persistentbench_header(persistentbench_t *bench)
+{
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    printf("# Characteristics of measurements:\n");
+    printf("#   Procs: total number of processes\n");
+    printf("#   Count: count of elements in send/recv buffer\n");
+    printf("#   Setup: time of persistent request creation (*_init)\n");
+    if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP) {
+        printf("#   BlockingTime: time of MPI_Start + MPI_Wait\n");
+        printf("#   CompTime: time of computations\n");
+    }
+    printf("#   TRuns: total number of measurements (valid and invalid runs)\n");
+    printf("#   CRuns: number of correct measurements (only valid runs)\n");
+    printf("#   RSE: relative standard error of total time (StdErr / Mean)\n");
+    printf("#   Start: time of MPI_Start\n");
+    printf("#   Wait: time of MPI_Wait\n");
+    if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP) {
+        printf("#   CompTimeReal: real time of waiting loop (for CompTime)\n");
+        printf("#   Total: total time with computations (Start + Comp + Wait)\n");
+        printf("#   Overlap: 1 - (Total - CompTime) / BlockingTime\n");
+    } else {
+        printf("#   Total: total time (Start + Wait)\n");
+    }
+    printf("#\n");
+    printf("# Value of Setup is computed as max_of_all_procs(mean_of_runs(t[i][j])).\n");
+    printf("# Setup is paid once per request; compare Total with the time of\n");
+    printf("# the corresponding NBC benchmark to find the number of starts\n");
+    printf("# after which the setup pays off.\n");
+    printf("#\n");
+    printf("# -------------------------------------------------------------------------------------\n");
+    printf("# Benchmark: %s\n", bench->nbc.name);
+    if (mpiperf_nbcbench_mode == NBCBENCH_OVERLAP) {
+        printf("# Benchmarking mode: overlap measure (Start + Comp + Wait)\n");
+        if (mpiperf_timescale == TIMESCALE_SEC) {
+            printf("# [Procs] [Count]     [Setup]      [BlockingTime] [CompTime]   [TRuns] [CRuns] [RSE]      [Start]      [Wait]       [CompTimeReal] [Total]      [Overlap]\n");
+        } else {
+            /* usec */
+            printf("# [Procs] [Count]     [Setup]        [BlockingTime] [CompTime]     [TRuns] [CRuns] [RSE]      [Start]        [Wait]         [CompTimeReal] [Total]        [Overlap]\n");
+        }
+    } else {
+        printf("# Benchmarking mode: blocking time (Start + Wait)\n");
+        if (mpiperf_timescale == TIMESCALE_SEC) {
+            printf("# [Procs] [Count]     [Setup]      [TRuns] [CRuns] [RSE]      [Start]      [Wait]       [Total]\n");
+        } else {
+            /* usec */
+            printf("# [Procs] [Count]     [Setup]        [TRuns] [CRuns] [RSE]      [Start]        [Wait]         [Total]\n");
+        }
+    }
+    printf("# -------------------------------------------------------------------------------------\n");
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_persistentbench_blocking(persistentbench_t *bench,
+                                          nbctest_params_t *params,
+                                          double setuptime,
+                                          int nruns, int ncorrectruns,
+                                          stat_sample_t *starttimestat,
+                                          stat_sample_t *waittimestat,
+                                          stat_sample_t *totaltimestat)
+{
+    const char *fmt = NULL;
+    double timescale = 0;
+
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-12.6f %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-14.2f %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f\n";
+        timescale = 1E6;
+    }
+
+    printf(fmt, params->nprocs, params->count, setuptime * timescale,
+           nruns, ncorrectruns,
+           stat_sample_stderr_rel(totaltimestat),
+           stat_sample_mean(starttimestat) * timescale,
+           stat_sample_mean(waittimestat) * timescale,
+           stat_sample_mean(totaltimestat) * timescale);
+
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_persistentbench_overlap(persistentbench_t *bench,
+                                         nbctest_params_t *params,
+                                         double setuptime,
+                                         int nruns, int ncorrectruns,
+                                         double blockingtime,
+                                         stat_sample_t *starttimestat,
+                                         stat_sample_t *waittimestat,
+                                         stat_sample_t *comptimestat,
+                                         stat_sample_t *totaltimestat,
+                                         stat_sample_t *overlapstat)
+{
+    enum {
+        STARTTIME = 0,
+        WAITTIME = 1,
+        COMPTIME = 2,
+        TOTALTIME = 3,
+        OVERLAP = 4,
+        TOTALRSE = 5
+    };
+    enum { NSTAT = 6 };
+    double stat[NSTAT], allstat[NSTAT];
+    const char *fmt = NULL;
+    double timescale = 0;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-12.6f %-12.6f   %-12.6f %-7d %-7d %-10.2f %-12.6f %-12.6f %-12.6f   %-12.6f %-8.2f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-14.2f %-14.2f %-14.2f %-7d %-7d %-10.2f %-14.2f %-14.2f %-14.2f %-14.2f %-8.2f\n";
+        timescale = 1E6;
+    }
+
+    stat[STARTTIME] = stat_sample_mean(starttimestat) * timescale;
+    stat[WAITTIME] = stat_sample_mean(waittimestat) * timescale;
+    stat[COMPTIME] = stat_sample_mean(comptimestat) * timescale;
+    stat[TOTALTIME] = stat_sample_mean(totaltimestat) * timescale;
+    stat[OVERLAP] = stat_sample_mean(overlapstat);
+    stat[TOTALRSE] = stat_sample_stderr_rel(totaltimestat);
+
+    MPI_Reduce(stat, allstat, NSTAT, MPI_DOUBLE, MPI_MAX, mpiperf_master_rank,
+               params->comm);
+
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    printf(fmt, params->nprocs, params->count, setuptime * timescale,
+           blockingtime * timescale, params->comptime * timescale,
+           nruns, ncorrectruns, allstat[TOTALRSE], allstat[STARTTIME],
+           allstat[WAITTIME], allstat[COMPTIME], allstat[TOTALTIME],
+           allstat[OVERLAP]);
+
+    return MPIPERF_SUCCESS;
+}
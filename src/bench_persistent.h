@@ -0,0 +1,88 @@
+/*
+ * bench_persistent.h: Functions for benchmarking MPI persistent
+ *                     collective routines (MPI 4.0 *_init).
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef BENCH_PERSISTENT_H
+#define BENCH_PERSISTENT_H
+
+#include <mpi.h>
+
+#include "bench_nbc.h"
+#include "stat.h"
+
+#if MPI_VERSION >= 4
+#  define HAVE_PERSISTENT_COLL
+#elif defined(OPEN_MPI) && OPEN_MPI
+#  include <mpi-ext.h>
+#  if defined(OMPI_HAVE_MPI_EXT_PCOLLREQ) && OMPI_HAVE_MPI_EXT_PCOLLREQ
+#    define HAVE_PERSISTENT_COLL
+#    define MPI_Allgather_init MPIX_Allgather_init
+#    define MPI_Allreduce_init MPIX_Allreduce_init
+#    define MPI_Alltoall_init MPIX_Alltoall_init
+#    define MPI_Barrier_init MPIX_Barrier_init
+#    define MPI_Bcast_init MPIX_Bcast_init
+#    define MPI_Gather_init MPIX_Gather_init
+#    define MPI_Reduce_scatter_block_init MPIX_Reduce_scatter_block_init
+#    define MPI_Reduce_init MPIX_Reduce_init
+#    define MPI_Scan_init MPIX_Scan_init
+#    define MPI_Scatter_init MPIX_Scatter_init
+#  endif
+#endif
+
+typedef int (*persistentbench_reqinit_ptr_t)(nbctest_params_t *params,
+                                             double *time);
+
+/*
+ * Benchmark: persistent request is created in init function and
+ * MPI_Start + MPI_Wait are measured by NBC measure functions.
+ */
+typedef struct {
+    nbcbench_t nbc;
+    persistentbench_reqinit_ptr_t reqinit;  /* Recreates request (*_init) */
+} persistentbench_t;
+
+extern persistentbench_t persistentbenchtab[];
+
+void print_persistentbench_info();
+persistentbench_t *lookup_persistentbench(const char *name);
+
+int run_persistentbench(persistentbench_t *bench);
+int run_persistentbench_blocking(persistentbench_t *bench,
+                                 nbctest_params_t *params);
+int run_persistentbench_overlap(persistentbench_t *bench,
+                                nbctest_params_t *params);
+
+int persistentbench_measure_setup_time(persistentbench_t *bench,
+                                       nbctest_params_t *params,
+                                       double *globaltime);
+
+int measure_persistent_blocking(MPI_Request *req, nbctest_params_t *params,
+                                nbctest_result_t *result);
+int measure_persistent_overlap(MPI_Request *req, nbctest_params_t *params,
+                               nbctest_result_t *result);
+
+int report_write_persistentbench_header(persistentbench_t *bench);
+
+int report_write_persistentbench_blocking(persistentbench_t *bench,
+                                          nbctest_params_t *params,
+                                          double setuptime,
+                                          int nruns, int ncorrectruns,
+                                          stat_sample_t *starttimestat,
+                                          stat_sample_t *waittimestat,
+                                          stat_sample_t *totaltimestat);
+
+int report_write_persistentbench_overlap(persistentbench_t *bench,
+                                         nbctest_params_t *params,
+                                         double setuptime,
+                                         int nruns, int ncorrectruns,
+                                         double blockingtime,
+                                         stat_sample_t *starttimestat,
+                                         stat_sample_t *waittimestat,
+                                         stat_sample_t *comptimestat,
+                                         stat_sample_t *totaltimestat,
+                                         stat_sample_t *overlapstat);
+
+#endif /* BENCH_PERSISTENT_H */
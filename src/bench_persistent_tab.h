@@ -0,0 +1,136 @@
+/*
+ * bench_persistent_tab.h:
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef BENCH_PERSISTENT_TAB_H
+#define BENCH_PERSISTENT_TAB_H
+
+#include "persistent/pallgather.h"
+#include "persistent/pallreduce.h"
+#include "persistent/palltoall.h"
+#include "persistent/pbarrier.h"
+#include "persistent/pbcast.h"
+#include "persistent/pgather.h"
+#include "persistent/preduce_scatter_block.h"
+#include "persistent/preduce.h"
+#include "persistent/pscan.h"
+#include "persistent/pscatter.h"
+
+persistentbench_t persistentbenchtab[] = {
+#ifdef HAVE_PERSISTENT_COLL
+{
+    {
+      "Allgather_init",
+      (nbcbench_init_ptr_t)bench_pallgather_init,
+      (nbcbench_free_ptr_t)bench_pallgather_free,
+      (nbcbench_printinfo_ptr_t)bench_pallgather_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_pallgather_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_pallgather_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_pallgather_reqinit
+},
+{
+    {
+      "Allreduce_init",
+      (nbcbench_init_ptr_t)bench_pallreduce_init,
+      (nbcbench_free_ptr_t)bench_pallreduce_free,
+      (nbcbench_printinfo_ptr_t)bench_pallreduce_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_pallreduce_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_pallreduce_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_pallreduce_reqinit
+},
+{
+    {
+      "Alltoall_init",
+      (nbcbench_init_ptr_t)bench_palltoall_init,
+      (nbcbench_free_ptr_t)bench_palltoall_free,
+      (nbcbench_printinfo_ptr_t)bench_palltoall_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_palltoall_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_palltoall_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_palltoall_reqinit
+},
+{
+    {
+      "Barrier_init",
+      (nbcbench_init_ptr_t)bench_pbarrier_init,
+      (nbcbench_free_ptr_t)bench_pbarrier_free,
+      (nbcbench_printinfo_ptr_t)bench_pbarrier_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_pbarrier_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_pbarrier_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_pbarrier_reqinit
+},
+{
+    {
+      "Bcast_init",
+      (nbcbench_init_ptr_t)bench_pbcast_init,
+      (nbcbench_free_ptr_t)bench_pbcast_free,
+      (nbcbench_printinfo_ptr_t)bench_pbcast_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_pbcast_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_pbcast_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_pbcast_reqinit
+},
+{
+    {
+      "Gather_init",
+      (nbcbench_init_ptr_t)bench_pgather_init,
+      (nbcbench_free_ptr_t)bench_pgather_free,
+      (nbcbench_printinfo_ptr_t)bench_pgather_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_pgather_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_pgather_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_pgather_reqinit
+},
+{
+    {
+      "Reduce_scatter_block_init",
+      (nbcbench_init_ptr_t)bench_preduce_scatter_block_init,
+      (nbcbench_free_ptr_t)bench_preduce_scatter_block_free,
+      (nbcbench_printinfo_ptr_t)bench_preduce_scatter_block_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_preduce_scatter_block_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_preduce_scatter_block_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_preduce_scatter_block_reqinit
+},
+{
+    {
+      "Reduce_init",
+      (nbcbench_init_ptr_t)bench_preduce_init,
+      (nbcbench_free_ptr_t)bench_preduce_free,
+      (nbcbench_printinfo_ptr_t)bench_preduce_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_preduce_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_preduce_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_preduce_reqinit
+},
+{
+    {
+      "Scan_init",
+      (nbcbench_init_ptr_t)bench_pscan_init,
+      (nbcbench_free_ptr_t)bench_pscan_free,
+      (nbcbench_printinfo_ptr_t)bench_pscan_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_pscan_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_pscan_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_pscan_reqinit
+},
+{
+    {
+      "Scatter_init",
+      (nbcbench_init_ptr_t)bench_pscatter_init,
+      (nbcbench_free_ptr_t)bench_pscatter_free,
+      (nbcbench_printinfo_ptr_t)bench_pscatter_printinfo,
+      (nbcbench_collop_blocking_ptr_t)measure_pscatter_blocking,
+      (nbcbench_collop_overlap_ptr_t)measure_pscatter_overlap
+    },
+    (persistentbench_reqinit_ptr_t)measure_pscatter_reqinit
+}
+#endif
+};
+
+#endif /* BENCH_PERSISTENT_TAB_H */
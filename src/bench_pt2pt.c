@@ -9,6 +9,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <strings.h>
+#include <stdint.h>
+#include <limits.h>
 
 #include <mpi.h>
 
@@ -20,10 +22,27 @@
 #include "logger.h"
 #include "util.h"
 #include "hpctimer.h"
+#include "mpigclock.h"
 #include "bench_pt2pt_tab.h"
 
 #define TEST_SLOTLEN_SCALE 1.1
 
+enum {
+    BOTHSIDED_TAG = 2
+};
+
+static void pt2ptbench_bothsided_stage(pt2pttest_params_t *params,
+                                       int stage_nruns, int *stagerc,
+                                       double *stage_exectime,
+                                       double *stagetimestamps,
+                                       stat_sample_t *recvstat,
+                                       stat_sample_t *onewaystat);
+
+static void pt2ptbench_matrix_round(int nplayers, int round, int *senders,
+                                    int *receivers);
+static void report_write_pt2ptbench_matrix(pt2pttest_params_t *params,
+                                           double *timematrix, int nplayers);
+
 /*
  * run_pt2ptbench: Runs benchmark for point-to-point operation.
  */
@@ -36,17 +55,30 @@ int run_pt2ptbench(pt2ptbench_t *bench)
         exit_error("Too few processes in communicator: %d", mpiperf_commsize);
     }
 
-    if (mpiperf_synctype == SYNC_NONE) {
-        exit_error("nosync mode is not supported for point-to-point operations");
+    if (mpiperf_synctype == SYNC_NONE && mpiperf_pt2pt_bothsided) {
+        exit_error("Both-sided timing (-B) is not supported in nosync mode");
+    }
+
+    if (mpiperf_matrixreport) {
+        return run_pt2ptbench_matrix(bench);
     }
 
     benchtime = hpctimer_wtime();
     timeslot_initialize();
 
+    params.npairs = (mpiperf_pt2pt_npairs > 0) ? mpiperf_pt2pt_npairs :
+                    mpiperf_commsize / 2;
+    params.nprocs = 2 * params.npairs;
+    if (params.nprocs > mpiperf_commsize) {
+        exit_error("Too few processes in communicator for %d pairs: %d",
+                   params.npairs, mpiperf_commsize);
+    }
+
     report_write_header();
     report_write_pt2ptbench_header(bench);
+    if (mpiperf_perprocreport && params.npairs > 1)
+        report_write_pt2ptbench_pairstat_header(bench);
 
-    params.nprocs = 2;
     params.comm = createcomm(MPI_COMM_WORLD, params.nprocs);
 
     /* For each data size (count) */
@@ -74,6 +106,200 @@ int run_pt2ptbench(pt2ptbench_t *bench)
     return MPIPERF_SUCCESS;
 }
 
+/*
+ * run_pt2ptbench_matrix: Measures point-to-point operation between all pairs
+ *                        of processes and writes matrix of mean times.
+ *
+ * Pairs are scheduled by round-robin tournament (circle method): P - 1 rounds
+ * of P / 2 disjoint pairs, pairs of a round are measured concurrently,
+ * so total time is O(P). Option -U limits number of rounds by random sample.
+ * Process 0 is fixed in the circle, so it is a master in each round.
+ */
+int run_pt2ptbench_matrix(pt2ptbench_t *bench)
+{
+    double benchtime, time, *timematrix = NULL, *exectime = NULL;
+    int nplayers, nrounds, nsamples, round, i, nruns, ncorrectruns;
+    int *rounds, *senders, *receivers, color, key;
+    uint64_t seed = RNG_SEED;
+    pt2pttest_params_t params;
+    stat_sample_t *procstat, *recvstat, *onewaystat;
+
+    /* Last process is excluded if number of processes is odd */
+    nplayers = mpiperf_commsize - mpiperf_commsize % 2;
+    nrounds = nplayers - 1;
+
+    /* Random sample of rounds (the same in all processes) */
+    rounds = xmalloc(sizeof(*rounds) * nrounds);
+    for (i = 0; i < nrounds; i++)
+        rounds[i] = i;
+    nsamples = nrounds;
+    if (mpiperf_matrix_nrounds > 0 && mpiperf_matrix_nrounds < nrounds) {
+        nsamples = mpiperf_matrix_nrounds;
+        rng_shuffle(&seed, rounds, nrounds);
+    }
+    senders = xmalloc(sizeof(*senders) * nplayers / 2);
+    receivers = xmalloc(sizeof(*receivers) * nplayers / 2);
+
+    /* Concurrent pairs in each round are placed as i <-> i + npairs */
+    mpiperf_pt2pt_pairing = PAIRING_SPLIT;
+
+    benchtime = hpctimer_wtime();
+    timeslot_initialize();
+
+    report_write_header();
+    report_write_pt2ptbench_header(bench);
+    if (IS_MASTER_RANK) {
+        printf("# Matrix of pairs: %d processes, %d of %d rounds\n",
+               nplayers, nsamples, nrounds);
+        fprintf(mpiperf_matrixstream, "# Benchmark: %s\n", bench->name);
+        fprintf(mpiperf_matrixstream, "# Processes: %d, rounds: %d of %d\n",
+                nplayers, nsamples, nrounds);
+        if (nplayers < mpiperf_commsize) {
+            fprintf(mpiperf_matrixstream, "# Process %d is excluded (odd number of processes)\n",
+                    mpiperf_commsize - 1);
+        }
+        timematrix = xmalloc(sizeof(*timematrix) * nplayers * nplayers);
+    }
+
+    /* For each data size (count) */
+    for (params.count = mpiperf_count_min;
+         params.count <= mpiperf_count_max; )
+    {
+        if (IS_MASTER_RANK) {
+            for (i = 0; i < nplayers * nplayers; i++)
+                timematrix[i] = -1.0;
+            for (i = 0; i < nplayers; i++)
+                timematrix[i * nplayers + i] = 0.0;
+        }
+
+        for (round = 0; round < nsamples; round++) {
+            pt2ptbench_matrix_round(nplayers, rounds[round], senders, receivers);
+            params.npairs = nplayers / 2;
+            params.nprocs = nplayers;
+
+            /* Sender of pair i gets rank i, receiver gets rank i + npairs */
+            color = MPI_UNDEFINED;
+            key = 0;
+            for (i = 0; i < params.npairs; i++) {
+                if (senders[i] == mpiperf_rank) {
+                    color = 0;
+                    key = i;
+                } else if (receivers[i] == mpiperf_rank) {
+                    color = 0;
+                    key = i + params.npairs;
+                }
+            }
+            MPI_Comm_split(MPI_COMM_WORLD, color, key, &params.comm);
+
+            MPI_Barrier(MPI_COMM_WORLD);
+            logger_log("Test (round = %d, count = %d) is started",
+                       rounds[round], params.count);
+
+            if (params.comm != MPI_COMM_NULL) {
+                procstat = stat_sample_create();
+                recvstat = NULL;
+                onewaystat = NULL;
+                if (mpiperf_pt2pt_bothsided && IS_MASTER_RANK) {
+                    recvstat = stat_sample_create();
+                    onewaystat = stat_sample_create();
+                }
+                if (mpiperf_synctype == SYNC_TIME) {
+                    run_pt2ptbench_test_synctime(bench, &params, &exectime,
+                                                 &nruns, &ncorrectruns,
+                                                 procstat, recvstat,
+                                                 onewaystat);
+                    report_write_pt2pttest_synctime(bench, &params, exectime,
+                                                    nruns, ncorrectruns,
+                                                    recvstat, onewaystat);
+                } else {
+                    run_pt2ptbench_test_nosync(bench, &params, &time, &nruns,
+                                               procstat);
+                    report_write_pt2pttest_nosync(bench, &params, time, nruns);
+                }
+                pt2ptbench_gather_pairs(&params, procstat, senders, receivers,
+                                        timematrix, nplayers);
+                stat_sample_free(procstat);
+                if (recvstat) {
+                    stat_sample_free(recvstat);
+                    stat_sample_free(onewaystat);
+                }
+                free(exectime);
+                exectime = NULL;
+                MPI_Comm_free(&params.comm);
+            }
+        }
+        if (IS_MASTER_RANK)
+            report_write_pt2ptbench_matrix(&params, timematrix, nplayers);
+
+        if (mpiperf_count_step_type == STEP_TYPE_MUL) {
+            params.count *= mpiperf_count_step;
+        } else {
+            params.count += mpiperf_count_step;
+        }
+    }
+
+    free(timematrix);
+    free(receivers);
+    free(senders);
+    free(rounds);
+
+    timeslot_finalize();
+    MPI_Barrier(MPI_COMM_WORLD);
+    benchtime = hpctimer_wtime() - benchtime;
+    if (IS_MASTER_RANK) {
+        report_printf("# Elapsed time: %.6f sec.\n", benchtime);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * pt2ptbench_matrix_round: Returns pairs of round by circle method.
+ *                          Process 0 is fixed, others rotate.
+ */
+static void pt2ptbench_matrix_round(int nplayers, int round, int *senders,
+                                    int *receivers)
+{
+    int k, a, b, n = nplayers - 1;
+
+    senders[0] = 0;
+    receivers[0] = 1 + round;
+    for (k = 1; k < nplayers / 2; k++) {
+        a = 1 + (round + k) % n;
+        b = 1 + (round - k + n) % n;
+        senders[k] = (a < b) ? a : b;
+        receivers[k] = (a < b) ? b : a;
+    }
+}
+
+/*
+ * pt2ptbench_gather_pairs: Gathers mean time of senders to master and
+ *                          stores it in the matrix (both directions).
+ */
+int pt2ptbench_gather_pairs(pt2pttest_params_t *params,
+                            stat_sample_t *procstat, int *senders,
+                            int *receivers, double *timematrix, int nplayers)
+{
+    double mean, *allmean = NULL;
+    int i;
+
+    if (IS_MASTER_RANK)
+        allmean = xmalloc(sizeof(*allmean) * params->nprocs);
+
+    mean = (stat_sample_size(procstat) > 0) ? stat_sample_mean(procstat) : -1.0;
+    MPI_Gather(&mean, 1, MPI_DOUBLE, allmean, 1, MPI_DOUBLE,
+               mpiperf_master_rank, params->comm);
+
+    if (IS_MASTER_RANK) {
+        /* Sender of pair i has rank i in communicator of round */
+        for (i = 0; i < params->npairs; i++) {
+            timematrix[senders[i] * nplayers + receivers[i]] = allmean[i];
+            timematrix[receivers[i] * nplayers + senders[i]] = allmean[i];
+        }
+        free(allmean);
+    }
+    return MPIPERF_SUCCESS;
+}
+
 /*
  * run_pt2ptbench_test: Measures execution time of the point-to-point operation
  *                      for given parameters (data size, nprocs).
@@ -81,7 +307,9 @@ int run_pt2ptbench(pt2ptbench_t *bench)
 int run_pt2ptbench_test(pt2ptbench_t *bench, pt2pttest_params_t *params)
 {
     int nruns, ncorrectruns;
-    double *exectime = NULL;
+    double time, *exectime = NULL;
+    stat_sample_t *procstat = NULL;
+    stat_sample_t *recvstat = NULL, *onewaystat = NULL;
 
     MPI_Barrier(MPI_COMM_WORLD);
     logger_log("Test (nprocs = %d, count = %d) is started",
@@ -89,10 +317,31 @@ int run_pt2ptbench_test(pt2ptbench_t *bench, pt2pttest_params_t *params)
 
     if (params->comm != MPI_COMM_NULL) {
         /* This process participates in measures */
-        run_pt2ptbench_test_synctime(bench, params, &exectime, &nruns,
-                                     &ncorrectruns);
-        report_write_pt2pttest_synctime(bench, params, exectime, nruns,
-                                        ncorrectruns);
+        if (mpiperf_perprocreport && params->npairs > 1)
+            procstat = stat_sample_create();
+        if (mpiperf_pt2pt_bothsided && IS_MASTER_RANK) {
+            recvstat = stat_sample_create();
+            onewaystat = stat_sample_create();
+        }
+
+        if (mpiperf_synctype == SYNC_TIME) {
+            run_pt2ptbench_test_synctime(bench, params, &exectime, &nruns,
+                                         &ncorrectruns, procstat, recvstat,
+                                         onewaystat);
+            report_write_pt2pttest_synctime(bench, params, exectime, nruns,
+                                            ncorrectruns, recvstat, onewaystat);
+        } else {
+            run_pt2ptbench_test_nosync(bench, params, &time, &nruns, procstat);
+            report_write_pt2pttest_nosync(bench, params, time, nruns);
+        }
+        if (procstat) {
+            report_write_pt2ptbench_pairstat(bench, params, procstat);
+            stat_sample_free(procstat);
+        }
+        if (recvstat) {
+            stat_sample_free(recvstat);
+            stat_sample_free(onewaystat);
+        }
         free(exectime);
     }
     return MPIPERF_SUCCESS;
@@ -102,13 +351,20 @@ int run_pt2ptbench_test(pt2ptbench_t *bench, pt2pttest_params_t *params)
  * run_pt2ptbench_test_synctime: Measures execution time of point-to-point
  *                               operation for given parameters.
  * Exectution time of point-to-point operation is a time of master process.
+ * If several pairs communicate concurrently, the time of run is a time of
+ * the slowest process.
+ * In both-sided mode (-B) master collects time of the receiver of pair 0
+ * (recvstat) and one-way latency (onewaystat) by the global clock.
  */
 int run_pt2ptbench_test_synctime(pt2ptbench_t *bench, pt2pttest_params_t *params,
                                  double **exectime, int *nmeasurements,
-                                 int *ncorrect_measurements)
+                                 int *ncorrect_measurements,
+                                 stat_sample_t *procstat,
+                                 stat_sample_t *recvstat,
+                                 stat_sample_t *onewaystat)
 {
     int i, stage, stage_nruns, nruns, ncorrectruns, exectime_size, nerrors;
-    double *stage_exectime = NULL;
+    double *stage_exectime = NULL, *stagetimestamps = NULL;
     int *stagerc = NULL;
     double stagetime, stagetime_max, slotlen;
     stat_sample_t *timestat = NULL;
@@ -128,7 +384,15 @@ int run_pt2ptbench_test_synctime(pt2ptbench_t *bench, pt2pttest_params_t *params
     stage_exectime = xrealloc(stage_exectime, sizeof(*stage_exectime) *
                               TEST_STAGE_NRUNS);
     stagerc = xrealloc(stagerc, sizeof(*stagerc) * TEST_STAGE_NRUNS);
+    if (mpiperf_pt2pt_bothsided) {
+        /* Global timestamps of start and stop of each run */
+        stagetimestamps = xmalloc(sizeof(*stagetimestamps) * 2 *
+                                  TEST_STAGE_NRUNS);
+    }
 
+    /* Benchmark init function may override this */
+    params->nmsgs = 1;
+    params->msgsize = params->count;
     if (bench->init)
         bench->init(params);
 
@@ -150,6 +414,10 @@ int run_pt2ptbench_test_synctime(pt2ptbench_t *bench, pt2pttest_params_t *params
 
         for (i = 0; i < stage_nruns; i++) {
             stagerc[i] = bench->op(params, &stage_exectime[i]);
+            if (stagetimestamps) {
+                stagetimestamps[2 * i] = timeslot_last_starttime();
+                stagetimestamps[2 * i + 1] = timeslot_last_stoptime();
+            }
         }
 
         stagetime = hpctimer_wtime() - stagetime;
@@ -168,6 +436,29 @@ int run_pt2ptbench_test_synctime(pt2ptbench_t *bench, pt2pttest_params_t *params
         }
         nruns += stage_nruns;
 
+        if (stagetimestamps) {
+            pt2ptbench_bothsided_stage(params, stage_nruns, stagerc,
+                                       stage_exectime, stagetimestamps,
+                                       recvstat, onewaystat);
+        }
+
+        if (params->npairs > 1) {
+            /* Gather err. codes of all pairs */
+            MPI_Allreduce(MPI_IN_PLACE, stagerc, stage_nruns, MPI_INT,
+                          MPI_MAX, params->comm);
+        }
+        if (procstat) {
+            /* Time of own pair (before reduction) */
+            for (i = 0; i < stage_nruns; i++) {
+                if (stagerc[i] == MEASURE_SUCCESS)
+                    stat_sample_add(procstat, stage_exectime[i]);
+            }
+        }
+        if (params->npairs > 1) {
+            MPI_Allreduce(MPI_IN_PLACE, stage_exectime, stage_nruns,
+                          MPI_DOUBLE, MPI_MAX, params->comm);
+        }
+
         if (IS_MASTER_RANK) {
             /* Allocate memory for stage results */
             if (exectime_size < (ncorrectruns + stage_nruns)) {
@@ -211,6 +502,9 @@ int run_pt2ptbench_test_synctime(pt2ptbench_t *bench, pt2pttest_params_t *params
                 {
                     breakflag = 1;
                 }
+            } else if (nruns >= mpiperf_nruns_max) {
+                /* Bootstrap CI of median is computed for collectives only */
+                breakflag = 1;
             }
         } /* master */
 
@@ -242,6 +536,7 @@ int run_pt2ptbench_test_synctime(pt2ptbench_t *bench, pt2pttest_params_t *params
 
     free(stage_exectime);
     free(stagerc);
+    free(stagetimestamps);
 
     if (IS_MASTER_RANK)
         stat_sample_free(timestat);
@@ -249,6 +544,62 @@ int run_pt2ptbench_test_synctime(pt2ptbench_t *bench, pt2pttest_params_t *params
     return MPIPERF_SUCCESS;
 }
 
+/* pt2ptbench_pair: */
+void pt2ptbench_pair(pt2pttest_params_t *params, int pair, int *sender,
+                     int *receiver)
+{
+    if (mpiperf_pt2pt_pairing == PAIRING_ADJACENT) {
+        *sender = 2 * pair;
+        *receiver = 2 * pair + 1;
+    } else {
+        *sender = pair;
+        *receiver = pair + params->npairs;
+    }
+}
+
+/* pt2ptbench_peer: */
+int pt2ptbench_peer(pt2pttest_params_t *params, int rank, int *issender)
+{
+    if (mpiperf_pt2pt_pairing == PAIRING_ADJACENT) {
+        *issender = (rank % 2 == 0);
+        return *issender ? rank + 1 : rank - 1;
+    }
+    *issender = (rank < params->npairs);
+    return *issender ? rank + params->npairs : rank - params->npairs;
+}
+
+/*
+ * pt2ptbench_parse_pairs: Parses string <n>[:split|:adjacent].
+ *                         Value 0 or "all" means all processes.
+ */
+int pt2ptbench_parse_pairs(const char *s, int *npairs, int *pairing)
+{
+    char *p;
+    long n;
+
+    if (strncasecmp(s, "all", 3) == 0) {
+        *npairs = 0;
+        p = (char *)s + 3;
+    } else {
+        n = strtol(s, &p, 10);
+        if (p == s || n < 0 || n > INT_MAX)
+            return MPIPERF_FAILURE;
+        *npairs = (int)n;
+    }
+
+    *pairing = PAIRING_SPLIT;
+    if (*p == ':') {
+        if (strcasecmp(p + 1, "adjacent") == 0) {
+            *pairing = PAIRING_ADJACENT;
+        } else if (strcasecmp(p + 1, "split") != 0) {
+            return MPIPERF_FAILURE;
+        }
+    } else if (*p != '\0') {
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
 void print_pt2ptbench_info()
 {
     int i;
@@ -273,6 +624,114 @@ pt2ptbench_t *lookup_pt2ptbench(const char *name)
     return NULL;
 }
 
+/*
+ * run_pt2ptbench_test_nosync: Measures execution time of point-to-point
+ *                             operation for given parameters.
+ *
+ * This test implements pipelined measurements (without synchronization
+ * of runs): operation is executed back-to-back mpiperf_nruns_max times.
+ * Latency benchmarks run ping-pong instead (like OSU and IMB PingPong),
+ * time of run is a half of round trip: back-to-back sends are pipelined
+ * by eager protocol and would give injection rate instead of latency.
+ * Time of run is a mean time of the slowest process.
+ */
+int run_pt2ptbench_test_nosync(pt2ptbench_t *bench, pt2pttest_params_t *params,
+                               double *exectime, int *nmeasurements,
+                               stat_sample_t *procstat)
+{
+    pt2ptbench_op_ptr_t op;
+    double t, time;
+    int i;
+
+    /* Benchmark init function may override this */
+    params->nmsgs = 1;
+    params->msgsize = params->count;
+    if (bench->init)
+        bench->init(params);
+
+    op = (bench->pingpong) ? bench->pingpong : bench->op;
+
+    /* Warmup */
+    op(params, &time);
+    MPI_Barrier(params->comm);
+
+    /* Run measurements */
+    mpiperf_is_measure_started = 1;
+    t = hpctimer_wtime();
+    for (i = 0; i < mpiperf_nruns_max; i++) {
+        op(params, &time);
+    }
+    t = (hpctimer_wtime() - t) / mpiperf_nruns_max;
+    mpiperf_is_measure_started = 0;
+    if (bench->pingpong)
+        t /= 2.0;
+
+    MPI_Allreduce(&t, exectime, 1, MPI_DOUBLE, MPI_MAX, params->comm);
+
+    if (procstat)
+        stat_sample_add(procstat, t);
+
+    *nmeasurements = mpiperf_nruns_max;
+
+    if (bench->free)
+        bench->free();
+
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * pt2ptbench_bothsided_stage: Receiver of pair 0 sends results of stage
+ *                             to master. Master adds time of receiver and
+ *                             one-way latency (stop of receiver - start of
+ *                             master by the global clock) of correct runs.
+ * Run is correct if it is correct on both processes, so master marks runs
+ * failed by receiver as invalid (timeslot length is corrected by them).
+ */
+static void pt2ptbench_bothsided_stage(pt2pttest_params_t *params,
+                                       int stage_nruns, int *stagerc,
+                                       double *stage_exectime,
+                                       double *stagetimestamps,
+                                       stat_sample_t *recvstat,
+                                       stat_sample_t *onewaystat)
+{
+    int i, rank, sender, receiver;
+    double *buf, offset;
+
+    pt2ptbench_pair(params, 0, &sender, &receiver);
+    MPI_Comm_rank(params->comm, &rank);
+    if (rank != sender && rank != receiver)
+        return;
+
+    /* Stage results: error code, time and global stop time of each run */
+    buf = xmalloc(sizeof(*buf) * 3 * stage_nruns);
+    offset = mpigclock_offset();
+    if (rank == receiver) {
+        for (i = 0; i < stage_nruns; i++) {
+            buf[3 * i] = (double)stagerc[i];
+            buf[3 * i + 1] = stage_exectime[i];
+            buf[3 * i + 2] = stagetimestamps[2 * i + 1] + offset;
+        }
+        MPI_Send(buf, 3 * stage_nruns, MPI_DOUBLE, sender, BOTHSIDED_TAG,
+                 params->comm);
+    } else {
+        MPI_Recv(buf, 3 * stage_nruns, MPI_DOUBLE, receiver, BOTHSIDED_TAG,
+                 params->comm, MPI_STATUS_IGNORE);
+        for (i = 0; i < stage_nruns; i++) {
+            if (stagerc[i] == MEASURE_SUCCESS)
+                stagerc[i] = (int)buf[3 * i];
+            if (stagerc[i] != MEASURE_SUCCESS)
+                continue;
+            if (recvstat)
+                stat_sample_add(recvstat, buf[3 * i + 1]);
+            if (onewaystat) {
+                stat_sample_add(onewaystat, buf[3 * i + 2] -
+                                (stagetimestamps[2 * i] + offset));
+            }
+        }
+    }
+    free(buf);
+}
+
 int report_write_pt2ptbench_header(pt2ptbench_t *bench)
 {
     if (IS_MASTER_RANK) {
@@ -287,21 +746,56 @@ int report_write_pt2ptbench_header(pt2ptbench_t *bench)
         printf("#   StdErr - standard error of the mean: StdDev / sqrt(FRuns)\n");
         printf("#   Min - minimal value\n");
         printf("#   Max - miximal value\n");
-        printf("#   CL - confidence level: 90%%, 95%% or 99%%\n");
+        printf("#   CL - confidence level (-C)\n");
         printf("#   Err - error of measurements: t_student * StdErr\n");
         printf("#   CI LB - lower bound of confidence interval: Mean - Err\n");
         printf("#   CI UB - upper bound of confidence interval: Mean + Err\n");
         printf("#   RelErr - relative error of measurements: Err / Mean\n");
+        printf("#   MB/s - aggregate bandwidth: Pairs * Msgs * MsgSize / Mean (10^6 bytes/sec)\n");
+        printf("#   Msg/s - aggregate message rate: Pairs * Msgs / Mean\n");
+        if (mpiperf_pt2pt_bothsided) {
+            printf("#   RecvMean - arithmetic mean of execution time of receiver of pair 0\n");
+            printf("#   OneWay - mean one-way latency: receiver stop - master start (global clock)\n");
+        }
         printf("#\n");
         printf("# ------------------------------------------------------------------\n");
-        printf("# %s time (time of the master process)\n", bench->name);
-        printf("# Confidence level (CL): %d%%\n", mpiperf_confidence_level);
+        if (mpiperf_pt2pt_npairs == 1 && !mpiperf_matrixreport) {
+            printf("# %s time (time of the master process)\n", bench->name);
+        } else {
+            printf("# %s time (time of the slowest process of concurrent pairs)\n",
+                   bench->name);
+        }
+        if (mpiperf_pt2pt_npairs != 1 && !mpiperf_matrixreport) {
+            printf("# Pairs: %d, placement: %s\n",
+                   mpiperf_pt2pt_npairs > 0 ? mpiperf_pt2pt_npairs :
+                   mpiperf_commsize / 2,
+                   mpiperf_pt2pt_pairing == PAIRING_ADJACENT ?
+                   "2i <-> 2i + 1" : "i <-> i + pairs");
+        }
+        printf("# Confidence level (CL): %g%%\n", mpiperf_confidence_level);
+        printf("# Window of outstanding messages (bandwidth benchmarks): %d\n",
+               mpiperf_pt2pt_window);
+        if (mpiperf_synctype == SYNC_NONE) {
+            printf("# Pipelined measurements\n");
+            if (bench->pingpong) {
+                printf("# Mean - half of round trip time of ping-pong\n");
+            } else {
+                printf("# Mean - time of operation executed back-to-back\n");
+            }
+            printf("# ------------------------------------------------------------------\n");
+            printf("# [Procs] [Count]     [TRuns] [Mean]%s [MB/s]       [Msg/s]\n",
+                   (mpiperf_timescale == TIMESCALE_SEC) ? "      " : "        ");
+            printf("#\n");
+            return MPIPERF_SUCCESS;
+        }
         printf("# ------------------------------------------------------------------\n");
         if (mpiperf_timescale == TIMESCALE_SEC) {
-            printf("# [Procs] [Count]     [TRuns] [CRuns] [FRuns] [Mean]       [RSE]      [StdErr]     [Min]        [Max]        [Err]        [CI LB]      [CI UB]      [RelErr]\n");
+            printf("# [Procs] [Count]     [TRuns] [CRuns] [FRuns] [Mean]       [RSE]      [StdErr]     [Min]        [Max]        [Err]        [CI LB]      [CI UB]      [RelErr]     [MB/s]       [Msg/s]%s\n",
+                   mpiperf_pt2pt_bothsided ? "      [RecvMean]   [OneWay]" : "");
         } else {
             /* usec */
-            printf("# [Procs] [Count]     [TRuns] [CRuns] [FRuns] [Mean]         [RSE]      [StdErr]       [Min]          [Max]          [Err]          [CI LB]        [CI UB]        [RelErr]\n");
+            printf("# [Procs] [Count]     [TRuns] [CRuns] [FRuns] [Mean]         [RSE]      [StdErr]       [Min]          [Max]          [Err]          [CI LB]        [CI UB]        [RelErr]     [MB/s]       [Msg/s]%s\n",
+                   mpiperf_pt2pt_bothsided ? "      [RecvMean]     [OneWay]" : "");
         }
         printf("#\n");
     }
@@ -311,14 +805,16 @@ int report_write_pt2ptbench_header(pt2ptbench_t *bench)
 int report_write_pt2pttest_synctime(pt2ptbench_t *bench,
                                     pt2pttest_params_t *params,
                                     double *exectime, int nruns,
-                                    int ncorrectruns)
+                                    int ncorrectruns, stat_sample_t *recvstat,
+                                    stat_sample_t *onewaystat)
 {
     double exectime_mean, exectime_stderr, exectime_rse, exectime_min,
            exectime_max, exectime_errrel;
     double exectime_ci_lb = 0.0, exectime_ci_ub = 0.0, exectime_err = 0.0;
+    double bandwidth, msgrate, recvtime_mean, oneway_mean;
     int nresultruns = 0;
     stat_sample_t *sample;
-    const char *fmt = NULL;
+    const char *fmt = NULL, *bothsided_fmt = NULL;
     double timescale;
 
     if (!IS_MASTER_RANK) {
@@ -327,43 +823,60 @@ int report_write_pt2pttest_synctime(pt2ptbench_t *bench,
 
     if (mpiperf_timescale == TIMESCALE_SEC) {
         fmt = "  %-7d %-11d %-7d %-7d %-7d %-12.6f %-10.2f %-12.6f %-12.6f "
-              "%-12.6f %-12.6f %-12.6f %-12.6f %-10.2f\n";
+              "%-12.6f %-12.6f %-12.6f %-12.6f %-12.2f %-12.2f %-12.2f";
+        bothsided_fmt = " %-12.6f %-12.6f\n";
         timescale = 1.0;
     } else {
         /* usec */
         fmt = "  %-7d %-11d %-7d %-7d %-7d %-14.2f %-10.2f %-14.2f %-14.2f "
-            "%-14.2f %-14.2f %-14.2f %-14.2f %-10.2f\n";
+            "%-14.2f %-14.2f %-14.2f %-14.2f %-12.2f %-12.2f %-12.2f";
+        bothsided_fmt = " %-14.2f %-14.2f\n";
         timescale = 1E6;
     }
 
+    /* Both-sided columns: means of receiver time and one-way latency */
+    recvtime_mean = 0.0;
+    oneway_mean = 0.0;
+    if (recvstat && stat_sample_size(recvstat) > 0) {
+        recvtime_mean = stat_sample_mean(recvstat) * timescale;
+        oneway_mean = stat_sample_mean(onewaystat) * timescale;
+    }
+    if (!recvstat)
+        bothsided_fmt = "\n";
+
     if (ncorrectruns == 0) {
         printf(fmt, params->nprocs, params->count, nruns, 0, 0, 0.0, 0.0,
-               0.0, 0, 0.0, 0.0, 0.0, 0.0, 0.0);
+               0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+        printf(bothsided_fmt, recvtime_mean, oneway_mean);
         return MPIPERF_SUCCESS;
     }
 
     /* Remove outliers */
     nresultruns = ncorrectruns;
     if (mpiperf_statanalysis) {
-        /* Remove 25% of minimal values and 25% of maximal values */
-        nresultruns = stat_dataset_remove_outliers(exectime,
-                                                   ncorrectruns,
-                                                   OUTLIERS_FILTER_MIN,
-                                                   OUTLIERS_FILTER_MAX);
+        nresultruns = stat_dataset_filter_outliers(exectime, ncorrectruns,
+                                                   &mpiperf_outliers);
     }
 
     if ( (sample = stat_sample_create()) == NULL)
         return MPIPERF_FAILURE;
 
     stat_sample_add_dataset(sample, exectime, nresultruns);
-    exectime_mean = stat_sample_mean(sample) * timescale;
+    exectime_mean = stat_sample_mean(sample);
+    bandwidth = 0.0;
+    msgrate = 0.0;
+    if (exectime_mean > 0.0) {
+        msgrate = (double)params->nmsgs * params->npairs / exectime_mean;
+        bandwidth = msgrate * params->msgsize / 1E6;
+    }
+    exectime_mean *= timescale;
     exectime_stderr = stat_sample_stderr(sample) * timescale;
     exectime_rse = stat_sample_stderr_rel(sample);
     exectime_min = stat_sample_min(sample) * timescale;
     exectime_max = stat_sample_max(sample) * timescale;
 
     /* Build confidence interval */
-    stat_sample_confidence_interval(sample, mpiperf_confidence_level_type,
+    stat_sample_confidence_interval(sample, mpiperf_confidence_level,
                                     &exectime_ci_lb, &exectime_ci_ub,
                                     &exectime_err);
     exectime_ci_lb *= timescale;
@@ -374,8 +887,160 @@ int report_write_pt2pttest_synctime(pt2ptbench_t *bench,
     printf(fmt, params->nprocs, params->count, nruns, ncorrectruns,
            nresultruns, exectime_mean, exectime_rse, exectime_stderr,
            exectime_min, exectime_max, exectime_err, exectime_ci_lb,
-           exectime_ci_ub, exectime_errrel);
+           exectime_ci_ub, exectime_errrel, bandwidth, msgrate);
+    printf(bothsided_fmt, recvtime_mean, oneway_mean);
 
     stat_sample_free(sample);
     return MPIPERF_SUCCESS;
 }
+
+int report_write_pt2pttest_nosync(pt2ptbench_t *bench,
+                                  pt2pttest_params_t *params,
+                                  double exectime, int nruns)
+{
+    double bandwidth, msgrate;
+    const char *fmt = NULL;
+    double timescale;
+
+    if (!IS_MASTER_RANK) {
+        return MPIPERF_SUCCESS;
+    }
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-7d %-12.6f %-12.2f %-12.2f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-7d %-14.2f %-12.2f %-12.2f\n";
+        timescale = 1E6;
+    }
+
+    bandwidth = 0.0;
+    msgrate = 0.0;
+    if (exectime > 0.0) {
+        msgrate = (double)params->nmsgs * params->npairs / exectime;
+        bandwidth = msgrate * params->msgsize / 1E6;
+    }
+    printf(fmt, params->nprocs, params->count, nruns, exectime * timescale,
+           bandwidth, msgrate);
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_pt2ptbench_pairstat_header(pt2ptbench_t *bench)
+{
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+    fprintf(mpiperf_repstream, "# Characteristics of measurements:\n");
+    fprintf(mpiperf_repstream, "#   Procs - total number of processes\n");
+    fprintf(mpiperf_repstream, "#   Count - count of elements in send/recv buffer\n");
+    fprintf(mpiperf_repstream, "#   Pair - number of pair\n");
+    fprintf(mpiperf_repstream, "#   Sender, Receiver - ranks of processes of pair\n");
+    fprintf(mpiperf_repstream, "#   CRuns - number of correct measurements (only valid runs)\n");
+    fprintf(mpiperf_repstream, "#   Mean - arithmetic mean of execution time of sender\n");
+    fprintf(mpiperf_repstream, "#   RecvMean - arithmetic mean of execution time of receiver\n");
+    fprintf(mpiperf_repstream, "#   MB/s - bandwidth of pair: Msgs * MsgSize / Mean (10^6 bytes/sec)\n");
+    fprintf(mpiperf_repstream, "#   Msg/s - message rate of pair: Msgs / Mean\n");
+    fprintf(mpiperf_repstream, "#\n");
+    fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
+    fprintf(mpiperf_repstream, "# Benchmark: %s \n", bench->name);
+    fprintf(mpiperf_repstream, "# ------------------------------------------------------------------\n");
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fprintf(mpiperf_repstream, "# [Procs] [Count]     [Pair]  [Sender] [Receiver] [CRuns] [Mean]       [RecvMean]   [MB/s]       [Msg/s]\n");
+    } else {
+        /* usec */
+        fprintf(mpiperf_repstream, "# [Procs] [Count]     [Pair]  [Sender] [Receiver] [CRuns] [Mean]         [RecvMean]     [MB/s]       [Msg/s]\n");
+    }
+    fprintf(mpiperf_repstream, "#\n");
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * report_write_pt2ptbench_pairstat: Writes rates of pairs to per process
+ *                                   report (called by all processes of comm).
+ */
+int report_write_pt2ptbench_pairstat(pt2ptbench_t *bench,
+                                     pt2pttest_params_t *params,
+                                     stat_sample_t *procstat)
+{
+    enum { NSTAT_PARAMS = 2 };
+    double statparams[NSTAT_PARAMS], *allstat = NULL;
+    double mean, recvmean, msgrate, timescale;
+    const char *fmt = NULL;
+    int pair, sender, receiver;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-7d %-8d %-10d %-7d %-12.6f %-12.6f %-12.2f %-12.2f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-7d %-8d %-10d %-7d %-14.2f %-14.2f %-12.2f %-12.2f\n";
+        timescale = 1E6;
+    }
+
+    if (IS_MASTER_RANK) {
+        allstat = xmalloc(sizeof(*allstat) * NSTAT_PARAMS * params->nprocs);
+    }
+    statparams[0] = stat_sample_mean(procstat);
+    statparams[1] = (double)stat_sample_size(procstat);
+    MPI_Gather(statparams, NSTAT_PARAMS, MPI_DOUBLE, allstat, NSTAT_PARAMS,
+               MPI_DOUBLE, mpiperf_master_rank, params->comm);
+
+    if (IS_MASTER_RANK) {
+        for (pair = 0; pair < params->npairs; pair++) {
+            pt2ptbench_pair(params, pair, &sender, &receiver);
+            mean = allstat[sender * NSTAT_PARAMS];
+            recvmean = allstat[receiver * NSTAT_PARAMS];
+            msgrate = (mean > 0.0) ? params->nmsgs / mean : 0.0;
+            fprintf(mpiperf_repstream, fmt, params->nprocs, params->count,
+                    pair, sender, receiver,
+                    (int)allstat[sender * NSTAT_PARAMS + 1],
+                    mean * timescale, recvmean * timescale,
+                    msgrate * params->msgsize / 1E6, msgrate);
+        }
+        free(allstat);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * report_write_pt2ptbench_matrix: Writes matrix of mean times and matrix
+ *                                 of bandwidths to the matrix file.
+ */
+static void report_write_pt2ptbench_matrix(pt2pttest_params_t *params,
+                                           double *timematrix, int nplayers)
+{
+    double timescale, t;
+    int i, j;
+
+    timescale = (mpiperf_timescale == TIMESCALE_SEC) ? 1.0 : 1E6;
+
+    fprintf(mpiperf_matrixstream, "#\n# Count: %d\n", params->count);
+    fprintf(mpiperf_matrixstream, "# Mean time of pairs (%s), '-' - not measured\n",
+            (mpiperf_timescale == TIMESCALE_SEC) ? "sec" : "usec");
+    for (i = 0; i < nplayers; i++) {
+        for (j = 0; j < nplayers; j++) {
+            t = timematrix[i * nplayers + j];
+            if (t < 0.0) {
+                fprintf(mpiperf_matrixstream, " %12s", "-");
+            } else {
+                fprintf(mpiperf_matrixstream, " %12.6f", t * timescale);
+            }
+        }
+        fprintf(mpiperf_matrixstream, "\n");
+    }
+
+    fprintf(mpiperf_matrixstream, "# Bandwidth of pairs (MB/s): Msgs * MsgSize / Mean\n");
+    for (i = 0; i < nplayers; i++) {
+        for (j = 0; j < nplayers; j++) {
+            t = timematrix[i * nplayers + j];
+            if (t <= 0.0) {
+                fprintf(mpiperf_matrixstream, " %12s", "-");
+            } else {
+                fprintf(mpiperf_matrixstream, " %12.2f",
+                        (double)params->nmsgs * params->msgsize / t / 1E6);
+            }
+        }
+        fprintf(mpiperf_matrixstream, "\n");
+    }
+    fflush(mpiperf_matrixstream);
+}
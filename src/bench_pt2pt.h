@@ -11,11 +11,20 @@
 
 #include "stat.h"
 
+/* Placement of pairs (option -N) */
+enum PairingType {
+    PAIRING_SPLIT = 0,      /* Process i <-> i + npairs */
+    PAIRING_ADJACENT = 1    /* Process 2i <-> 2i + 1 */
+};
+
 /* Test parameters */
 typedef struct {
     MPI_Comm comm;
     int nprocs;
     int count;
+    int npairs;     /* Number of concurrently communicating pairs */
+    int nmsgs;      /* Messages transferred by master per measurement */
+    int msgsize;    /* Size of message in bytes (for bandwidth) */
 } pt2pttest_params_t;
 
 typedef int (*pt2ptbench_init_ptr_t)(pt2pttest_params_t *params);
@@ -30,6 +39,8 @@ typedef struct {
     pt2ptbench_free_ptr_t free;            /* Called after measures */
     pt2ptbench_printinfo_ptr_t printinfo;
     pt2ptbench_op_ptr_t op;                /* Pointer to measure function */
+    pt2ptbench_op_ptr_t pingpong;          /* Round trip for nosync mode
+                                              (NULL - op is run back-to-back) */
 } pt2ptbench_t;
 
 
@@ -38,13 +49,45 @@ pt2ptbench_t *lookup_pt2ptbench(const char *name);
 
 int run_pt2ptbench(pt2ptbench_t *bench);
 int run_pt2ptbench_test(pt2ptbench_t *bench, pt2pttest_params_t *params);
+int run_pt2ptbench_matrix(pt2ptbench_t *bench);
+int pt2ptbench_gather_pairs(pt2pttest_params_t *params,
+                            stat_sample_t *procstat, int *senders,
+                            int *receivers, double *timematrix, int nplayers);
 int run_pt2ptbench_test_synctime(pt2ptbench_t *bench,
                                  pt2pttest_params_t *params, double **exectime,
-                                 int *nmeasurements, int *ncorrect_measurements);
+                                 int *nmeasurements, int *ncorrect_measurements,
+                                 stat_sample_t *procstat,
+                                 stat_sample_t *recvstat,
+                                 stat_sample_t *onewaystat);
+int run_pt2ptbench_test_nosync(pt2ptbench_t *bench, pt2pttest_params_t *params,
+                               double *exectime, int *nmeasurements,
+                               stat_sample_t *procstat);
+
+/*
+ * pt2ptbench_pair: Returns ranks of sender and receiver of pair
+ *                  (pair 0 is always 0 <-> 1).
+ */
+void pt2ptbench_pair(pt2pttest_params_t *params, int pair, int *sender,
+                     int *receiver);
+
+/* pt2ptbench_peer: Returns peer of process and sets issender. */
+int pt2ptbench_peer(pt2pttest_params_t *params, int rank, int *issender);
+
+int pt2ptbench_parse_pairs(const char *s, int *npairs, int *pairing);
 
 int report_write_pt2ptbench_header(pt2ptbench_t *bench);
 int report_write_pt2pttest_synctime(pt2ptbench_t *bench,
                                     pt2pttest_params_t *params,
                                     double *exectime, int nruns,
-                                    int ncorrectruns);
+                                    int ncorrectruns, stat_sample_t *recvstat,
+                                    stat_sample_t *onewaystat);
+
+int report_write_pt2pttest_nosync(pt2ptbench_t *bench,
+                                  pt2pttest_params_t *params,
+                                  double exectime, int nruns);
+
+int report_write_pt2ptbench_pairstat_header(pt2ptbench_t *bench);
+int report_write_pt2ptbench_pairstat(pt2ptbench_t *bench,
+                                     pt2pttest_params_t *params,
+                                     stat_sample_t *procstat);
 #endif /* BENCH_PT2PT_H */
@@ -7,6 +7,8 @@
 #ifndef BENCH_PT2PT_TAB_H
 #define BENCH_PT2PT_TAB_H
 
+#include "pt2pt/bandwidth.h"
+#include "pt2pt/bibandwidth.h"
 #include "pt2pt/send.h"
 #include "pt2pt/sendrecv.h"
 
@@ -16,7 +18,8 @@ pt2ptbench_t pt2ptbenchtab[] = {
       (pt2ptbench_init_ptr_t)bench_send_init,
       (pt2ptbench_free_ptr_t)bench_send_free,
       (pt2ptbench_printinfo_ptr_t)bench_send_printinfo,
-      (pt2ptbench_op_ptr_t)measure_send_sync
+      (pt2ptbench_op_ptr_t)measure_send_sync,
+      (pt2ptbench_op_ptr_t)measure_send_pingpong
     },
     {
       "Sendrecv",
@@ -24,6 +27,20 @@ pt2ptbench_t pt2ptbenchtab[] = {
       (pt2ptbench_free_ptr_t)bench_sendrecv_free,
       (pt2ptbench_printinfo_ptr_t)bench_sendrecv_printinfo,
       (pt2ptbench_op_ptr_t)measure_sendrecv_sync
+    },
+    {
+      "Bandwidth",
+      (pt2ptbench_init_ptr_t)bench_bandwidth_init,
+      (pt2ptbench_free_ptr_t)bench_bandwidth_free,
+      (pt2ptbench_printinfo_ptr_t)bench_bandwidth_printinfo,
+      (pt2ptbench_op_ptr_t)measure_bandwidth_sync
+    },
+    {
+      "BiBandwidth",
+      (pt2ptbench_init_ptr_t)bench_bibandwidth_init,
+      (pt2ptbench_free_ptr_t)bench_bibandwidth_free,
+      (pt2ptbench_printinfo_ptr_t)bench_bibandwidth_printinfo,
+      (pt2ptbench_op_ptr_t)measure_bibandwidth_sync
     }
 };
 
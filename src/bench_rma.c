@@ -0,0 +1,206 @@
+/*
+ * bench_rma.c: Functions for benchmarking MPI one-sided (RMA) routines.
+ *
+ * RMA benchmarks are executed by the point-to-point driver on two
+ * processes: process 0 is origin and process 1 is target. The time of
+ * an access epoch (synchronization + operation) on origin is measured.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include <mpi.h>
+
+#include "bench_rma.h"
+#include "bench_pt2pt.h"
+#include "mpiperf.h"
+#include "util.h"
+#include "bench_rma_tab.h"
+
+enum {
+    RMA_ORIGIN = 0,
+    RMA_TARGET = 1,
+    RMA_RELEASE_TAG = 1
+};
+
+static int rmabench_sync = RMASYNC_FENCE;
+static MPI_Win win = MPI_WIN_NULL;
+static MPI_Group peergroup = MPI_GROUP_NULL;
+static MPI_Comm comm = MPI_COMM_NULL;
+static int rank;
+
+/* run_rmabench: Runs benchmark for one-sided operation. */
+int run_rmabench(rmabench_t *bench)
+{
+    if (mpiperf_pt2pt_npairs != 1 || mpiperf_matrixreport) {
+        exit_error("RMA benchmarks support only one pair of processes (-N 1)");
+    }
+    rmabench_sync = bench->sync;
+    return run_pt2ptbench(&bench->pt2pt);
+}
+
+/* rmabench_win_create: */
+int rmabench_win_create(pt2pttest_params_t *params, int size, int dispunit)
+{
+#ifdef HAVE_RMA
+    MPI_Group group;
+    void *base;
+    int peer;
+
+    comm = params->comm;
+    MPI_Comm_rank(comm, &rank);
+    if (MPI_Win_allocate(size, dispunit, MPI_INFO_NULL, params->comm, &base,
+                         &win) != MPI_SUCCESS)
+    {
+        win = MPI_WIN_NULL;
+        return MPIPERF_FAILURE;
+    }
+
+    if (rmabench_sync == RMASYNC_PSCW) {
+        peer = (rank == RMA_ORIGIN) ? RMA_TARGET : RMA_ORIGIN;
+        MPI_Comm_group(params->comm, &group);
+        MPI_Group_incl(group, 1, &peer, &peergroup);
+        MPI_Group_free(&group);
+    } else if (rmabench_sync == RMASYNC_LOCKALL && rank == RMA_ORIGIN) {
+        MPI_Win_lock_all(0, win);
+    }
+    return MPIPERF_SUCCESS;
+#else
+    return MPIPERF_FAILURE;
+#endif
+}
+
+/* rmabench_win_free: */
+void rmabench_win_free()
+{
+#ifdef HAVE_RMA
+    if (win == MPI_WIN_NULL)
+        return;
+    if (rmabench_sync == RMASYNC_LOCKALL && rank == RMA_ORIGIN) {
+        MPI_Win_unlock_all(win);
+    }
+    if (peergroup != MPI_GROUP_NULL)
+        MPI_Group_free(&peergroup);
+    MPI_Win_free(&win);
+    comm = MPI_COMM_NULL;
+#endif
+}
+
+/* rmabench_win: */
+MPI_Win rmabench_win()
+{
+    return win;
+}
+
+/* rmabench_isorigin: */
+int rmabench_isorigin()
+{
+    return rank == RMA_ORIGIN;
+}
+
+/* rmabench_epoch_begin: Opens access (origin) or exposure (target) epoch. */
+int rmabench_epoch_begin()
+{
+#ifdef HAVE_RMA
+    switch (rmabench_sync) {
+    case RMASYNC_FENCE:
+        return MPI_Win_fence(0, win);
+    case RMASYNC_PSCW:
+        if (rank == RMA_ORIGIN)
+            return MPI_Win_start(peergroup, 0, win);
+        return MPI_Win_post(peergroup, 0, win);
+    case RMASYNC_LOCK:
+        if (rank == RMA_ORIGIN)
+            return MPI_Win_lock(MPI_LOCK_SHARED, RMA_TARGET, 0, win);
+        return MPI_SUCCESS;
+    case RMASYNC_LOCKALL:
+        return MPI_SUCCESS;
+    }
+#endif
+    return MPI_ERR_OTHER;
+}
+
+/* rmabench_epoch_end: Completes epoch (operations of origin are completed). */
+int rmabench_epoch_end()
+{
+#ifdef HAVE_RMA
+    switch (rmabench_sync) {
+    case RMASYNC_FENCE:
+        return MPI_Win_fence(0, win);
+    case RMASYNC_PSCW:
+        if (rank == RMA_ORIGIN)
+            return MPI_Win_complete(win);
+        return MPI_Win_wait(win);
+    case RMASYNC_LOCK:
+        if (rank == RMA_ORIGIN)
+            return MPI_Win_unlock(RMA_TARGET, win);
+        break;
+    case RMASYNC_LOCKALL:
+        if (rank == RMA_ORIGIN)
+            return MPI_Win_flush(RMA_TARGET, win);
+        break;
+    default:
+        return MPI_ERR_OTHER;
+    }
+    /* Passive target: wait for release in progress engine */
+    return MPI_Recv(NULL, 0, MPI_BYTE, RMA_ORIGIN, RMA_RELEASE_TAG, comm,
+                    MPI_STATUS_IGNORE);
+#else
+    return MPI_ERR_OTHER;
+#endif
+}
+
+/*
+ * rmabench_epoch_release: Releases passive target (called by origin
+ *                         after the time measurement).
+ */
+int rmabench_epoch_release()
+{
+    if (rank == RMA_ORIGIN && (rmabench_sync == RMASYNC_LOCK ||
+                               rmabench_sync == RMASYNC_LOCKALL))
+    {
+        return MPI_Send(NULL, 0, MPI_BYTE, RMA_TARGET, RMA_RELEASE_TAG, comm);
+    }
+    return MPI_SUCCESS;
+}
+
+/* rmabench_syncname: */
+const char *rmabench_syncname(int sync)
+{
+    switch (sync) {
+    case RMASYNC_PSCW:
+        return "MPI_Win_post/start/complete/wait";
+    case RMASYNC_LOCK:
+        return "MPI_Win_lock/unlock (shared)";
+    case RMASYNC_LOCKALL:
+        return "MPI_Win_lock_all + MPI_Win_flush";
+    }
+    return "MPI_Win_fence";
+}
+
+void print_rmabench_info()
+{
+    int i;
+
+    printf("=== One-sided (RMA) operations ===\n");
+    for (i = 0; i < NELEMS(rmabenchtab); i++) {
+        if (rmabenchtab[i].pt2pt.printinfo) {
+            rmabenchtab[i].pt2pt.printinfo(&rmabenchtab[i]);
+        }
+    }
+}
+
+rmabench_t *lookup_rmabench(const char *name)
+{
+    int i;
+
+    for (i = 0; i < NELEMS(rmabenchtab); i++) {
+        if (strcasecmp(rmabenchtab[i].pt2pt.name, name) == 0) {
+            return &rmabenchtab[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,67 @@
+/*
+ * bench_rma.h: Functions for benchmarking MPI one-sided (RMA) routines.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef BENCH_RMA_H
+#define BENCH_RMA_H
+
+#include <mpi.h>
+
+#include "bench_pt2pt.h"
+
+#if MPI_VERSION >= 3
+#define HAVE_RMA
+#endif
+
+/* Synchronization of access epochs */
+enum RMASyncType {
+    RMASYNC_FENCE = 0,      /* MPI_Win_fence */
+    RMASYNC_PSCW = 1,       /* MPI_Win_post/start/complete/wait */
+    RMASYNC_LOCK = 2,       /* MPI_Win_lock/unlock */
+    RMASYNC_LOCKALL = 3     /* MPI_Win_lock_all + MPI_Win_flush */
+};
+
+/*
+ * Benchmark: process 0 (origin) accesses window of process 1 (target).
+ * Measure functions are shared by benchmarks with different
+ * synchronization types and are executed by pt2pt driver.
+ */
+typedef struct {
+    pt2ptbench_t pt2pt;
+    int sync;
+} rmabench_t;
+
+extern rmabench_t rmabenchtab[];
+
+void print_rmabench_info();
+rmabench_t *lookup_rmabench(const char *name);
+
+int run_rmabench(rmabench_t *bench);
+
+/*
+ * rmabench_win_create: Allocates window of size bytes on processes of
+ *                      params->comm and opens passive epoch for lock_all.
+ */
+int rmabench_win_create(pt2pttest_params_t *params, int size, int dispunit);
+void rmabench_win_free();
+MPI_Win rmabench_win();
+
+/* rmabench_isorigin: Returns 1 if calling process is origin. */
+int rmabench_isorigin();
+
+/*
+ * Access epoch of current synchronization type.
+ * Passive target does not call MPI routines during the epoch, so without
+ * asynchronous progress origin would wait for it. Therefore passive target
+ * waits in MPI_Recv (progress engine is active) for the release message,
+ * which is sent by origin after the time measurement.
+ */
+int rmabench_epoch_begin();
+int rmabench_epoch_end();
+int rmabench_epoch_release();
+
+const char *rmabench_syncname(int sync);
+
+#endif /* BENCH_RMA_H */
@@ -0,0 +1,180 @@
+/*
+ * bench_rma_tab.h:
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef BENCH_RMA_TAB_H
+#define BENCH_RMA_TAB_H
+
+#include "rma/put.h"
+#include "rma/get.h"
+#include "rma/accumulate.h"
+#include "rma/fetch_and_op.h"
+
+rmabench_t rmabenchtab[] = {
+#ifdef HAVE_RMA
+{
+    {
+      "Put_fence",
+      (pt2ptbench_init_ptr_t)bench_put_init,
+      (pt2ptbench_free_ptr_t)bench_put_free,
+      (pt2ptbench_printinfo_ptr_t)bench_put_printinfo,
+      (pt2ptbench_op_ptr_t)measure_put_sync
+    },
+    RMASYNC_FENCE
+},
+{
+    {
+      "Put_pscw",
+      (pt2ptbench_init_ptr_t)bench_put_init,
+      (pt2ptbench_free_ptr_t)bench_put_free,
+      (pt2ptbench_printinfo_ptr_t)bench_put_printinfo,
+      (pt2ptbench_op_ptr_t)measure_put_sync
+    },
+    RMASYNC_PSCW
+},
+{
+    {
+      "Put_lock",
+      (pt2ptbench_init_ptr_t)bench_put_init,
+      (pt2ptbench_free_ptr_t)bench_put_free,
+      (pt2ptbench_printinfo_ptr_t)bench_put_printinfo,
+      (pt2ptbench_op_ptr_t)measure_put_sync
+    },
+    RMASYNC_LOCK
+},
+{
+    {
+      "Put_lockall",
+      (pt2ptbench_init_ptr_t)bench_put_init,
+      (pt2ptbench_free_ptr_t)bench_put_free,
+      (pt2ptbench_printinfo_ptr_t)bench_put_printinfo,
+      (pt2ptbench_op_ptr_t)measure_put_sync
+    },
+    RMASYNC_LOCKALL
+},
+{
+    {
+      "Get_fence",
+      (pt2ptbench_init_ptr_t)bench_get_init,
+      (pt2ptbench_free_ptr_t)bench_get_free,
+      (pt2ptbench_printinfo_ptr_t)bench_get_printinfo,
+      (pt2ptbench_op_ptr_t)measure_get_sync
+    },
+    RMASYNC_FENCE
+},
+{
+    {
+      "Get_pscw",
+      (pt2ptbench_init_ptr_t)bench_get_init,
+      (pt2ptbench_free_ptr_t)bench_get_free,
+      (pt2ptbench_printinfo_ptr_t)bench_get_printinfo,
+      (pt2ptbench_op_ptr_t)measure_get_sync
+    },
+    RMASYNC_PSCW
+},
+{
+    {
+      "Get_lock",
+      (pt2ptbench_init_ptr_t)bench_get_init,
+      (pt2ptbench_free_ptr_t)bench_get_free,
+      (pt2ptbench_printinfo_ptr_t)bench_get_printinfo,
+      (pt2ptbench_op_ptr_t)measure_get_sync
+    },
+    RMASYNC_LOCK
+},
+{
+    {
+      "Get_lockall",
+      (pt2ptbench_init_ptr_t)bench_get_init,
+      (pt2ptbench_free_ptr_t)bench_get_free,
+      (pt2ptbench_printinfo_ptr_t)bench_get_printinfo,
+      (pt2ptbench_op_ptr_t)measure_get_sync
+    },
+    RMASYNC_LOCKALL
+},
+{
+    {
+      "Accumulate_fence",
+      (pt2ptbench_init_ptr_t)bench_accumulate_init,
+      (pt2ptbench_free_ptr_t)bench_accumulate_free,
+      (pt2ptbench_printinfo_ptr_t)bench_accumulate_printinfo,
+      (pt2ptbench_op_ptr_t)measure_accumulate_sync
+    },
+    RMASYNC_FENCE
+},
+{
+    {
+      "Accumulate_pscw",
+      (pt2ptbench_init_ptr_t)bench_accumulate_init,
+      (pt2ptbench_free_ptr_t)bench_accumulate_free,
+      (pt2ptbench_printinfo_ptr_t)bench_accumulate_printinfo,
+      (pt2ptbench_op_ptr_t)measure_accumulate_sync
+    },
+    RMASYNC_PSCW
+},
+{
+    {
+      "Accumulate_lock",
+      (pt2ptbench_init_ptr_t)bench_accumulate_init,
+      (pt2ptbench_free_ptr_t)bench_accumulate_free,
+      (pt2ptbench_printinfo_ptr_t)bench_accumulate_printinfo,
+      (pt2ptbench_op_ptr_t)measure_accumulate_sync
+    },
+    RMASYNC_LOCK
+},
+{
+    {
+      "Accumulate_lockall",
+      (pt2ptbench_init_ptr_t)bench_accumulate_init,
+      (pt2ptbench_free_ptr_t)bench_accumulate_free,
+      (pt2ptbench_printinfo_ptr_t)bench_accumulate_printinfo,
+      (pt2ptbench_op_ptr_t)measure_accumulate_sync
+    },
+    RMASYNC_LOCKALL
+},
+{
+    {
+      "Fetch_and_op_fence",
+      (pt2ptbench_init_ptr_t)bench_fetch_and_op_init,
+      (pt2ptbench_free_ptr_t)bench_fetch_and_op_free,
+      (pt2ptbench_printinfo_ptr_t)bench_fetch_and_op_printinfo,
+      (pt2ptbench_op_ptr_t)measure_fetch_and_op_sync
+    },
+    RMASYNC_FENCE
+},
+{
+    {
+      "Fetch_and_op_pscw",
+      (pt2ptbench_init_ptr_t)bench_fetch_and_op_init,
+      (pt2ptbench_free_ptr_t)bench_fetch_and_op_free,
+      (pt2ptbench_printinfo_ptr_t)bench_fetch_and_op_printinfo,
+      (pt2ptbench_op_ptr_t)measure_fetch_and_op_sync
+    },
+    RMASYNC_PSCW
+},
+{
+    {
+      "Fetch_and_op_lock",
+      (pt2ptbench_init_ptr_t)bench_fetch_and_op_init,
+      (pt2ptbench_free_ptr_t)bench_fetch_and_op_free,
+      (pt2ptbench_printinfo_ptr_t)bench_fetch_and_op_printinfo,
+      (pt2ptbench_op_ptr_t)measure_fetch_and_op_sync
+    },
+    RMASYNC_LOCK
+},
+{
+    {
+      "Fetch_and_op_lockall",
+      (pt2ptbench_init_ptr_t)bench_fetch_and_op_init,
+      (pt2ptbench_free_ptr_t)bench_fetch_and_op_free,
+      (pt2ptbench_printinfo_ptr_t)bench_fetch_and_op_printinfo,
+      (pt2ptbench_op_ptr_t)measure_fetch_and_op_sync
+    },
+    RMASYNC_LOCKALL
+}
+#endif
+};
+
+#endif /* BENCH_RMA_TAB_H */
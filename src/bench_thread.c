@@ -0,0 +1,354 @@
+/*
+ * bench_thread.c: Functions for benchmarking MPI routines called
+ *                 concurrently by threads (MPI_THREAD_MULTIPLE).
+ *
+ * Each of T threads of process calls operation on its own duplicate of
+ * the test communicator, so threads with the same index communicate
+ * with each other. Threads of process start measurements simultaneously
+ * and runs of thread are pipelined (time slots are per process, so
+ * they are not used). Number of threads is 1, 2, 4, ..., T (-i).
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+
+#include <mpi.h>
+
+#include "bench_thread.h"
+#include "mpiperf.h"
+#include "stat.h"
+#include "report.h"
+#include "logger.h"
+#include "util.h"
+#include "hpctimer.h"
+#include "bench_thread_tab.h"
+
+/* Arguments of thread */
+typedef struct {
+    threadbench_t *bench;
+    threadtest_params_t params;
+    pthread_barrier_t *startbarrier;
+    void *sbuf;
+    void *rbuf;
+    int nruns;
+    stat_sample_t *timestat;
+    double looptime;
+} threadbench_arg_t;
+
+static void *threadbench_thread(void *arg);
+
+/* run_threadbench: Runs benchmark for threads of process */
+int run_threadbench(threadbench_t *bench)
+{
+    double benchtime, *looptime;
+    threadtest_params_t params;
+    stat_sample_t **timestat;
+    MPI_Comm comm, *comms;
+    int i, nruns;
+
+    if (mpiperf_thread_provided < MPI_THREAD_MULTIPLE) {
+        exit_error("Thread benchmarks require MPI_THREAD_MULTIPLE (provided level: %s)",
+                   thread_level_name(mpiperf_thread_provided));
+    }
+
+    benchtime = hpctimer_wtime();
+    report_write_header();
+    report_write_threadbench_header(bench);
+
+    comms = xmalloc(sizeof(*comms) * mpiperf_nthreads);
+    timestat = xmalloc(sizeof(*timestat) * mpiperf_nthreads);
+    looptime = xmalloc(sizeof(*looptime) * mpiperf_nthreads);
+    for (i = 0; i < mpiperf_nthreads; i++) {
+        if ( (timestat[i] = stat_sample_create()) == NULL)
+            exit_error("Can't allocate memory for statistic");
+    }
+
+    /* For each communicator size */
+    for (params.nprocs = mpiperf_nprocs_min;
+         params.nprocs <= mpiperf_nprocs_max; )
+    {
+        comm = createcomm(MPI_COMM_WORLD, params.nprocs);
+        if (comm != MPI_COMM_NULL) {
+            /* Collective calls on one communicator can't be concurrent */
+            for (i = 0; i < mpiperf_nthreads; i++)
+                MPI_Comm_dup(comm, &comms[i]);
+        }
+
+        /* For each data size (count) */
+        for (params.count = mpiperf_count_min;
+             params.count <= mpiperf_count_max; )
+        {
+            MPI_Barrier(MPI_COMM_WORLD);
+            logger_log("Test (nprocs = %d, count = %d) is started",
+                       params.nprocs, params.count);
+
+            if (comm != MPI_COMM_NULL) {
+                /* For each number of threads */
+                for (params.nthreads = 1; ;
+                     params.nthreads = (params.nthreads * 2 < mpiperf_nthreads) ?
+                                       params.nthreads * 2 : mpiperf_nthreads)
+                {
+                    params.comm = comm;
+                    run_threadbench_test(bench, &params, comms, &nruns,
+                                         timestat, looptime);
+                    report_write_threadbench(bench, &params, nruns, timestat,
+                                             looptime);
+                    if (params.nthreads == mpiperf_nthreads)
+                        break;
+                }
+            }
+
+            if (mpiperf_count_step_type == STEP_TYPE_MUL) {
+                params.count *= mpiperf_count_step;
+            } else {
+                params.count += mpiperf_count_step;
+            }
+        }
+
+        if (comm != MPI_COMM_NULL) {
+            for (i = 0; i < mpiperf_nthreads; i++)
+                MPI_Comm_free(&comms[i]);
+            MPI_Comm_free(&comm);
+        }
+
+        if (mpiperf_nprocs_step_type == STEP_TYPE_MUL) {
+            params.nprocs *= mpiperf_nprocs_step;
+        } else {
+            params.nprocs += mpiperf_nprocs_step;
+        }
+    }
+
+    for (i = 0; i < mpiperf_nthreads; i++)
+        stat_sample_free(timestat[i]);
+    free(timestat);
+    free(looptime);
+    free(comms);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    benchtime = hpctimer_wtime() - benchtime;
+    if (IS_MASTER_RANK) {
+        report_printf("# Elapsed time: %.6f sec.\n", benchtime);
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * run_threadbench_test: Measures time of operation in each of
+ *                       params->nthreads threads of current process.
+ */
+int run_threadbench_test(threadbench_t *bench, threadtest_params_t *params,
+                         MPI_Comm *comms, int *nruns,
+                         stat_sample_t **timestat, double *looptime)
+{
+    pthread_barrier_t startbarrier;
+    pthread_t *threads;
+    threadbench_arg_t *args;
+    size_t bufsize;
+    int i;
+
+    threads = xmalloc(sizeof(*threads) * params->nthreads);
+    args = xmalloc(sizeof(*args) * params->nthreads);
+    pthread_barrier_init(&startbarrier, NULL, params->nthreads);
+
+    for (i = 0; i < params->nthreads; i++) {
+        args[i].bench = bench;
+        args[i].params = *params;
+        args[i].params.comm = comms[i];
+        args[i].params.thread = i;
+        args[i].startbarrier = &startbarrier;
+
+        /*
+         * Buffers are zeroed: garbage can contain denormals and NaNs,
+         * which affect the time of reduction operations.
+         */
+        bufsize = bench->bufsize(&args[i].params);
+        args[i].sbuf = xmalloc(bufsize > 0 ? bufsize : 1);
+        args[i].rbuf = xmalloc(bufsize > 0 ? bufsize : 1);
+        memset(args[i].sbuf, 0, bufsize);
+        memset(args[i].rbuf, 0, bufsize);
+
+        args[i].nruns = mpiperf_nruns_max;
+        args[i].timestat = timestat[i];
+        args[i].looptime = 0.0;
+        stat_sample_clean(timestat[i]);
+    }
+
+    mpiperf_is_measure_started = 1;
+    for (i = 0; i < params->nthreads; i++) {
+        if (pthread_create(&threads[i], NULL, threadbench_thread,
+                           &args[i]) != 0)
+        {
+            exit_error("Can't create thread %d", i);
+        }
+    }
+    for (i = 0; i < params->nthreads; i++)
+        pthread_join(threads[i], NULL);
+    mpiperf_is_measure_started = 0;
+
+    *nruns = mpiperf_nruns_max;
+    for (i = 0; i < params->nthreads; i++) {
+        looptime[i] = args[i].looptime;
+        logger_log("Thread %d is finished: %d correct runs, mean = %.6f",
+                   i, stat_sample_size(timestat[i]),
+                   stat_sample_mean(timestat[i]));
+        free(args[i].sbuf);
+        free(args[i].rbuf);
+    }
+
+    pthread_barrier_destroy(&startbarrier);
+    free(args);
+    free(threads);
+    return MPIPERF_SUCCESS;
+}
+
+/* threadbench_thread: Warmup and pipelined runs of operation. */
+static void *threadbench_thread(void *arg)
+{
+    threadbench_arg_t *a = (threadbench_arg_t *)arg;
+    double t, looptime;
+    int i;
+
+    for (i = 0; i < TEST_STAGE_NRUNS_INIT; i++)
+        a->bench->op(&a->params, a->sbuf, a->rbuf);
+
+    /* All threads of process start simultaneously */
+    pthread_barrier_wait(a->startbarrier);
+    MPI_Barrier(a->params.comm);
+
+    looptime = hpctimer_wtime();
+    for (i = 0; i < a->nruns; i++) {
+        t = hpctimer_wtime();
+        if (a->bench->op(&a->params, a->sbuf, a->rbuf) == MPI_SUCCESS)
+            stat_sample_add(a->timestat, hpctimer_wtime() - t);
+    }
+    a->looptime = hpctimer_wtime() - looptime;
+    return NULL;
+}
+
+void print_threadbench_info()
+{
+    int i;
+
+    printf("=== Operations in threads (MPI_THREAD_MULTIPLE) ===\n");
+    for (i = 0; i < NELEMS(threadbenchtab); i++) {
+        if (threadbenchtab[i].printinfo) {
+            threadbenchtab[i].printinfo();
+        }
+    }
+}
+
+threadbench_t *lookup_threadbench(const char *name)
+{
+    int i;
+
+    for (i = 0; i < NELEMS(threadbenchtab); i++) {
+        if (strcasecmp(threadbenchtab[i].name, name) == 0) {
+            return &threadbenchtab[i];
+        }
+    }
+    return NULL;
+}
+
+int report_write_threadbench_header(threadbench_t *bench)
+{
+    if (!IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    printf("# Characteristics of measurements:\n");
+    printf("#   Procs: total number of processes\n");
+    printf("#   Count: count of elements in send/recv buffer\n");
+    printf("#   Threads: number of threads per process\n");
+    printf("#   Thread: index of thread (all - aggregate of threads)\n");
+    printf("#   TRuns: number of measurements per thread\n");
+    printf("#   RSE: relative standard error of time (StdErr / Mean) - max of all procs.\n");
+    printf("#   Mean: mean time of operation (for all - mean of threads)\n");
+    printf("#   Msg/s: TRuns / time of loop of TRuns operations\n");
+    printf("#          (for all - sum of threads)\n");
+    printf("#\n");
+    printf("# Value of Mean, Msg/s are computed for thread i as\n");
+    printf("# max_of_all_procs(mean_of_runs(t[i][p][1], ..., t[i][p][TRuns])),\n");
+    printf("# where t[i][p][j] is a time of thread i of process p at measure j\n");
+    printf("#\n");
+    printf("# -------------------------------------------------------------------------------------\n");
+    printf("# Benchmark: %s\n", bench->name);
+    printf("# Benchmarking mode: pipelined measurements in %d threads at most\n",
+           mpiperf_nthreads);
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        printf("# [Procs] [Count]     [Threads] [Thread] [TRuns] [RSE]      [Mean]       [Msg/s]\n");
+    } else {
+        /* usec */
+        printf("# [Procs] [Count]     [Threads] [Thread] [TRuns] [RSE]      [Mean]         [Msg/s]\n");
+    }
+    printf("# -------------------------------------------------------------------------------------\n");
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_threadbench(threadbench_t *bench, threadtest_params_t *params,
+                             int nruns, stat_sample_t **timestat,
+                             double *looptime)
+{
+    enum {
+        MEANTIME = 0,
+        RSE = 1,
+        LOOPTIME = 2
+    };
+    enum { NSTAT = 3 };
+    double *stat, *maxstat = NULL;
+    double mean, rate, rse;
+    const char *fmt = NULL, *fmt_all = NULL;
+    double timescale = 0;
+    int i;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-9d %-8d %-7d %-10.2f %-12.6f %-12.2f\n";
+        fmt_all = "  %-7d %-11d %-9d %-8s %-7d %-10.2f %-12.6f %-12.2f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-9d %-8d %-7d %-10.2f %-14.2f %-14.2f\n";
+        fmt_all = "  %-7d %-11d %-9d %-8s %-7d %-10.2f %-14.2f %-14.2f\n";
+        timescale = 1E6;
+    }
+
+    stat = xmalloc(sizeof(*stat) * NSTAT * params->nthreads);
+    if (IS_MASTER_RANK)
+        maxstat = xmalloc(sizeof(*maxstat) * NSTAT * params->nthreads);
+
+    for (i = 0; i < params->nthreads; i++) {
+        stat[i * NSTAT + MEANTIME] = stat_sample_mean(timestat[i]);
+        stat[i * NSTAT + RSE] = stat_sample_stderr_rel(timestat[i]);
+        stat[i * NSTAT + LOOPTIME] = looptime[i];
+    }
+    MPI_Reduce(stat, maxstat, NSTAT * params->nthreads, MPI_DOUBLE, MPI_MAX,
+               mpiperf_master_rank, params->comm);
+
+    if (IS_MASTER_RANK) {
+        mean = 0.0;
+        rate = 0.0;
+        rse = 0.0;
+        for (i = 0; i < params->nthreads; i++) {
+            printf(fmt, params->nprocs, params->count, params->nthreads, i,
+                   nruns, maxstat[i * NSTAT + RSE],
+                   maxstat[i * NSTAT + MEANTIME] * timescale,
+                   (maxstat[i * NSTAT + LOOPTIME] > 0.0) ?
+                   nruns / maxstat[i * NSTAT + LOOPTIME] : 0.0);
+
+            mean += maxstat[i * NSTAT + MEANTIME];
+            rse = stat_fmax2(rse, maxstat[i * NSTAT + RSE]);
+            if (maxstat[i * NSTAT + LOOPTIME] > 0.0)
+                rate += nruns / maxstat[i * NSTAT + LOOPTIME];
+        }
+        printf(fmt_all, params->nprocs, params->count, params->nthreads, "all",
+               nruns, rse, mean / params->nthreads * timescale, rate);
+        free(maxstat);
+    }
+    free(stat);
+    return MPIPERF_SUCCESS;
+}
@@ -0,0 +1,54 @@
+/*
+ * bench_thread.h: Functions for benchmarking MPI routines called
+ *                 concurrently by threads (MPI_THREAD_MULTIPLE).
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef BENCH_THREAD_H
+#define BENCH_THREAD_H
+
+#include <stddef.h>
+
+#include <mpi.h>
+
+#include "stat.h"
+
+/* Test parameters of thread */
+typedef struct {
+    MPI_Comm comm;      /* Communicator of thread (duplicate of test comm.) */
+    int nprocs;
+    int count;
+    int nthreads;       /* Number of threads per process */
+    int thread;         /* Index of thread */
+} threadtest_params_t;
+
+typedef void (*threadbench_printinfo_ptr_t)();
+typedef size_t (*threadbench_bufsize_ptr_t)(threadtest_params_t *params);
+typedef int (*threadbench_op_ptr_t)(threadtest_params_t *params,
+                                    void *sbuf, void *rbuf);
+
+/* Benchmark */
+typedef struct {
+    char *name;                             /* Benchmark name */
+    threadbench_printinfo_ptr_t printinfo;
+    threadbench_bufsize_ptr_t bufsize;      /* Size of send/recv buffer */
+    threadbench_op_ptr_t op;                /* Calls operation (MPI rc) */
+} threadbench_t;
+
+extern threadbench_t threadbenchtab[];
+
+void print_threadbench_info();
+threadbench_t *lookup_threadbench(const char *name);
+
+int run_threadbench(threadbench_t *bench);
+int run_threadbench_test(threadbench_t *bench, threadtest_params_t *params,
+                         MPI_Comm *comms, int *nruns,
+                         stat_sample_t **timestat, double *looptime);
+
+int report_write_threadbench_header(threadbench_t *bench);
+int report_write_threadbench(threadbench_t *bench, threadtest_params_t *params,
+                             int nruns, stat_sample_t **timestat,
+                             double *looptime);
+
+#endif /* BENCH_THREAD_H */
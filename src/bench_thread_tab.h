@@ -0,0 +1,35 @@
+/*
+ * bench_thread_tab.h:
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef BENCH_THREAD_TAB_H
+#define BENCH_THREAD_TAB_H
+
+#include "thread/tallreduce.h"
+#include "thread/tbarrier.h"
+#include "thread/tsendrecv.h"
+
+threadbench_t threadbenchtab[] = {
+{
+    "Thread_Allreduce",
+    (threadbench_printinfo_ptr_t)bench_tallreduce_printinfo,
+    (threadbench_bufsize_ptr_t)bench_tallreduce_bufsize,
+    (threadbench_op_ptr_t)measure_tallreduce
+},
+{
+    "Thread_Barrier",
+    (threadbench_printinfo_ptr_t)bench_tbarrier_printinfo,
+    (threadbench_bufsize_ptr_t)bench_tbarrier_bufsize,
+    (threadbench_op_ptr_t)measure_tbarrier
+},
+{
+    "Thread_Sendrecv",
+    (threadbench_printinfo_ptr_t)bench_tsendrecv_printinfo,
+    (threadbench_bufsize_ptr_t)bench_tsendrecv_bufsize,
+    (threadbench_op_ptr_t)measure_tsendrecv
+}
+};
+
+#endif /* BENCH_THREAD_TAB_H */
@@ -0,0 +1,117 @@
+/*
+ * bootstrap.c: Bootstrap confidence intervals of quantiles.
+ *
+ * Quantile of resample is an order statistic, so it is one of elements
+ * of sorted dataset. Each process computes its share of replicates and
+ * counts how many times each element of dataset was a quantile
+ * of replicate. Counts are summed by one MPI_Allreduce and bounds
+ * of interval are quantiles of bootstrap distribution (percentile method).
+ * Resample is built by counting of drawn indices, so replicate costs O(n)
+ * without sorting.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <mpi.h>
+
+#include "bootstrap.h"
+#include "mpiperf.h"
+#include "stat.h"
+#include "util.h"
+
+static int fcmp(const void *a, const void *b);
+
+/* bootstrap_quantiles_ci: */
+int bootstrap_quantiles_ci(const double *data, int size, int nreplicates,
+                           double level, MPI_Comm comm, double *est,
+                           double *lb, double *ub)
+{
+    double *sorted, alpha;
+    int *draws, *counts, *counts_reduced;
+    int rank, commsize, nlocal, r, i, j, q, cum, rankq[STAT_NQUANTILES];
+    uint64_t state;
+
+    if (size < 1 || nreplicates < 1 || level <= 0.0 || level >= 100.0)
+        return MPIPERF_FAILURE;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &commsize);
+
+    sorted = xmalloc(sizeof(*sorted) * size);
+    memcpy(sorted, data, sizeof(*sorted) * size);
+    qsort(sorted, size, sizeof(*sorted), fcmp);
+    for (q = 0; q < STAT_NQUANTILES; q++) {
+        rankq[q] = stat_quantile_rank(size, stat_quantile_prob(q));
+        if (est)
+            est[q] = sorted[rankq[q]];
+    }
+
+    draws = xmalloc(sizeof(*draws) * size);
+    counts = xmalloc(sizeof(*counts) * size * STAT_NQUANTILES);
+    counts_reduced = xmalloc(sizeof(*counts_reduced) * size * STAT_NQUANTILES);
+    memset(counts, 0, sizeof(*counts) * size * STAT_NQUANTILES);
+
+    /* Share of replicates and independent stream of random numbers */
+    nlocal = nreplicates / commsize + (rank < nreplicates % commsize ? 1 : 0);
+    state = 0x9E3779B97F4A7C15ULL * (uint64_t)(rank + 1) ^ (uint64_t)size;
+    if (state == 0)
+        state = 1;
+
+    for (r = 0; r < nlocal; r++) {
+        memset(draws, 0, sizeof(*draws) * size);
+        for (i = 0; i < size; i++)
+            draws[rng_range(&state, size)]++;
+
+        /* Order statistics of resample (quantiles are nondecreasing) */
+        cum = 0;
+        j = 0;
+        for (q = 0; q < STAT_NQUANTILES; q++) {
+            while (cum + draws[j] <= rankq[q])
+                cum += draws[j++];
+            counts[q * size + j]++;
+        }
+    }
+
+    MPI_Allreduce(counts, counts_reduced, size * STAT_NQUANTILES, MPI_INT,
+                  MPI_SUM, comm);
+
+    alpha = (1.0 - level / 100.0) / 2.0;
+    for (q = 0; q < STAT_NQUANTILES; q++) {
+        cum = 0;
+        lb[q] = ub[q] = sorted[size - 1];
+        for (j = 0; j < size; j++) {
+            if (cum + counts_reduced[q * size + j] > alpha * nreplicates &&
+                cum <= alpha * nreplicates)
+            {
+                lb[q] = sorted[j];
+            }
+            cum += counts_reduced[q * size + j];
+            if (cum >= (1.0 - alpha) * nreplicates) {
+                ub[q] = sorted[j];
+                break;
+            }
+        }
+    }
+
+    free(counts_reduced);
+    free(counts);
+    free(draws);
+    free(sorted);
+    return MPIPERF_SUCCESS;
+}
+
+/* fcmp: Compares two elements of type double. */
+static int fcmp(const void *a, const void *b)
+{
+    if (*(const double *)a < *(const double *)b) {
+        return -1;
+    } else if (*(const double *)a > *(const double *)b) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,27 @@
+/*
+ * bootstrap.h: Bootstrap confidence intervals of quantiles.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef BOOTSTRAP_H
+#define BOOTSTRAP_H
+
+#include <mpi.h>
+
+#define BOOTSTRAP_NREPLICATES_DEFAULT 1000
+
+/*
+ * bootstrap_quantiles_ci: Computes percentile bootstrap confidence intervals
+ *                         (level in percents) of quantiles StatQuantiles.
+ *                         Replicates are distributed among processes of comm,
+ *                         dataset must be the same on all processes.
+ *                         Collective operation: results (lb[i], ub[i]) are
+ *                         returned on all processes. Quantiles of dataset
+ *                         are returned in est (if it is not NULL).
+ */
+int bootstrap_quantiles_ci(const double *data, int size, int nreplicates,
+                           double level, MPI_Comm comm, double *est,
+                           double *lb, double *ub);
+
+#endif /* BOOTSTRAP_H */
@@ -12,10 +12,10 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *bufpool = NULL;
 static int bufsize;
-static int root = 0;
 
 /* bench_bcast_init: */
 int bench_bcast_init(colltest_params_t *params)
@@ -39,7 +39,7 @@ int bench_bcast_free()
 int bench_bcast_printinfo()
 {
     printf("* Bcast\n"
-           "  proto: MPI_Bcast(buf, count, MPI_BYTE, %d, comm)\n", root);
+           "  proto: MPI_Bcast(buf, count, MPI_BYTE, root, comm)\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -51,7 +51,7 @@ int measure_bcast_sync(colltest_params_t *params, double *time)
     
     starttime = timeslot_startsync();
     rc = MPI_Bcast(mempool_alloc(bufpool, bufsize), params->count, MPI_BYTE,
-                   root, params->comm);
+                   params->root, params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
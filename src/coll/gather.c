@@ -12,11 +12,11 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
-static int root = 0;
 
 /* bench_gather_init: */
 int bench_gather_init(colltest_params_t *params)
@@ -33,7 +33,7 @@ int bench_gather_init(colltest_params_t *params)
     sbufsize = params->count * sizeof(char);
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         rbufpool = mempool_create(params->count * params->nprocs, mpiperf_isflushcache);
         if (rbufpool == NULL) {
             mempool_free(sbufpool);
@@ -57,7 +57,7 @@ int bench_gather_printinfo()
 {
     printf("* Gather\n"
            "  proto: MPI_Gather(sbuf, count, MPI_BYTE, \n"
-           "                    rbuf, count, MPI_BYTE, %d, comm)\n", root);
+           "                    rbuf, count, MPI_BYTE, root, comm)\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -70,7 +70,7 @@ int measure_gather_sync(colltest_params_t *params, double *time)
     starttime = timeslot_startsync();
     rc = MPI_Gather(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                     mempool_alloc(rbufpool, rbufsize), params->count, MPI_BYTE,
-                    root, params->comm);
+                    params->root, params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
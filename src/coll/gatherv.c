@@ -14,6 +14,7 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -21,7 +22,6 @@ static int *recvcounts = NULL;
 static int *displs = NULL;
 static int sbufsize;
 static int rbufsize;
-static int root = 0;
 
 /* bench_gatherv_init: */
 int bench_gatherv_init(colltest_params_t *params)
@@ -40,7 +40,7 @@ int bench_gatherv_init(colltest_params_t *params)
     sbufsize = params->count * sizeof(char);
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         recvcounts = malloc(sizeof(*recvcounts) * params->nprocs);
         displs = malloc(sizeof(*displs) * params->nprocs);
         if (recvcounts == NULL || displs == NULL) {
@@ -86,8 +86,8 @@ int bench_gatherv_printinfo()
 {
     printf("* Gatherv\n"
            "  proto: MPI_Gatherv(sbuf, count, MPI_BYTE, rbuf, recvcounts, displs,\n"
-           "                     MPI_BYTE, %d, comm)\n"
-           "  For each element: recvcounts[i] = count\n", root);
+           "                     MPI_BYTE, root, comm)\n"
+           "  For each element: recvcounts[i] = count\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -100,7 +100,7 @@ int measure_gatherv_sync(colltest_params_t *params, double *time)
     starttime = timeslot_startsync();
     rc = MPI_Gatherv(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                      mempool_alloc(rbufpool, rbufsize), recvcounts, displs,
-                     MPI_BYTE, root, params->comm);
+                     MPI_BYTE, params->root, params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
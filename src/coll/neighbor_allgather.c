@@ -0,0 +1,89 @@
+/*
+ * neighbor_allgather.c: Benchmark functions for Neighbor_allgather.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "neighbor_allgather.h"
+#include "bench_coll.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "util.h"
+#include "mempool.h"
+#include "topo.h"
+
+static mempool_t *sbufpool = NULL;
+static mempool_t *rbufpool = NULL;
+static int sbufsize, rbufsize;
+static MPI_Comm topocomm = MPI_COMM_NULL;
+static int indegree, outdegree;
+
+/* bench_neighbor_allgather_init: */
+int bench_neighbor_allgather_init(colltest_params_t *params)
+{
+    topocomm = topo_createcomm(params->comm);
+    topo_neighbors_count(topocomm, &indegree, &outdegree);
+
+    sbufpool = mempool_create(params->count, mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * indegree, mpiperf_isflushcache);
+    if (sbufpool == NULL || rbufpool == NULL) {
+        mempool_free(sbufpool);
+        mempool_free(rbufpool);
+        sbufpool = NULL;
+        rbufpool = NULL;
+        MPI_Comm_free(&topocomm);
+        return MPIPERF_FAILURE;
+    }
+    sbufsize = params->count * sizeof(char);
+    rbufsize = params->count * indegree * sizeof(char);
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_allgather_free: */
+int bench_neighbor_allgather_free()
+{
+    mempool_free(sbufpool);
+    mempool_free(rbufpool);
+    if (topocomm != MPI_COMM_NULL)
+        MPI_Comm_free(&topocomm);
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_allgather_printinfo: */
+int bench_neighbor_allgather_printinfo()
+{
+    printf("* Neighbor_allgather\n"
+           "  proto: MPI_Neighbor_allgather(sbuf, count, MPI_BYTE,\n"
+           "                                rbuf, count, MPI_BYTE, comm)\n"
+           "  comm: topology from option -k (default: cart2d)\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_neighbor_allgather_sync: */
+int measure_neighbor_allgather_sync(colltest_params_t *params, double *time)
+{
+#ifdef HAVE_NEIGHBOR_COLL
+    double starttime, endtime;
+    int rc;
+
+    starttime = timeslot_startsync();
+    rc = MPI_Neighbor_allgather(mempool_alloc(sbufpool, sbufsize), params->count,
+                                MPI_BYTE, mempool_alloc(rbufpool, rbufsize),
+                                params->count, MPI_BYTE, topocomm);
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
@@ -0,0 +1,20 @@
+/*
+ * neighbor_allgather.h: Benchmark functions for Neighbor_allgather.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef NEIGHBOR_ALLGATHER_H
+#define NEIGHBOR_ALLGATHER_H
+
+#include "bench_coll.h"
+#include "topo.h"
+
+int bench_neighbor_allgather_init(colltest_params_t *params);
+int bench_neighbor_allgather_free();
+int bench_neighbor_allgather_printinfo();
+int measure_neighbor_allgather_sync(colltest_params_t *params, double *time);
+
+#endif /* NEIGHBOR_ALLGATHER_H */
@@ -0,0 +1,105 @@
+/*
+ * neighbor_allgatherv.c: Benchmark functions for Neighbor_allgatherv.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "neighbor_allgatherv.h"
+#include "bench_coll.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "util.h"
+#include "mempool.h"
+#include "topo.h"
+
+static mempool_t *sbufpool = NULL;
+static mempool_t *rbufpool = NULL;
+static int *recvcounts = NULL;
+static int *displs = NULL;
+static int sbufsize, rbufsize;
+static MPI_Comm topocomm = MPI_COMM_NULL;
+static int indegree, outdegree;
+
+/* bench_neighbor_allgatherv_init: */
+int bench_neighbor_allgatherv_init(colltest_params_t *params)
+{
+    int i;
+
+    topocomm = topo_createcomm(params->comm);
+    topo_neighbors_count(topocomm, &indegree, &outdegree);
+
+    sbufpool = mempool_create(params->count, mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * indegree, mpiperf_isflushcache);
+    if (sbufpool == NULL || rbufpool == NULL) {
+        mempool_free(sbufpool);
+        mempool_free(rbufpool);
+        sbufpool = NULL;
+        rbufpool = NULL;
+        MPI_Comm_free(&topocomm);
+        return MPIPERF_FAILURE;
+    }
+    sbufsize = params->count * sizeof(char);
+    rbufsize = params->count * indegree * sizeof(char);
+
+    recvcounts = xmalloc(sizeof(*recvcounts) * indegree);
+    displs = xmalloc(sizeof(*displs) * indegree);
+    for (i = 0; i < indegree; i++) {
+        recvcounts[i] = params->count;
+        displs[i] = i * params->count;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_allgatherv_free: */
+int bench_neighbor_allgatherv_free()
+{
+    free(recvcounts);
+    free(displs);
+    recvcounts = NULL;
+    displs = NULL;
+    mempool_free(sbufpool);
+    mempool_free(rbufpool);
+    if (topocomm != MPI_COMM_NULL)
+        MPI_Comm_free(&topocomm);
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_allgatherv_printinfo: */
+int bench_neighbor_allgatherv_printinfo()
+{
+    printf("* Neighbor_allgatherv\n"
+           "  proto: MPI_Neighbor_allgatherv(sbuf, count, MPI_BYTE, rbuf, recvcounts,\n"
+           "                                 displs, MPI_BYTE, comm)\n"
+           "  For each element: recvcounts[i] = count\n"
+           "  comm: topology from option -k (default: cart2d)\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_neighbor_allgatherv_sync: */
+int measure_neighbor_allgatherv_sync(colltest_params_t *params, double *time)
+{
+#ifdef HAVE_NEIGHBOR_COLL
+    double starttime, endtime;
+    int rc;
+
+    starttime = timeslot_startsync();
+    rc = MPI_Neighbor_allgatherv(mempool_alloc(sbufpool, sbufsize), params->count,
+                                 MPI_BYTE, mempool_alloc(rbufpool, rbufsize),
+                                 recvcounts, displs, MPI_BYTE, topocomm);
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
@@ -0,0 +1,20 @@
+/*
+ * neighbor_allgatherv.h: Benchmark functions for Neighbor_allgatherv.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef NEIGHBOR_ALLGATHERV_H
+#define NEIGHBOR_ALLGATHERV_H
+
+#include "bench_coll.h"
+#include "topo.h"
+
+int bench_neighbor_allgatherv_init(colltest_params_t *params);
+int bench_neighbor_allgatherv_free();
+int bench_neighbor_allgatherv_printinfo();
+int measure_neighbor_allgatherv_sync(colltest_params_t *params, double *time);
+
+#endif /* NEIGHBOR_ALLGATHERV_H */
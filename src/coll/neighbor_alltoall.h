@@ -0,0 +1,20 @@
+/*
+ * neighbor_alltoall.h: Benchmark functions for Neighbor_alltoall.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef NEIGHBOR_ALLTOALL_H
+#define NEIGHBOR_ALLTOALL_H
+
+#include "bench_coll.h"
+#include "topo.h"
+
+int bench_neighbor_alltoall_init(colltest_params_t *params);
+int bench_neighbor_alltoall_free();
+int bench_neighbor_alltoall_printinfo();
+int measure_neighbor_alltoall_sync(colltest_params_t *params, double *time);
+
+#endif /* NEIGHBOR_ALLTOALL_H */
@@ -0,0 +1,117 @@
+/*
+ * neighbor_alltoallv.c: Benchmark functions for Neighbor_alltoallv.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "neighbor_alltoallv.h"
+#include "bench_coll.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "util.h"
+#include "mempool.h"
+#include "topo.h"
+
+static mempool_t *sbufpool = NULL;
+static mempool_t *rbufpool = NULL;
+static int *sendcounts = NULL;
+static int *sdispls = NULL;
+static int *recvcounts = NULL;
+static int *rdispls = NULL;
+static int sbufsize, rbufsize;
+static MPI_Comm topocomm = MPI_COMM_NULL;
+static int indegree, outdegree;
+
+/* bench_neighbor_alltoallv_init: */
+int bench_neighbor_alltoallv_init(colltest_params_t *params)
+{
+    int i;
+
+    topocomm = topo_createcomm(params->comm);
+    topo_neighbors_count(topocomm, &indegree, &outdegree);
+
+    sbufpool = mempool_create(params->count * outdegree, mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * indegree, mpiperf_isflushcache);
+    if (sbufpool == NULL || rbufpool == NULL) {
+        mempool_free(sbufpool);
+        mempool_free(rbufpool);
+        sbufpool = NULL;
+        rbufpool = NULL;
+        MPI_Comm_free(&topocomm);
+        return MPIPERF_FAILURE;
+    }
+    sbufsize = params->count * outdegree * sizeof(char);
+    rbufsize = params->count * indegree * sizeof(char);
+
+    sendcounts = xmalloc(sizeof(*sendcounts) * outdegree);
+    sdispls = xmalloc(sizeof(*sdispls) * outdegree);
+    for (i = 0; i < outdegree; i++) {
+        sendcounts[i] = params->count;
+        sdispls[i] = i * params->count;
+    }
+    recvcounts = xmalloc(sizeof(*recvcounts) * indegree);
+    rdispls = xmalloc(sizeof(*rdispls) * indegree);
+    for (i = 0; i < indegree; i++) {
+        recvcounts[i] = params->count;
+        rdispls[i] = i * params->count;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_alltoallv_free: */
+int bench_neighbor_alltoallv_free()
+{
+    free(sendcounts);
+    free(sdispls);
+    free(recvcounts);
+    free(rdispls);
+    sendcounts = NULL;
+    sdispls = NULL;
+    recvcounts = NULL;
+    rdispls = NULL;
+    mempool_free(sbufpool);
+    mempool_free(rbufpool);
+    if (topocomm != MPI_COMM_NULL)
+        MPI_Comm_free(&topocomm);
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_alltoallv_printinfo: */
+int bench_neighbor_alltoallv_printinfo()
+{
+    printf("* Neighbor_alltoallv\n"
+           "  proto: MPI_Neighbor_alltoallv(sbuf, sendcounts, sdispls, MPI_BYTE,\n"
+           "                                rbuf, recvcounts, rdispls, MPI_BYTE, comm)\n"
+           "  For each element: sendcounts[i] = recvcounts[i] = count\n"
+           "  comm: topology from option -k (default: cart2d)\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_neighbor_alltoallv_sync: */
+int measure_neighbor_alltoallv_sync(colltest_params_t *params, double *time)
+{
+#ifdef HAVE_NEIGHBOR_COLL
+    double starttime, endtime;
+    int rc;
+
+    starttime = timeslot_startsync();
+    rc = MPI_Neighbor_alltoallv(mempool_alloc(sbufpool, sbufsize), sendcounts,
+                                sdispls, MPI_BYTE, mempool_alloc(rbufpool, rbufsize),
+                                recvcounts, rdispls, MPI_BYTE, topocomm);
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
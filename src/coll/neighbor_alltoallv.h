@@ -0,0 +1,20 @@
+/*
+ * neighbor_alltoallv.h: Benchmark functions for Neighbor_alltoallv.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef NEIGHBOR_ALLTOALLV_H
+#define NEIGHBOR_ALLTOALLV_H
+
+#include "bench_coll.h"
+#include "topo.h"
+
+int bench_neighbor_alltoallv_init(colltest_params_t *params);
+int bench_neighbor_alltoallv_free();
+int bench_neighbor_alltoallv_printinfo();
+int measure_neighbor_alltoallv_sync(colltest_params_t *params, double *time);
+
+#endif /* NEIGHBOR_ALLTOALLV_H */
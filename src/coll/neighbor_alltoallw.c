@@ -0,0 +1,129 @@
+/*
+ * neighbor_alltoallw.c: Benchmark functions for Neighbor_alltoallw.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "neighbor_alltoallw.h"
+#include "bench_coll.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "util.h"
+#include "mempool.h"
+#include "topo.h"
+
+static mempool_t *sbufpool = NULL;
+static mempool_t *rbufpool = NULL;
+static int *sendcounts = NULL;
+static MPI_Aint *sdispls = NULL;
+static MPI_Datatype *sendtypes = NULL;
+static int *recvcounts = NULL;
+static MPI_Aint *rdispls = NULL;
+static MPI_Datatype *recvtypes = NULL;
+static int sbufsize, rbufsize;
+static MPI_Comm topocomm = MPI_COMM_NULL;
+static int indegree, outdegree;
+
+/* bench_neighbor_alltoallw_init: */
+int bench_neighbor_alltoallw_init(colltest_params_t *params)
+{
+    int i;
+
+    topocomm = topo_createcomm(params->comm);
+    topo_neighbors_count(topocomm, &indegree, &outdegree);
+
+    sbufpool = mempool_create(params->count * outdegree, mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * indegree, mpiperf_isflushcache);
+    if (sbufpool == NULL || rbufpool == NULL) {
+        mempool_free(sbufpool);
+        mempool_free(rbufpool);
+        sbufpool = NULL;
+        rbufpool = NULL;
+        MPI_Comm_free(&topocomm);
+        return MPIPERF_FAILURE;
+    }
+    sbufsize = params->count * outdegree * sizeof(char);
+    rbufsize = params->count * indegree * sizeof(char);
+
+    sendcounts = xmalloc(sizeof(*sendcounts) * outdegree);
+    sdispls = xmalloc(sizeof(*sdispls) * outdegree);
+    sendtypes = xmalloc(sizeof(*sendtypes) * outdegree);
+    for (i = 0; i < outdegree; i++) {
+        sendcounts[i] = params->count;
+        sdispls[i] = (MPI_Aint)i * params->count;
+        sendtypes[i] = MPI_BYTE;
+    }
+    recvcounts = xmalloc(sizeof(*recvcounts) * indegree);
+    rdispls = xmalloc(sizeof(*rdispls) * indegree);
+    recvtypes = xmalloc(sizeof(*recvtypes) * indegree);
+    for (i = 0; i < indegree; i++) {
+        recvcounts[i] = params->count;
+        rdispls[i] = (MPI_Aint)i * params->count;
+        recvtypes[i] = MPI_BYTE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_alltoallw_free: */
+int bench_neighbor_alltoallw_free()
+{
+    free(sendcounts);
+    free(sdispls);
+    free(sendtypes);
+    free(recvcounts);
+    free(rdispls);
+    free(recvtypes);
+    sendcounts = NULL;
+    sdispls = NULL;
+    sendtypes = NULL;
+    recvcounts = NULL;
+    rdispls = NULL;
+    recvtypes = NULL;
+    mempool_free(sbufpool);
+    mempool_free(rbufpool);
+    if (topocomm != MPI_COMM_NULL)
+        MPI_Comm_free(&topocomm);
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_neighbor_alltoallw_printinfo: */
+int bench_neighbor_alltoallw_printinfo()
+{
+    printf("* Neighbor_alltoallw\n"
+           "  proto: MPI_Neighbor_alltoallw(sbuf, sendcounts, sdispls, sendtypes,\n"
+           "                                rbuf, recvcounts, rdispls, recvtypes,\n"
+           "                                comm)\n"
+           "  For each element: sendtypes[i] = recvtypes[i] = MPI_BYTE\n"
+           "  For each element: sendcounts[i] = recvcounts[i] = count\n"
+           "  comm: topology from option -k (default: cart2d)\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_neighbor_alltoallw_sync: */
+int measure_neighbor_alltoallw_sync(colltest_params_t *params, double *time)
+{
+#ifdef HAVE_NEIGHBOR_COLL
+    double starttime, endtime;
+    int rc;
+
+    starttime = timeslot_startsync();
+    rc = MPI_Neighbor_alltoallw(mempool_alloc(sbufpool, sbufsize), sendcounts,
+                                sdispls, sendtypes, mempool_alloc(rbufpool, rbufsize),
+                                recvcounts, rdispls, recvtypes, topocomm);
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
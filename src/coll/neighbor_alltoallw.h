@@ -0,0 +1,20 @@
+/*
+ * neighbor_alltoallw.h: Benchmark functions for Neighbor_alltoallw.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef NEIGHBOR_ALLTOALLW_H
+#define NEIGHBOR_ALLTOALLW_H
+
+#include "bench_coll.h"
+#include "topo.h"
+
+int bench_neighbor_alltoallw_init(colltest_params_t *params);
+int bench_neighbor_alltoallw_free();
+int bench_neighbor_alltoallw_printinfo();
+int measure_neighbor_alltoallw_sync(colltest_params_t *params, double *time);
+
+#endif /* NEIGHBOR_ALLTOALLW_H */
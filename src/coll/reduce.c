@@ -12,11 +12,12 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
-static int root = 0;
 
 /* bench_reduce_init: */
 int bench_reduce_init(colltest_params_t *params)
@@ -26,21 +27,22 @@ int bench_reduce_init(colltest_params_t *params)
     rbufpool = NULL;
     rbufsize = 0;
 
-    sbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
+    sbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
     if (sbufpool == NULL) {
         return MPIPERF_FAILURE;
     }
-    sbufsize = params->count * sizeof(double);
+    sbufsize = params->count * reduceop_typesize();
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
-        rbufpool = mempool_create(params->count * sizeof(double),
+    if (rank == params->root || !rootpolicy_isfixed()) {
+        rbufpool = mempool_create(params->count * reduceop_typesize(),
                                   mpiperf_isflushcache);
         if (rbufpool == NULL) {
             mempool_free(sbufpool);
             return MPIPERF_FAILURE;
         }
-        rbufsize = params->count * sizeof(double);
+        rbufsize = params->count * reduceop_typesize();
     }
     return MPIPERF_SUCCESS;
 }
@@ -57,8 +59,9 @@ int bench_reduce_free(collbench_t *bench)
 int bench_reduce_printinfo()
 {
     printf("* Reduce\n"
-           "  proto: MPI_Reduce(sbuf, rbuf, count, MPI_DOUBLE, \n"
-           "                    MPI_SUM, %d, comm)\n", root);
+           "  proto: MPI_Reduce(sbuf, rbuf, count, %s, \n"
+           "                    %s, root, comm)\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -70,8 +73,9 @@ int measure_reduce_sync(colltest_params_t *params, double *time)
     
     starttime = timeslot_startsync();
     rc = MPI_Reduce(mempool_alloc(sbufpool, sbufsize),
-                    mempool_alloc(rbufpool, sbufsize), params->count, MPI_DOUBLE,
-                    MPI_SUM, root, params->comm);
+                    mempool_alloc(rbufpool, sbufsize), params->count,
+                    reduceop_datatype(), reduceop_op(), params->root,
+                    params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
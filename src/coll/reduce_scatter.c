@@ -12,6 +12,7 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -29,8 +30,9 @@ int bench_reduce_scatter_init(colltest_params_t *params)
         return MPIPERF_FAILURE;
     }
 
-    sbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * sizeof(double) * params->nprocs,
+    sbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * reduceop_typesize() * params->nprocs,
                               mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
@@ -45,8 +47,8 @@ int bench_reduce_scatter_init(colltest_params_t *params)
         recvcounts[i * params->nprocs / (params->count % params->nprocs)]++;
     }
     MPI_Comm_rank(params->comm, &rank);
-    sbufsize = params->count * sizeof(double);
-    rbufsize = recvcounts[rank] * sizeof(double);
+    sbufsize = params->count * reduceop_typesize();
+    rbufsize = recvcounts[rank] * reduceop_typesize();
 
     return MPIPERF_SUCCESS;
 }
@@ -64,9 +66,10 @@ int bench_reduce_scatter_free()
 int bench_reduce_scatter_printinfo()
 {
     printf("* Reduce_scatter\n"
-           "  proto: MPI_Reduce_scatter(sbuf, rbuf, recvcounts, MPI_DOUBLE, \n"
-           "                            MPI_SUM, comm)\n"
-           "  Send buffer is divided onto equal parts and scattered among processes\n");
+           "  proto: MPI_Reduce_scatter(sbuf, rbuf, recvcounts, %s, \n"
+           "                            %s, comm)\n"
+           "  Send buffer is divided onto equal parts and scattered among processes\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -79,7 +82,7 @@ int measure_reduce_scatter_sync(colltest_params_t *params, double *time)
     starttime = timeslot_startsync();
     rc = MPI_Reduce_scatter(mempool_alloc(sbufpool, sbufsize),
                             mempool_alloc(rbufpool, rbufsize), recvcounts,
-                            MPI_DOUBLE, MPI_SUM, params->comm);
+                            reduceop_datatype(), reduceop_op(), params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
@@ -12,6 +12,7 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -20,16 +21,17 @@ static int sbufsize, rbufsize;
 /* bench_reduce_scatter_block_init: */
 int bench_reduce_scatter_block_init(colltest_params_t *params)
 {
-    sbufpool = mempool_create(params->count * sizeof(double) * params->nprocs,
+    sbufpool = mempool_create(params->count * reduceop_typesize() * params->nprocs,
+                              mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * reduceop_typesize(),
                               mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
         mempool_free(rbufpool);
         return MPIPERF_FAILURE;
     }
-    sbufsize = params->count * sizeof(double) * params->nprocs;
-    rbufsize = params->count * sizeof(double);
+    sbufsize = params->count * reduceop_typesize() * params->nprocs;
+    rbufsize = params->count * reduceop_typesize();
     return MPIPERF_SUCCESS;
 }
 
@@ -45,8 +47,9 @@ int bench_reduce_scatter_block_free()
 int bench_reduce_scatter_block_printinfo()
 {
     printf("* Reduce_scatter_block\n"
-           "  proto: MPI_Reduce_scatter_block(sbuf, rbuf, count, MPI_DOUBLE, \n"
-           "                                  MPI_SUM, comm)\n");
+           "  proto: MPI_Reduce_scatter_block(sbuf, rbuf, count, %s, \n"
+           "                                  %s, comm)\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -60,7 +63,7 @@ int measure_reduce_scatter_block_sync(colltest_params_t *params, double *time)
     starttime = timeslot_startsync();
     rc = MPI_Reduce_scatter_block(mempool_alloc(sbufpool, sbufsize),
                                   mempool_alloc(rbufpool, rbufsize), params->count,
-                                  MPI_DOUBLE, MPI_SUM, params->comm);
+                                  reduceop_datatype(), reduceop_op(), params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
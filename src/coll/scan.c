@@ -12,6 +12,7 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -20,15 +21,17 @@ static int sbufsize, rbufsize;
 /* bench_scan_init: */
 int bench_scan_init(colltest_params_t *params)
 {
-    sbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
+    sbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
         mempool_free(rbufpool);
         return MPIPERF_FAILURE;
     }
-    sbufsize = params->count * sizeof(double);
-    rbufsize = params->count * sizeof(double);
+    sbufsize = params->count * reduceop_typesize();
+    rbufsize = params->count * reduceop_typesize();
     return MPIPERF_SUCCESS;
 }
 
@@ -44,8 +47,9 @@ int bench_scan_free(collbench_t *bench)
 int bench_scan_printinfo()
 {
     printf("* Scan\n"
-           "  proto: MPI_Scan(sbuf, rbuf, count, MPI_DOUBLE, \n"
-           "                  MPI_SUM, comm)\n");
+           "  proto: MPI_Scan(sbuf, rbuf, count, %s, \n"
+           "                  %s, comm)\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -57,8 +61,8 @@ int measure_scan_sync(colltest_params_t *params, double *time)
     
     starttime = timeslot_startsync();
     rc = MPI_Scan(mempool_alloc(sbufpool, sbufsize),
-                  mempool_alloc(rbufpool, rbufsize), params->count, MPI_DOUBLE,
-                  MPI_SUM, params->comm);
+                  mempool_alloc(rbufpool, rbufsize), params->count,
+                  reduceop_datatype(), reduceop_op(), params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
@@ -12,11 +12,11 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
-static int root = 0;
 
 /* bench_scatter_init: */
 int bench_scatter_init(colltest_params_t *params)
@@ -27,7 +27,7 @@ int bench_scatter_init(colltest_params_t *params)
     sbufsize = 0;
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         sbufpool = mempool_create(params->count * params->nprocs, mpiperf_isflushcache);
         if (sbufpool == NULL) {
             return MPIPERF_FAILURE;
@@ -56,8 +56,7 @@ int bench_scatter_printinfo(collbench_t *bench)
 {
     printf("* Scatter\n"
            "  proto: MPI_Scatter(sbuf, count, MPI_BYTE, \n"
-           "                     rbuf, count, MPI_BYTE, %d, comm)\n",
-           root);
+           "                     rbuf, count, MPI_BYTE, root, comm)\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -70,7 +69,7 @@ int measure_scatter_sync(colltest_params_t *params, double *time)
     starttime = timeslot_startsync();
     rc = MPI_Scatter(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                      mempool_alloc(rbufpool, rbufsize), params->count, MPI_BYTE,
-                     root, params->comm);
+                     params->root, params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
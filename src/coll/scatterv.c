@@ -14,6 +14,7 @@
 #include "timeslot.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -21,7 +22,6 @@ static int *sendcounts = NULL;
 static int *displs = NULL;
 static int sbufsize;
 static int rbufsize;
-static int root = 0;
 
 /* bench_scatterv_init: */
 int bench_scatterv_init(colltest_params_t *params)
@@ -34,7 +34,7 @@ int bench_scatterv_init(colltest_params_t *params)
     displs = NULL;
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         sendcounts = malloc(sizeof(*sendcounts) * params->nprocs);
         displs = malloc(sizeof(*displs) * params->nprocs);
         if (sendcounts == NULL || displs == NULL) {
@@ -88,8 +88,8 @@ int bench_scatterv_printinfo()
 {
     printf("* Scatterv\n"
            "  proto: MPI_Scatterv(sbuf, sendcounts, displs, MPI_BYTE, \n"
-           "                      rbuf, count, MPI_BYTE, %d, comm)\n"
-           "  For each element: sendcounts[i] = count\n", root);
+           "                      rbuf, count, MPI_BYTE, root, comm)\n"
+           "  For each element: sendcounts[i] = count\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -102,7 +102,7 @@ int measure_scatterv_sync(colltest_params_t *params, double *time)
     starttime = timeslot_startsync();
     rc = MPI_Scatterv(mempool_alloc(sbufpool, sbufsize), sendcounts, displs,
                       MPI_BYTE, mempool_alloc(rbufpool, rbufsize), params->count,
-                      MPI_BYTE, root, params->comm);
+                      MPI_BYTE, params->root, params->comm);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
@@ -4,6 +4,12 @@
  * Copyright (C) 2010 Mikhail Kurnosov
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
 #include <mpi.h>
 
 #include "waitpattern.h"
@@ -11,6 +17,8 @@
 #include "mpiperf.h"
 #include "timeslot.h"
 #include "hpctimer.h"
+#include "logger.h"
+#include "util.h"
 
 static int rank;
 
@@ -124,3 +132,436 @@ int measure_waitpatternnull_sync(colltest_params_t *params, double *time)
     }
     return MEASURE_FAILURE;
 }
+
+/*
+ * OS noise benchmarks: every process runs <count> quanta of work at the same
+ * time (runs are started by synchronized clocks). In NoiseFWQ (fixed work
+ * quantum) the same work is done in each quantum and detour is the excess
+ * of quantum time over the minimal one. In NoiseFTQ (fixed time quantum)
+ * work is counted in each quantum of NOISE_QUANTUM sec. and detour is the
+ * fraction of the quantum lost with respect to the maximal count. FTQ quanta
+ * are aligned in global time, so detour series of processes of a node
+ * are correlated quantum by quantum.
+ *
+ * Quanta of all runs are kept until the end of test: baseline (minimal time
+ * or maximal count) is fixed by calibration and warmup stage, and only
+ * correct runs of measured stages are added to the spectrum.
+ */
+
+enum {
+    NOISE_FWQ = 0,
+    NOISE_FTQ = 1,
+    NOISE_NBINS = 20,               /* Bins of detours: [2^b, 2^(b+1)) usec */
+    NOISE_CALIB_NQUANTA = 64,
+    NOISE_FTQ_UNIT = 64             /* Iterations between timer reads */
+};
+
+#define NOISE_QUANTUM 1E-4
+#define NOISE_DETOUR_MIN 1E-6
+
+/* Per process summary gathered to master */
+typedef struct {
+    int node;                       /* The lowest rank of the node */
+    int nruns;
+    double time;                    /* Total time of quanta */
+    double ndetours[NOISE_NBINS];
+    double detourtime;
+    double maxdetour;
+    double corr;                    /* Sum of correlations with the node */
+    int ncorr;
+} noise_stat_t;
+
+static volatile double noise_sink = 1.0;
+static int noise_mode = NOISE_FWQ;
+static int noise_fwq_niters = 0;    /* Iterations in FWQ quantum */
+static double noise_fwq_mintime = 0.0;
+static double noise_ftq_maxcount = 0.0;
+static double *noise_quanta = NULL; /* Quanta of runs: run i at i * nquanta */
+static int *noise_runrc = NULL;
+static int noise_nruns = 0, noise_nruns_alloc = 0;
+static int noise_nquanta = 0;
+static MPI_Comm noise_comm = MPI_COMM_NULL;
+static MPI_Comm noise_nodecomm = MPI_COMM_NULL;
+static int noise_nodesize = 1;
+static int noise_nprocs = 0, noise_count = 0;
+static noise_stat_t noise_stat;
+static noise_stat_t *noise_allstat = NULL;  /* Summaries on master */
+
+static void noise_work(int niters);
+static void noise_calibrate();
+static int noise_init(colltest_params_t *params, int mode);
+static double *noise_nextrun();
+static void noise_accumulate();
+static void noise_correlate(int nwarmup);
+
+/* bench_noisefwq_init: */
+int bench_noisefwq_init(colltest_params_t *params)
+{
+    return noise_init(params, NOISE_FWQ);
+}
+
+/* bench_noiseftq_init: */
+int bench_noiseftq_init(colltest_params_t *params)
+{
+    return noise_init(params, NOISE_FTQ);
+}
+
+/*
+ * bench_noise_free: Computes spectrum of correct runs and gathers
+ *                   summaries of processes to master.
+ */
+int bench_noise_free()
+{
+    noise_accumulate();
+    if (IS_MASTER_RANK)
+        noise_allstat = xmalloc(sizeof(*noise_allstat) * noise_nprocs);
+    MPI_Gather(&noise_stat, sizeof(noise_stat), MPI_BYTE, noise_allstat,
+               sizeof(noise_stat), MPI_BYTE, mpiperf_master_rank, noise_comm);
+
+    if (noise_nodecomm != MPI_COMM_NULL)
+        MPI_Comm_free(&noise_nodecomm);
+    free(noise_quanta);
+    free(noise_runrc);
+    noise_quanta = NULL;
+    noise_runrc = NULL;
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * bench_noise_report: Prints noise spectrum of each process (one line
+ *                     per process) after result of test.
+ */
+int bench_noise_report()
+{
+    noise_stat_t *stats = noise_allstat;
+    const char *unit;
+    double timescale, ndetours, freq;
+    int i, b;
+
+    if (!IS_MASTER_RANK || stats == NULL)
+        return MPIPERF_SUCCESS;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        unit = "sec.";
+        timescale = 1.0;
+    } else {
+        unit = "usec";
+        timescale = 1E6;
+    }
+    for (i = 0; i < noise_nprocs; i++) {
+        ndetours = 0.0;
+        for (b = 0; b < NOISE_NBINS; b++)
+            ndetours += stats[i].ndetours[b];
+        if (stats[i].time <= 0.0)
+            continue;
+        printf("# Noise %s: procs %d, count %d, rank %d, node %d, runs %d, "
+               "detours %.1f Hz, noise %.4f%%, mean %.2f %s, max %.2f %s, ",
+               (noise_mode == NOISE_FWQ) ? "FWQ" : "FTQ",
+               noise_nprocs, noise_count, i, stats[i].node, stats[i].nruns,
+               ndetours / stats[i].time,
+               stats[i].detourtime / stats[i].time * 100.0,
+               (ndetours > 0.0) ? stats[i].detourtime / ndetours * timescale : 0.0,
+               unit, stats[i].maxdetour * timescale, unit);
+        if (stats[i].ncorr > 0)
+            printf("node corr %.2f, ", stats[i].corr / stats[i].ncorr);
+        else
+            printf("node corr -, ");
+        printf("spectrum [usec:Hz]");
+        for (b = 0; b < NOISE_NBINS; b++) {
+            if (stats[i].ndetours[b] > 0) {
+                freq = stats[i].ndetours[b] / stats[i].time;
+                printf(" %d:%.1f", 1 << b, freq);
+            }
+        }
+        printf("\n");
+    }
+    free(noise_allstat);
+    noise_allstat = NULL;
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_noisefwq_printinfo: */
+int bench_noisefwq_printinfo()
+{
+    printf("* NoiseFWQ\n"
+           "  proto: NoiseFWQ(comm, count)\n"
+           "  Description: each process runs <count> fixed work quanta (%.0f usec)\n"
+           "  and reports frequency and magnitude of detours (OS noise).\n",
+           NOISE_QUANTUM * 1E6);
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_noisefwq_sync: */
+int measure_noisefwq_sync(colltest_params_t *params, double *time)
+{
+    double starttime, endtime, t, *quanta;
+    int i, rc = MEASURE_FAILURE;
+
+    quanta = noise_nextrun();
+    starttime = timeslot_startsync();
+    for (i = 0; i < noise_nquanta; i++) {
+        t = hpctimer_wtime();
+        noise_work(noise_fwq_niters);
+        quanta[i] = hpctimer_wtime() - t;
+    }
+    endtime = timeslot_stopsync();
+
+    if ((starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        rc = MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        rc = MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        rc = MEASURE_TIME_TOOLONG;
+    }
+    noise_runrc[noise_nruns - 1] = rc;
+    return rc;
+}
+
+/* bench_noiseftq_printinfo: */
+int bench_noiseftq_printinfo()
+{
+    printf("* NoiseFTQ\n"
+           "  proto: NoiseFTQ(comm, count)\n"
+           "  Description: each process counts work in <count> fixed time quanta (%.0f usec)\n"
+           "  and reports frequency and magnitude of detours (OS noise).\n"
+           "  Expected benchmark time is <count> * %.0f usec.\n",
+           NOISE_QUANTUM * 1E6, NOISE_QUANTUM * 1E6);
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_noiseftq_sync: */
+int measure_noiseftq_sync(colltest_params_t *params, double *time)
+{
+    double starttime, endtime, t, deadline, *quanta;
+    int i, n, rc = MEASURE_FAILURE;
+
+    quanta = noise_nextrun();
+    starttime = timeslot_startsync();
+    t = hpctimer_wtime();
+    for (i = 0; i < noise_nquanta; i++) {
+        deadline = t + (i + 1) * NOISE_QUANTUM;
+        for (n = 0; hpctimer_wtime() < deadline; n++)
+            noise_work(NOISE_FTQ_UNIT);
+        quanta[i] = n;
+    }
+    endtime = timeslot_stopsync();
+
+    if ((starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        rc = MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        rc = MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        rc = MEASURE_TIME_TOOLONG;
+    }
+    noise_runrc[noise_nruns - 1] = rc;
+    return rc;
+}
+
+/* noise_work: */
+static void noise_work(int niters)
+{
+    double x = noise_sink;
+    int i;
+
+    for (i = 0; i < niters; i++)
+        x = x * 0.999999 + 1E-6;
+    noise_sink = x;
+}
+
+/*
+ * noise_calibrate: Finds number of iterations in FWQ quantum and
+ *                  initial estimates of the minimal quantum time and
+ *                  the maximal FTQ count.
+ */
+static void noise_calibrate()
+{
+    double t, deadline;
+    int i, n;
+
+    for (n = NOISE_FTQ_UNIT; ; n *= 2) {
+        t = hpctimer_wtime();
+        noise_work(n);
+        t = hpctimer_wtime() - t;
+        if (t >= NOISE_QUANTUM / 4)
+            break;
+    }
+    noise_fwq_niters = (int)(n * NOISE_QUANTUM / t) + 1;
+
+    noise_fwq_mintime = DBL_MAX;
+    for (i = 0; i < NOISE_CALIB_NQUANTA; i++) {
+        t = hpctimer_wtime();
+        noise_work(noise_fwq_niters);
+        t = hpctimer_wtime() - t;
+        if (t < noise_fwq_mintime)
+            noise_fwq_mintime = t;
+    }
+
+    noise_ftq_maxcount = 0.0;
+    t = hpctimer_wtime();
+    for (i = 0; i < NOISE_CALIB_NQUANTA; i++) {
+        deadline = t + (i + 1) * NOISE_QUANTUM;
+        for (n = 0; hpctimer_wtime() < deadline; n++)
+            noise_work(NOISE_FTQ_UNIT);
+        if (n > noise_ftq_maxcount)
+            noise_ftq_maxcount = n;
+    }
+    logger_log("Noise quantum is calibrated: FWQ %d iterations (%.9f sec.), FTQ max count %.0f",
+               noise_fwq_niters, noise_fwq_mintime, noise_ftq_maxcount);
+}
+
+/* noise_init: */
+static int noise_init(colltest_params_t *params, int mode)
+{
+    int noderank;
+
+    MPI_Comm_rank(params->comm, &rank);
+    noise_mode = mode;
+    noise_comm = params->comm;
+    noise_nprocs = params->nprocs;
+    noise_count = params->count;
+    noise_nquanta = (params->count > 0) ? params->count : 1;
+    noise_nruns = 0;
+    noise_nruns_alloc = 0;
+
+    memset(&noise_stat, 0, sizeof(noise_stat));
+    noise_stat.node = rank;
+    noise_nodesize = 1;
+#if MPI_VERSION >= 3
+    MPI_Comm_split_type(params->comm, MPI_COMM_TYPE_SHARED, 0,
+                        MPI_INFO_NULL, &noise_nodecomm);
+    MPI_Comm_size(noise_nodecomm, &noise_nodesize);
+    MPI_Comm_rank(noise_nodecomm, &noderank);
+    noise_stat.node = (noderank == 0) ? rank : 0;
+    MPI_Bcast(&noise_stat.node, 1, MPI_INT, 0, noise_nodecomm);
+#endif
+
+    if (noise_fwq_niters == 0)
+        noise_calibrate();
+    return MPIPERF_SUCCESS;
+}
+
+/* noise_nextrun: Returns buffer for quanta of the next run. */
+static double *noise_nextrun()
+{
+    if (noise_nruns == noise_nruns_alloc) {
+        noise_nruns_alloc = (noise_nruns_alloc > 0) ?
+                            noise_nruns_alloc * 2 : mpiperf_nruns_max;
+        noise_quanta = xrealloc(noise_quanta, sizeof(*noise_quanta) *
+                                noise_nquanta * noise_nruns_alloc);
+        noise_runrc = xrealloc(noise_runrc, sizeof(*noise_runrc) *
+                               noise_nruns_alloc);
+    }
+    noise_runrc[noise_nruns] = MEASURE_FAILURE;
+    return noise_quanta + (size_t)noise_nquanta * noise_nruns++;
+}
+
+/*
+ * noise_accumulate: Fixes baseline by warmup runs, converts quanta of correct
+ *                   measured runs to detours and adds them to the spectrum.
+ *                   Collective operation on all processes of test.
+ */
+static void noise_accumulate()
+{
+    double d, *quanta;
+    int i, r, b, nwarmup;
+
+    /* Runs of warmup stage (synctime) or the warmup run (nosync) */
+    nwarmup = (mpiperf_synctype == SYNC_TIME) ? TEST_STAGE_NRUNS_INIT : 1;
+    if (nwarmup > noise_nruns)
+        nwarmup = noise_nruns;
+
+    /* Run is correct if it is correct on all processes (as in driver) */
+    if (mpiperf_synctype == SYNC_TIME) {
+        MPI_Allreduce(MPI_IN_PLACE, noise_runrc, noise_nruns, MPI_INT, MPI_MAX,
+                      noise_comm);
+    } else {
+        for (r = 0; r < noise_nruns; r++)
+            noise_runrc[r] = MEASURE_SUCCESS;
+    }
+
+    for (i = 0; i < nwarmup * noise_nquanta; i++) {
+        if (noise_mode == NOISE_FWQ)
+            noise_fwq_mintime = stat_fmin2(noise_fwq_mintime, noise_quanta[i]);
+        else
+            noise_ftq_maxcount = stat_fmax2(noise_ftq_maxcount, noise_quanta[i]);
+    }
+
+    for (r = nwarmup; r < noise_nruns; r++) {
+        quanta = noise_quanta + (size_t)noise_nquanta * r;
+        if (noise_runrc[r] != MEASURE_SUCCESS) {
+            for (i = 0; i < noise_nquanta; i++)
+                quanta[i] = 0.0;
+            continue;
+        }
+        for (i = 0; i < noise_nquanta; i++) {
+            if (noise_mode == NOISE_FWQ) {
+                noise_stat.time += quanta[i];
+                d = quanta[i] - noise_fwq_mintime;
+            } else {
+                noise_stat.time += NOISE_QUANTUM;
+                d = (noise_ftq_maxcount - quanta[i]) / noise_ftq_maxcount *
+                    NOISE_QUANTUM;
+            }
+            if (d < NOISE_DETOUR_MIN)
+                d = 0.0;
+            quanta[i] = d;
+            if (d > 0.0) {
+                b = (int)(log(d / NOISE_DETOUR_MIN) / log(2.0));
+                b = (b < NOISE_NBINS) ? b : NOISE_NBINS - 1;
+                noise_stat.ndetours[b] += 1.0;
+                noise_stat.detourtime += d;
+                if (d > noise_stat.maxdetour)
+                    noise_stat.maxdetour = d;
+            }
+        }
+        noise_stat.nruns++;
+    }
+
+    if (noise_nodesize > 1)
+        noise_correlate(nwarmup);
+}
+
+/*
+ * noise_correlate: Adds Pearson correlation of detours of each correct run
+ *                  with mean detours of the other processes of the node.
+ */
+static void noise_correlate(int nwarmup)
+{
+    double *nodesum, *x, *sum, mean_x, mean_y, sxx, syy, sxy, y;
+    int i, r, n;
+
+    n = (noise_nruns - nwarmup) * noise_nquanta;
+    if (n <= 0)
+        return;
+    nodesum = xmalloc(sizeof(*nodesum) * n);
+    MPI_Allreduce(noise_quanta + (size_t)noise_nquanta * nwarmup, nodesum, n,
+                  MPI_DOUBLE, MPI_SUM, noise_nodecomm);
+
+    for (r = nwarmup; r < noise_nruns; r++) {
+        if (noise_runrc[r] != MEASURE_SUCCESS)
+            continue;
+        x = noise_quanta + (size_t)noise_nquanta * r;
+        sum = nodesum + (size_t)noise_nquanta * (r - nwarmup);
+        mean_x = mean_y = 0.0;
+        for (i = 0; i < noise_nquanta; i++) {
+            mean_x += x[i];
+            mean_y += (sum[i] - x[i]) / (noise_nodesize - 1);
+        }
+        mean_x /= noise_nquanta;
+        mean_y /= noise_nquanta;
+        sxx = syy = sxy = 0.0;
+        for (i = 0; i < noise_nquanta; i++) {
+            y = (sum[i] - x[i]) / (noise_nodesize - 1);
+            sxx += (x[i] - mean_x) * (x[i] - mean_x);
+            syy += (y - mean_y) * (y - mean_y);
+            sxy += (x[i] - mean_x) * (y - mean_y);
+        }
+        if (sxx > 0.0 && syy > 0.0) {
+            noise_stat.corr += sxy / sqrt(sxx * syy);
+            noise_stat.ncorr++;
+        }
+    }
+    free(nodesum);
+}
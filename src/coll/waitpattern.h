@@ -23,4 +23,19 @@ int measure_waitpatterndown_sync(colltest_params_t *params, double *time);
 int bench_waitpatternnull_printinfo();
 int measure_waitpatternnull_sync(colltest_params_t *params, double *time);
 
+/*
+ * OS noise benchmarks: fixed work quantum (FWQ) and fixed time
+ * quantum (FTQ) loops of <count> quanta started at the same time.
+ */
+int bench_noisefwq_init(colltest_params_t *params);
+int bench_noiseftq_init(colltest_params_t *params);
+int bench_noise_free();
+int bench_noise_report();
+
+int bench_noisefwq_printinfo();
+int measure_noisefwq_sync(colltest_params_t *params, double *time);
+
+int bench_noiseftq_printinfo();
+int measure_noiseftq_sync(colltest_params_t *params, double *time);
+
 #endif /* WAITPATTERN_H */
@@ -0,0 +1,418 @@
+/*
+ * compare.c: Statistical comparison of two mpiperf reports.
+ *
+ * Reports are read by names of columns in table header ("# [Procs] ...").
+ * Point of report is identified by key columns (Procs, Count and Rank,
+ * Root, Pair, Thread, K if they are present), its time is Mean (or Total),
+ * standard error is StdErr and size of sample is FRuns (or CRuns, TRuns).
+ * Reports contain no samples of runs, so the test is Welch's t-test for
+ * means of samples with unequal variances.
+ *
+ * Values of report are rounded (StdErr of sub-microsecond operations is
+ * printed as 0.00), so standard error is also recovered from Err, CI LB/UB
+ * (t_student * StdErr) and RSE * Mean, and the most precise of them is used.
+ * It is increased by its rounding error, so rounding never makes difference
+ * significant. Standard error which is zero or is known with relative
+ * error above COMPARE_SE_RELERR_MAX is unknown: verdict of point is '-'.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "compare.h"
+#include "mpiperf.h"
+#include "stat.h"
+#include "util.h"
+#include "version.h"
+
+enum {
+    COMPARE_LINE_MAX = 4096,
+    COMPARE_NCOLUMNS_MAX = 64,
+    COMPARE_NAME_MAX = 32,
+    COMPARE_NKEYS = 7
+};
+
+#define COMPARE_SE_RELERR_MAX 0.1
+
+/* Key columns of points (Procs and Count are always present) */
+static const char *compare_keynames[COMPARE_NKEYS] = {
+    "Procs", "Count", "Rank", "Root", "Pair", "Thread", "K"
+};
+
+typedef struct {
+    int key[COMPARE_NKEYS];
+    double mean;
+    double stderr_mean;     /* < 0 if it is unknown */
+    int n;
+} compare_point_t;
+
+typedef struct {
+    char benchname[COMPARE_LINE_MAX];
+    double timescale;       /* Seconds in unit of time */
+    double level;           /* Confidence level of Err, 0 if it is unknown */
+    int haskey[COMPARE_NKEYS];
+    compare_point_t *points;
+    int npoints;
+} compare_report_t;
+
+static int compare_read_report(const char *filename, compare_report_t *report);
+static int compare_parse_header(const char *line, char names[][COMPARE_NAME_MAX]);
+static int compare_column(char names[][COMPARE_NAME_MAX], int ncols,
+                          const char *name);
+static double compare_rounding(const char *tok);
+static void compare_stderr_candidate(double se, double err, double *best,
+                                     double *besterr);
+static compare_point_t *compare_lookup(compare_report_t *report,
+                                       compare_point_t *point);
+static void compare_format_id(compare_report_t *report, compare_point_t *point,
+                              char *buf, size_t size);
+
+/* compare_reports: */
+int compare_reports(const char *basefile, const char *newfile,
+                    double level, double threshold)
+{
+    compare_report_t base, new;
+    compare_point_t *p, *q;
+    const char *fmt, *verdict;
+    char id[COMPARE_LINE_MAX];
+    double scale, mean, se, diff, var, df, t, pvalue, change, err;
+    int i, nregressions = 0, nfaster = 0, nslower = 0, nunmatched = 0;
+
+    if (compare_read_report(basefile, &base) == MPIPERF_FAILURE)
+        return -1;
+    if (compare_read_report(newfile, &new) == MPIPERF_FAILURE) {
+        free(base.points);
+        return -1;
+    }
+
+    printf("# mpiperf %d.%d.%d comparison report\n", MPIPERF_VERSION_MAJOR,
+           MPIPERF_VERSION_MINOR, MPIPERF_VERSION_PATCH);
+    printf("# Baseline report: %s (benchmark %s)\n", basefile, base.benchname);
+    printf("# New report: %s (benchmark %s)\n", newfile, new.benchname);
+    printf("# Test: Welch's t-test of means, confidence level %g%%\n", level);
+    printf("# Regression threshold: %g%%\n", threshold);
+    printf("# Time scale: %s\n", (base.timescale == 1.0) ? "seconds" : "microseconds");
+    printf("#\n");
+    printf("#   Id - values of Rank, Root, Pair, Thread or K columns (if any)\n");
+    printf("#   Base, New - mean time of point in baseline and new reports\n");
+    printf("#   Change - relative change of time: (New - Base) / Base\n");
+    printf("#   Speedup - Base / New\n");
+    printf("#   Diff LB, Diff UB - confidence interval of New - Base\n");
+    printf("#   P-value - two-sided p-value of Welch's t-test\n");
+    printf("#   Verdict - same, faster, slower or REGRESSION (slower by more than threshold),\n");
+    printf("#     '-' if standard error is not reported or is below precision of report\n");
+    printf("#\n");
+    if (base.timescale == 1.0) {
+        printf("# [Procs] [Count]     [Id]     [Base]       [New]        [Change%%]  [Speedup]  [Diff LB]    [Diff UB]    [P-value]  [Verdict]\n");
+        fmt = "  %-7d %-11d %-8s %-12.6f %-12.6f %-10.2f %-10.3f %-12.6f %-12.6f %-10.4f %s\n";
+    } else {
+        printf("# [Procs] [Count]     [Id]     [Base]         [New]          [Change%%]  [Speedup]  [Diff LB]      [Diff UB]      [P-value]  [Verdict]\n");
+        fmt = "  %-7d %-11d %-8s %-14.2f %-14.2f %-10.2f %-10.3f %-14.2f %-14.2f %-10.4f %s\n";
+    }
+    printf("#\n");
+
+    /* Times of new report are converted to time scale of baseline report */
+    scale = new.timescale / base.timescale;
+    for (i = 0; i < new.npoints; i++) {
+        q = &new.points[i];
+        if ( (p = compare_lookup(&base, q)) == NULL) {
+            nunmatched++;
+            continue;
+        }
+        mean = q->mean * scale;
+        se = q->stderr_mean * scale;
+        diff = mean - p->mean;
+        change = (p->mean > 0.0) ? diff / p->mean * 100.0 : 0.0;
+        compare_format_id(&new, q, id, sizeof(id));
+
+        if (p->stderr_mean < 0.0 || se < 0.0 || p->n < 2 || q->n < 2) {
+            printf(fmt, q->key[0], q->key[1], id, p->mean, mean, change,
+                   (mean > 0.0) ? p->mean / mean : 0.0, diff, diff, 1.0, "-");
+            continue;
+        }
+
+        /* Welch-Satterthwaite degrees of freedom */
+        var = p->stderr_mean * p->stderr_mean + se * se;
+        if (var <= 0.0) {
+            printf(fmt, q->key[0], q->key[1], id, p->mean, mean, change,
+                   (mean > 0.0) ? p->mean / mean : 0.0, diff, diff, 1.0, "-");
+            continue;
+        }
+        df = var * var / (pow(p->stderr_mean, 4) / (p->n - 1) +
+                          pow(se, 4) / (q->n - 1));
+        t = diff / sqrt(var);
+        pvalue = stat_tstud_pvalue(t, df);
+        err = stat_tstud_quantile(level / 100.0, (int)df > 0 ? (int)df : 1) *
+              sqrt(var);
+
+        if (pvalue >= 1.0 - level / 100.0) {
+            verdict = "same";
+        } else if (diff < 0.0) {
+            verdict = "faster";
+            nfaster++;
+        } else if (change > threshold) {
+            verdict = "REGRESSION";
+            nregressions++;
+        } else {
+            verdict = "slower";
+            nslower++;
+        }
+        printf(fmt, q->key[0], q->key[1], id, p->mean, mean, change,
+               (mean > 0.0) ? p->mean / mean : 0.0, diff - err, diff + err,
+               pvalue, verdict);
+    }
+
+    printf("#\n");
+    printf("# Faster: %d, slower: %d, regressions: %d, points without baseline: %d\n",
+           nfaster, nslower, nregressions, nunmatched);
+
+    free(base.points);
+    free(new.points);
+    return nregressions;
+}
+
+/* compare_read_report: Reads points of all tables of report. */
+static int compare_read_report(const char *filename, compare_report_t *report)
+{
+    FILE *fin;
+    char line[COMPARE_LINE_MAX];
+    char names[COMPARE_NCOLUMNS_MAX][COMPARE_NAME_MAX];
+    char *tok, *end;
+    double values[COMPARE_NCOLUMNS_MAX], rounding[COMPARE_NCOLUMNS_MAX];
+    double tcrit, se, seerr;
+    int keycol[COMPARE_NKEYS];
+    int i, ncols = 0, nvalues, meancol = -1, stderrcol = -1, rsecol = -1;
+    int errcol = -1, lbcol = -1, ubcol = -1, ncol = -1, nalloc = 0;
+    compare_point_t *point;
+
+    if ( (fin = fopen(filename, "r")) == NULL) {
+        print_error("Can't open report file: %s", filename);
+        return MPIPERF_FAILURE;
+    }
+
+    strcpy(report->benchname, "-");
+    report->timescale = 1E-6;
+    report->level = 0.0;
+    report->points = NULL;
+    report->npoints = 0;
+    for (i = 0; i < COMPARE_NKEYS; i++)
+        report->haskey[i] = 0;
+
+    while (fgets(line, sizeof(line), fin) != NULL) {
+        if (line[0] == '#') {
+            if (sscanf(line, "# Benchmark: %s", report->benchname) == 1)
+                continue;
+            if (sscanf(line, "# Confidence level (CL): %lf", &report->level) == 1)
+                continue;
+            if (strncmp(line, "# Time scale: seconds", 21) == 0)
+                report->timescale = 1.0;
+            else if (strncmp(line, "# Time scale: microseconds", 26) == 0)
+                report->timescale = 1E-6;
+
+            if (strncmp(line, "# [", 3) == 0) {
+                ncols = compare_parse_header(line, names);
+                for (i = 0; i < COMPARE_NKEYS; i++) {
+                    keycol[i] = compare_column(names, ncols, compare_keynames[i]);
+                    if (keycol[i] >= 0)
+                        report->haskey[i] = 1;
+                }
+                if ( (meancol = compare_column(names, ncols, "Mean")) < 0)
+                    meancol = compare_column(names, ncols, "Total");
+                stderrcol = compare_column(names, ncols, "StdErr");
+                rsecol = compare_column(names, ncols, "RSE");
+                errcol = compare_column(names, ncols, "Err");
+                lbcol = compare_column(names, ncols, "CI LB");
+                ubcol = compare_column(names, ncols, "CI UB");
+                if ( (ncol = compare_column(names, ncols, "FRuns")) < 0) {
+                    if ( (ncol = compare_column(names, ncols, "CRuns")) < 0)
+                        ncol = compare_column(names, ncols, "TRuns");
+                }
+            }
+            continue;
+        }
+        if (ncols == 0 || keycol[0] < 0 || keycol[1] < 0 || meancol < 0)
+            continue;
+
+        /* Data line: non-numeric values (State, '-') are NAN */
+        nvalues = 0;
+        for (tok = strtok(line, " \t\n"); tok && nvalues < ncols;
+             tok = strtok(NULL, " \t\n"))
+        {
+            values[nvalues] = strtod(tok, &end);
+            if (end == tok || *end != '\0')
+                values[nvalues] = NAN;
+            rounding[nvalues] = compare_rounding(tok);
+            nvalues++;
+        }
+        if (nvalues <= meancol || isnan(values[meancol]) ||
+            isnan(values[keycol[0]]) || isnan(values[keycol[1]]))
+        {
+            continue;
+        }
+
+        if (report->npoints == nalloc) {
+            nalloc = (nalloc > 0) ? nalloc * 2 : 64;
+            report->points = xrealloc(report->points,
+                                      sizeof(*report->points) * nalloc);
+        }
+        point = &report->points[report->npoints++];
+        for (i = 0; i < COMPARE_NKEYS; i++) {
+            point->key[i] = (keycol[i] >= 0 && keycol[i] < nvalues &&
+                             !isnan(values[keycol[i]])) ?
+                            (int)values[keycol[i]] : -1;
+        }
+        point->mean = values[meancol];
+        point->n = (ncol >= 0 && ncol < nvalues && !isnan(values[ncol])) ?
+                   (int)values[ncol] : 0;
+
+        /* The most precise estimate of standard error and its rounding error */
+        se = -1.0;
+        seerr = 0.0;
+        if (stderrcol >= 0 && stderrcol < nvalues && !isnan(values[stderrcol]))
+            compare_stderr_candidate(values[stderrcol], rounding[stderrcol],
+                                     &se, &seerr);
+        if (rsecol >= 0 && rsecol < nvalues && !isnan(values[rsecol])) {
+            compare_stderr_candidate(values[rsecol] * point->mean,
+                                     rounding[rsecol] * point->mean, &se, &seerr);
+        }
+        if (report->level > 0.0 && report->level < 100.0 && point->n > 1) {
+            tcrit = stat_tstud_quantile(report->level / 100.0, point->n - 1);
+            if (errcol >= 0 && errcol < nvalues && !isnan(values[errcol])) {
+                compare_stderr_candidate(values[errcol] / tcrit,
+                                         rounding[errcol] / tcrit, &se, &seerr);
+            }
+            if (lbcol >= 0 && lbcol < nvalues && !isnan(values[lbcol]) &&
+                ubcol >= 0 && ubcol < nvalues && !isnan(values[ubcol]))
+            {
+                compare_stderr_candidate(
+                    (values[ubcol] - values[lbcol]) / (2.0 * tcrit),
+                    (rounding[ubcol] + rounding[lbcol]) / (2.0 * tcrit),
+                    &se, &seerr);
+            }
+        }
+        if (se > 0.0 && seerr <= COMPARE_SE_RELERR_MAX * se)
+            point->stderr_mean = se + seerr;
+        else
+            point->stderr_mean = -1.0;
+    }
+    fclose(fin);
+
+    if (report->npoints == 0) {
+        print_error("No measurements in report file: %s", filename);
+        free(report->points);
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * compare_parse_header: Splits header "# [Procs] [Count] [CI LB] ..."
+ *                       into names of columns. Returns number of columns.
+ */
+static int compare_parse_header(const char *line, char names[][COMPARE_NAME_MAX])
+{
+    const char *p, *q;
+    int ncols = 0;
+    size_t len;
+
+    for (p = strchr(line, '['); p && ncols < COMPARE_NCOLUMNS_MAX;
+         p = strchr(q, '['))
+    {
+        if ( (q = strchr(p, ']')) == NULL)
+            break;
+        len = q - p - 1;
+        if (len >= COMPARE_NAME_MAX)
+            len = COMPARE_NAME_MAX - 1;
+        memcpy(names[ncols], p + 1, len);
+        names[ncols][len] = '\0';
+        ncols++;
+    }
+    return ncols;
+}
+
+/* compare_column: Returns index of column or -1. */
+static int compare_column(char names[][COMPARE_NAME_MAX], int ncols,
+                          const char *name)
+{
+    int i;
+
+    for (i = 0; i < ncols; i++) {
+        if (strcmp(names[i], name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * compare_rounding: Returns rounding error of printed number: half of unit
+ *                   in the last digit ("0.17" -> 0.005, "1.5e-07" -> 5e-09).
+ */
+static double compare_rounding(const char *tok)
+{
+    const char *p;
+    int ndigits = 0, exp = 0;
+
+    if ( (p = strchr(tok, '.')) != NULL) {
+        for (p++; *p >= '0' && *p <= '9'; p++)
+            ndigits++;
+    } else {
+        for (p = tok; *p && *p != 'e' && *p != 'E'; p++);
+    }
+    if (*p == 'e' || *p == 'E')
+        exp = atoi(p + 1);
+    return 0.5 * pow(10.0, exp - ndigits);
+}
+
+/*
+ * compare_stderr_candidate: Replaces the best estimate of standard error
+ *                           by se if its relative rounding error is smaller.
+ */
+static void compare_stderr_candidate(double se, double err, double *best,
+                                     double *besterr)
+{
+    if (se <= 0.0)
+        return;
+    if (*best <= 0.0 || err / se < *besterr / *best) {
+        *best = se;
+        *besterr = err;
+    }
+}
+
+/* compare_lookup: Returns point of report with the same keys. */
+static compare_point_t *compare_lookup(compare_report_t *report,
+                                       compare_point_t *point)
+{
+    int i, k;
+
+    for (i = 0; i < report->npoints; i++) {
+        for (k = 0; k < COMPARE_NKEYS; k++) {
+            if (report->points[i].key[k] != point->key[k])
+                break;
+        }
+        if (k == COMPARE_NKEYS)
+            return &report->points[i];
+    }
+    return NULL;
+}
+
+/* compare_format_id: Formats values of extra key columns: "3", "0:1", "-". */
+static void compare_format_id(compare_report_t *report, compare_point_t *point,
+                              char *buf, size_t size)
+{
+    size_t len = 0;
+    int k;
+
+    buf[0] = '\0';
+    for (k = 2; k < COMPARE_NKEYS && len + 1 < size; k++) {
+        if (!report->haskey[k])
+            continue;
+        len += snprintf(buf + len, size - len, (len > 0) ? ":%d" : "%d",
+                        point->key[k]);
+    }
+    if (len == 0)
+        snprintf(buf, size, "-");
+}
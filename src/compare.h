@@ -0,0 +1,22 @@
+/*
+ * compare.h: Statistical comparison of two mpiperf reports.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#define COMPARE_THRESHOLD_DEFAULT 5.0
+
+/*
+ * compare_reports: Compares times of points (nprocs, count, ...) of new
+ *                  report with baseline report by Welch's t-test
+ *                  on confidence level (in percents) and prints table
+ *                  of changes. Returns number of significant regressions
+ *                  greater than threshold (in percents) or -1 on error.
+ */
+int compare_reports(const char *basefile, const char *newfile,
+                    double level, double threshold);
+
+#endif /* COMPARE_H */
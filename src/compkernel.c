@@ -0,0 +1,230 @@
+/*
+ * compkernel.c: Compute kernels for NBC overlap measurement.
+ *
+ * The amount of work is fixed for requested compute time: number of kernel
+ * units is computed by time of unit measured at initialization. So if
+ * communications compete with kernel for memory bandwidth, real compute
+ * time becomes greater than requested one and overlap decreases.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "compkernel.h"
+#include "mpiperf.h"
+#include "hpctimer.h"
+#include "logger.h"
+#include "util.h"
+
+enum {
+    TRIAD_SIZE_DEFAULT = 16384,     /* KB per array (out of caches) */
+    TRIAD_CHUNK = 4096,             /* Elements per unit */
+    FMA_SIZE_DEFAULT = 16,          /* KB (L1-resident) */
+    FMA_NREPEATS = 16,              /* Passes over array per unit */
+    DGEMM_SIZE_DEFAULT = 256,       /* Order of matrices */
+    DGEMM_BLOCK = 32                /* Unit is a product of two blocks */
+};
+
+#define CALIBRATION_TIME 0.05
+#define TRIAD_SCALAR 3.0
+
+static int compkernel = COMPKERNEL_WAIT;
+static int compkernel_size = 0;
+static double compkernel_unittime = 0.0;
+
+static double *a = NULL, *b = NULL, *c = NULL;
+static int nelems = 0;
+static int pos = 0;
+static int nblocks = 0;
+static int blk_i = 0, blk_j = 0, blk_k = 0;
+
+static void compkernel_triad_unit();
+static void compkernel_fma_unit();
+static void compkernel_dgemm_unit();
+
+/* compkernel_parse: */
+int compkernel_parse(const char *s, int *kernel, int *size)
+{
+    const char *p;
+
+    *size = 0;
+    if (strcasecmp(s, "wait") == 0) {
+        *kernel = COMPKERNEL_WAIT;
+        return MPIPERF_SUCCESS;
+    } else if (strncasecmp(s, "triad", 5) == 0) {
+        *kernel = COMPKERNEL_TRIAD;
+    } else if (strncasecmp(s, "fma", 3) == 0) {
+        *kernel = COMPKERNEL_FMA;
+    } else if (strncasecmp(s, "dgemm", 5) == 0) {
+        *kernel = COMPKERNEL_DGEMM;
+    } else {
+        return MPIPERF_FAILURE;
+    }
+    if ( (p = strchr(s, ':')) != NULL) {
+        *size = atoi(p + 1);
+        if (*size < 1)
+            return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* compkernel_initialize: */
+int compkernel_initialize(int kernel, int size)
+{
+    double t;
+    int i, nunits;
+
+    compkernel = kernel;
+    if (kernel == COMPKERNEL_WAIT)
+        return MPIPERF_SUCCESS;
+
+    if (kernel == COMPKERNEL_TRIAD) {
+        compkernel_size = (size > 0) ? size : TRIAD_SIZE_DEFAULT;
+        nelems = compkernel_size * 1024 / sizeof(double);
+        if (nelems < TRIAD_CHUNK)
+            nelems = TRIAD_CHUNK;
+        nelems -= nelems % TRIAD_CHUNK;
+        c = xmalloc(sizeof(*c) * nelems);
+    } else if (kernel == COMPKERNEL_FMA) {
+        compkernel_size = (size > 0) ? size : FMA_SIZE_DEFAULT;
+        nelems = compkernel_size * 1024 / sizeof(double);
+        if (nelems < 1)
+            nelems = 1;
+    } else {
+        compkernel_size = (size > 0) ? size : DGEMM_SIZE_DEFAULT;
+        nblocks = (compkernel_size + DGEMM_BLOCK - 1) / DGEMM_BLOCK;
+        compkernel_size = nblocks * DGEMM_BLOCK;
+        nelems = compkernel_size * compkernel_size;
+        c = xmalloc(sizeof(*c) * nelems);
+    }
+    a = xmalloc(sizeof(*a) * nelems);
+    b = xmalloc(sizeof(*b) * nelems);
+    for (i = 0; i < nelems; i++) {
+        a[i] = 1.0;
+        b[i] = 2.0;
+        if (c)
+            c[i] = 0.5;
+    }
+
+    /* Calibration: warmup and measure mean time of unit */
+    for (i = 0; i < 16; i++)
+        compkernel_run_unit();
+    nunits = 0;
+    t = hpctimer_wtime();
+    do {
+        compkernel_run_unit();
+        nunits++;
+    } while (hpctimer_wtime() - t < CALIBRATION_TIME);
+    compkernel_unittime = (hpctimer_wtime() - t) / nunits;
+    logger_log("Compute kernel is calibrated: unit time %.9f sec. (%d units)",
+               compkernel_unittime, nunits);
+    return MPIPERF_SUCCESS;
+}
+
+/* compkernel_finalize: */
+void compkernel_finalize()
+{
+    free(a);
+    free(b);
+    free(c);
+    a = b = c = NULL;
+}
+
+/* compkernel_nunits: */
+int compkernel_nunits(double time)
+{
+    if (time <= 0.0 || compkernel_unittime <= 0.0)
+        return 0;
+    return (int)(time / compkernel_unittime + 0.5);
+}
+
+/* compkernel_run_unit: */
+void compkernel_run_unit()
+{
+    switch (compkernel) {
+    case COMPKERNEL_TRIAD:
+        compkernel_triad_unit();
+        break;
+    case COMPKERNEL_FMA:
+        compkernel_fma_unit();
+        break;
+    case COMPKERNEL_DGEMM:
+        compkernel_dgemm_unit();
+        break;
+    }
+}
+
+/* compkernel_print_info: Prints kernel for report header. */
+void compkernel_print_info()
+{
+    switch (compkernel) {
+    case COMPKERNEL_TRIAD:
+        printf("# Compute kernel: STREAM triad (3 arrays of %d KB), unit time %.9f sec.\n",
+               compkernel_size, compkernel_unittime);
+        break;
+    case COMPKERNEL_FMA:
+        printf("# Compute kernel: multiply-add loop (array of %d KB), unit time %.9f sec.\n",
+               compkernel_size, compkernel_unittime);
+        break;
+    case COMPKERNEL_DGEMM:
+        printf("# Compute kernel: blocked DGEMM (n = %d, block %d), unit time %.9f sec.\n",
+               compkernel_size, DGEMM_BLOCK, compkernel_unittime);
+        break;
+    default:
+        printf("# Compute kernel: busy-wait\n");
+    }
+}
+
+/* compkernel_triad_unit: Triad on the next chunk of arrays. */
+static void compkernel_triad_unit()
+{
+    int i, end;
+
+    end = pos + TRIAD_CHUNK;
+    for (i = pos; i < end; i++)
+        a[i] = b[i] + TRIAD_SCALAR * c[i];
+    pos = (end < nelems) ? end : 0;
+}
+
+/* compkernel_fma_unit: Several passes of multiply-add over array. */
+static void compkernel_fma_unit()
+{
+    int i, r;
+
+    for (r = 0; r < FMA_NREPEATS; r++) {
+        for (i = 0; i < nelems; i++)
+            a[i] = a[i] * 0.999999 + b[i];
+    }
+}
+
+/* compkernel_dgemm_unit: C[i][j] += A[i][k] * B[k][j] for the next blocks. */
+static void compkernel_dgemm_unit()
+{
+    int i, j, k, n = compkernel_size;
+    double *ablk, *bblk, *cblk, aik;
+
+    ablk = a + blk_i * DGEMM_BLOCK * n + blk_k * DGEMM_BLOCK;
+    bblk = b + blk_k * DGEMM_BLOCK * n + blk_j * DGEMM_BLOCK;
+    cblk = c + blk_i * DGEMM_BLOCK * n + blk_j * DGEMM_BLOCK;
+    for (i = 0; i < DGEMM_BLOCK; i++) {
+        for (k = 0; k < DGEMM_BLOCK; k++) {
+            aik = ablk[i * n + k];
+            for (j = 0; j < DGEMM_BLOCK; j++)
+                cblk[i * n + j] += aik * bblk[k * n + j];
+        }
+    }
+
+    /* Next block triple in order (i, j, k) */
+    if (++blk_k == nblocks) {
+        blk_k = 0;
+        if (++blk_j == nblocks) {
+            blk_j = 0;
+            if (++blk_i == nblocks)
+                blk_i = 0;
+        }
+    }
+}
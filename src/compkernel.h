@@ -0,0 +1,41 @@
+/*
+ * compkernel.h: Compute kernels for NBC overlap measurement.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef COMPKERNEL_H
+#define COMPKERNEL_H
+
+enum CompKernelType {
+    COMPKERNEL_WAIT = 0,    /* Busy-wait on timer (no memory accesses) */
+    COMPKERNEL_TRIAD = 1,   /* STREAM triad: a[i] = b[i] + s * c[i] */
+    COMPKERNEL_FMA = 2,     /* Multiply-add loop on cache-resident array */
+    COMPKERNEL_DGEMM = 3    /* Blocked matrix multiplication C += A * B */
+};
+
+/*
+ * compkernel_parse: Parses kernel string: wait, triad[:<KB>], fma[:<KB>],
+ *                   dgemm[:<n>]. Size is 0 if it is not specified.
+ */
+int compkernel_parse(const char *s, int *kernel, int *size);
+
+/*
+ * compkernel_initialize: Allocates data of kernel and measures time
+ *                        of kernel unit (calibration).
+ */
+int compkernel_initialize(int kernel, int size);
+void compkernel_finalize();
+
+/*
+ * compkernel_nunits: Returns number of kernel units computed in time
+ *                    (measured in calibration without communications).
+ */
+int compkernel_nunits(double time);
+
+/* compkernel_run_unit: Computes one unit of the kernel. */
+void compkernel_run_unit();
+
+void compkernel_print_info();
+
+#endif /* COMPKERNEL_H */
@@ -0,0 +1,266 @@
+/*
+ * histogram.c: Log-linear histograms of time (HDR-style).
+ *
+ * Range [1 ns, 2^HIST_NEXPS ns) is divided into powers of two and each
+ * power of two is divided into HIST_NSUBBUCKETS linear buckets, so the
+ * relative width of bucket is at most 1 / HIST_NSUBBUCKETS. Histogram has
+ * fixed size, element is added in O(1) and histograms of processes are
+ * merged by one MPI_Reduce with user-defined operation.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include <mpi.h>
+
+#include "histogram.h"
+#include "mpiperf.h"
+
+enum {
+    HIST_NEXPS = 40,                /* Up to 2^40 ns (~18 min) */
+    HIST_NSUBBUCKETS = 32,          /* Linear buckets per power of two */
+    HIST_NBUCKETS = 1 + HIST_NEXPS * HIST_NSUBBUCKETS  /* + bucket [0, 1 ns) */
+};
+
+#define HIST_UNIT 1E-9              /* Unit of bucket bounds (seconds) */
+
+struct histogram {
+    long long count;
+    double sum;
+    double min;
+    double max;
+    long long buckets[HIST_NBUCKETS];
+};
+
+static MPI_Datatype histtype = MPI_DATATYPE_NULL;
+static MPI_Op histop = MPI_OP_NULL;
+
+static void histogram_merge(void *in, void *inout, int *len,
+                            MPI_Datatype *dtype);
+static int histogram_bucket(double val);
+static double histogram_bucket_lb(int bucket);
+
+/* histogram_initialize: */
+int histogram_initialize()
+{
+    if (MPI_Type_contiguous(sizeof(histogram_t), MPI_BYTE,
+                            &histtype) != MPI_SUCCESS)
+    {
+        return MPIPERF_FAILURE;
+    }
+    MPI_Type_commit(&histtype);
+    if (MPI_Op_create(histogram_merge, 1, &histop) != MPI_SUCCESS) {
+        MPI_Type_free(&histtype);
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* histogram_finalize: */
+void histogram_finalize()
+{
+    if (histop != MPI_OP_NULL)
+        MPI_Op_free(&histop);
+    if (histtype != MPI_DATATYPE_NULL)
+        MPI_Type_free(&histtype);
+}
+
+/* histogram_create: */
+histogram_t *histogram_create()
+{
+    histogram_t *hist;
+
+    if ( (hist = malloc(sizeof(*hist))) == NULL)
+        return NULL;
+    histogram_clean(hist);
+    return hist;
+}
+
+/* histogram_free: */
+void histogram_free(histogram_t *hist)
+{
+    if (hist)
+        free(hist);
+}
+
+/* histogram_clean: */
+void histogram_clean(histogram_t *hist)
+{
+    memset(hist->buckets, 0, sizeof(hist->buckets));
+    hist->count = 0;
+    hist->sum = 0.0;
+    hist->min = DBL_MAX;
+    hist->max = 0.0;
+}
+
+/* histogram_add: */
+void histogram_add(histogram_t *hist, double val)
+{
+    hist->buckets[histogram_bucket(val)]++;
+    hist->count++;
+    hist->sum += val;
+    if (val < hist->min)
+        hist->min = val;
+    if (val > hist->max)
+        hist->max = val;
+}
+
+/* histogram_count: */
+long long histogram_count(histogram_t *hist)
+{
+    return hist->count;
+}
+
+/*
+ * histogram_quantile: Returns p-quantile: middle of bucket (clamped
+ *                     by min and max) where cumulative fraction reaches p.
+ */
+double histogram_quantile(histogram_t *hist, double p)
+{
+    long long cumulative = 0;
+    double val;
+    int i;
+
+    if (hist->count == 0)
+        return 0.0;
+    for (i = 0; i < HIST_NBUCKETS - 1; i++) {
+        cumulative += hist->buckets[i];
+        if (cumulative >= p * hist->count && hist->buckets[i] > 0)
+            break;
+    }
+    val = 0.5 * (histogram_bucket_lb(i) + histogram_bucket_lb(i + 1));
+    if (val < hist->min)
+        val = hist->min;
+    if (val > hist->max)
+        val = hist->max;
+    return val;
+}
+
+/* histogram_mean: */
+double histogram_mean(histogram_t *hist)
+{
+    return (hist->count > 0) ? hist->sum / hist->count : 0.0;
+}
+
+double histogram_min(histogram_t *hist)
+{
+    return (hist->count > 0) ? hist->min : 0.0;
+}
+
+double histogram_max(histogram_t *hist)
+{
+    return hist->max;
+}
+
+/* histogram_reduce: */
+int histogram_reduce(histogram_t *hist, histogram_t *result, int root,
+                     MPI_Comm comm)
+{
+    return MPI_Reduce(hist, result, 1, histtype, histop, root, comm);
+}
+
+/* histogram_write_header: */
+void histogram_write_header(FILE *stream)
+{
+    fprintf(stream, "# Characteristics of histogram:\n");
+    fprintf(stream, "#   Procs - total number of processes\n");
+    fprintf(stream, "#   Count - count of elements in send/recv buffer\n");
+    fprintf(stream, "#   LB, UB - bounds of bucket of time: [LB, UB)\n");
+    fprintf(stream, "#   Runs - number of measurements in bucket (runs of all processes)\n");
+    fprintf(stream, "#   Fraction - Runs / total number of measurements\n");
+    fprintf(stream, "#   Cumulative - fraction of measurements < UB\n");
+    fprintf(stream, "#\n");
+    fprintf(stream, "# Buckets: %d per power of two (relative width <= %.4f)\n",
+            HIST_NSUBBUCKETS, 1.0 / HIST_NSUBBUCKETS);
+    fprintf(stream, "# Histograms of processes are merged (whole job distribution)\n");
+    fprintf(stream, "# ------------------------------------------------------------------\n");
+    fprintf(stream, "# [Procs] [Count]     [LB]           [UB]           [Runs]       [Fraction] [Cumulative]\n");
+}
+
+/* histogram_write: */
+void histogram_write(histogram_t *hist, FILE *stream, int nprocs, int count,
+                     double timescale)
+{
+    long long cumulative = 0;
+    int i;
+
+    if (hist->count == 0)
+        return;
+
+    for (i = 0; i < HIST_NBUCKETS; i++) {
+        if (hist->buckets[i] == 0)
+            continue;
+        cumulative += hist->buckets[i];
+        fprintf(stream, "  %-7d %-11d %-14.4f %-14.4f %-12lld %-10.6f %-10.6f\n",
+                nprocs, count,
+                histogram_bucket_lb(i) * timescale,
+                histogram_bucket_lb(i + 1) * timescale,
+                hist->buckets[i],
+                (double)hist->buckets[i] / hist->count,
+                (double)cumulative / hist->count);
+    }
+    fprintf(stream, "# Procs %d, count %d: runs %lld, mean %.4f, min %.4f, max %.4f\n",
+            nprocs, count, hist->count, hist->sum / hist->count * timescale,
+            hist->min * timescale, hist->max * timescale);
+    fprintf(stream, "\n");
+}
+
+/* histogram_merge: User-defined reduction operation (MPI_Op). */
+static void histogram_merge(void *in, void *inout, int *len,
+                            MPI_Datatype *dtype)
+{
+    histogram_t *a = (histogram_t *)in;
+    histogram_t *b = (histogram_t *)inout;
+    int i, j;
+
+    for (j = 0; j < *len; j++) {
+        for (i = 0; i < HIST_NBUCKETS; i++)
+            b[j].buckets[i] += a[j].buckets[i];
+        b[j].count += a[j].count;
+        b[j].sum += a[j].sum;
+        if (a[j].min < b[j].min)
+            b[j].min = a[j].min;
+        if (a[j].max > b[j].max)
+            b[j].max = a[j].max;
+    }
+}
+
+/*
+ * histogram_bucket: Returns bucket of value: val = m * 2^e (in ns),
+ *                   m in [1, 2), bucket of sub-range of [2^e, 2^{e + 1}).
+ */
+static int histogram_bucket(double val)
+{
+    double m;
+    int e, sub;
+
+    val /= HIST_UNIT;
+    if (!(val >= 1.0))
+        return 0;
+
+    m = frexp(val, &e);     /* val = m * 2^e, m in [0.5, 1) */
+    e--;
+    if (e >= HIST_NEXPS)
+        return HIST_NBUCKETS - 1;
+    sub = (int)((2.0 * m - 1.0) * HIST_NSUBBUCKETS);
+    if (sub >= HIST_NSUBBUCKETS)
+        sub = HIST_NSUBBUCKETS - 1;
+    return 1 + e * HIST_NSUBBUCKETS + sub;
+}
+
+/* histogram_bucket_lb: Returns lower bound of bucket (seconds). */
+static double histogram_bucket_lb(int bucket)
+{
+    int e, sub;
+
+    if (bucket == 0)
+        return 0.0;
+    e = (bucket - 1) / HIST_NSUBBUCKETS;
+    sub = (bucket - 1) % HIST_NSUBBUCKETS;
+    return ldexp(1.0 + (double)sub / HIST_NSUBBUCKETS, e) * HIST_UNIT;
+}
@@ -0,0 +1,53 @@
+/*
+ * histogram.h: Log-linear histograms of time (HDR-style).
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdio.h>
+
+#include <mpi.h>
+
+typedef struct histogram histogram_t;
+
+/*
+ * histogram_initialize: Creates MPI datatype and reduction operation
+ *                       for merging of histograms.
+ */
+int histogram_initialize();
+void histogram_finalize();
+
+histogram_t *histogram_create();
+void histogram_free(histogram_t *hist);
+void histogram_clean(histogram_t *hist);
+
+/* histogram_add: Adds time (seconds) to histogram: O(1). */
+void histogram_add(histogram_t *hist, double val);
+long long histogram_count(histogram_t *hist);
+double histogram_mean(histogram_t *hist);
+double histogram_min(histogram_t *hist);
+double histogram_max(histogram_t *hist);
+
+/* histogram_quantile: Returns p-quantile with relative error of bucket width. */
+double histogram_quantile(histogram_t *hist, double p);
+
+/*
+ * histogram_reduce: Merges histograms of processes of communicator
+ *                   into histogram result of root (one MPI_Reduce).
+ */
+int histogram_reduce(histogram_t *hist, histogram_t *result, int root,
+                     MPI_Comm comm);
+
+/*
+ * histogram_write: Writes nonempty buckets: [Procs] [Count] [LB] [UB]
+ *                  [Runs] [Fraction] [Cumulative], bounds are scaled
+ *                  by timescale.
+ */
+void histogram_write(histogram_t *hist, FILE *stream, int nprocs, int count,
+                     double timescale);
+void histogram_write_header(FILE *stream);
+
+#endif /* HISTOGRAM_H */
@@ -106,7 +106,8 @@ int hpctimer_initialize(const char *timername)
 /* hpctimer_finalize: */
 void hpctimer_finalize()
 {
-    if (hpctimer_timers[hpctimer_timer].finalize) {
+    /* Timer may be not initialized (error in options) */
+    if (hpctimer_timer >= 0 && hpctimer_timers[hpctimer_timer].finalize) {
         hpctimer_timers[hpctimer_timer].finalize();
     }
     hpctimer_wtime_func_ptr = NULL;
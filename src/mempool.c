@@ -60,7 +60,11 @@ mempool_t *mempool_create(size_t size, int cachedefeat)
         p->size = size;
     }
 
-    if ( (p->pool = malloc(sizeof(*p->pool) * p->size)) == NULL) {
+    /*
+     * Buffers are zeroed: garbage in uninitialized memory can contain
+     * denormals and NaNs, which affect the time of reduction operations.
+     */
+    if ( (p->pool = calloc(p->size, sizeof(*p->pool))) == NULL) {
         free(p);
         return NULL;
     }
@@ -25,6 +25,16 @@
 #include "bench_coll.h"
 #include "bench_pt2pt.h"
 #include "bench_nbc.h"
+#include "bench_persistent.h"
+#include "bench_rma.h"
+#include "bench_thread.h"
+#include "reduceop.h"
+#include "rootpolicy.h"
+#include "topo.h"
+#include "compkernel.h"
+#include "histogram.h"
+#include "straggler.h"
+#include "compare.h"
 
 enum Consts {
     MPIPERF_CMDLINE_MAX = 1024
@@ -35,6 +45,8 @@ int mpiperf_commsize;       /* Size of MPI_COMM_WORLD */
 int mpiperf_master_rank;    /* Process which generates report */
 char *mpiperf_cmdline;
 char *mpiperf_progname;
+int mpiperf_thread_required; /* Level of thread support requested by mpiperf */
+int mpiperf_thread_provided; /* Level of thread support provided by MPI */
 
 /*
  * Command-line options
@@ -50,11 +62,16 @@ int mpiperf_count_step_type;
 int mpiperf_count_step;
 
 int mpiperf_perprocreport;
+int mpiperf_procdump;
+int mpiperf_nstragglers;
+char *mpiperf_procdumpfile;
 char *mpiperf_repfile;
 FILE *mpiperf_repstream;
 
 int mpiperf_isflushcache;
 int mpiperf_statanalysis;
+int mpiperf_warmupdetect;
+stat_outliers_t mpiperf_outliers;
 int mpiperf_timescale;
 int mpiperf_synctype;
 char *mpiperf_timername;
@@ -62,17 +79,51 @@ char *mpiperf_timername;
 int mpiperf_test_exit_cond;
 int mpiperf_nmeasures_max;
 double mpiperf_rse_max;
+double mpiperf_ciw_max;
+int mpiperf_bootstrap_nreplicates;
 int mpiperf_nruns_min;
 int mpiperf_nruns_max;
 
 char *mpiperf_logfile;
 int mpiperf_logmaster_only;
 
-int mpiperf_confidence_level_type;
-int mpiperf_confidence_level;
+double mpiperf_confidence_level;
+char *mpiperf_comparefile;
+double mpiperf_compare_threshold;
 
 int mpiperf_nbcbench_mode;
 int mpiperf_comptime_niters;
+int mpiperf_nbc_progress;
+int mpiperf_nbc_testsweep;
+int mpiperf_nbc_noutstanding;
+int mpiperf_nthreads;
+int mpiperf_compkernel;
+int mpiperf_compkernel_size;
+
+int mpiperf_reduceop;
+
+int mpiperf_rootpolicy;
+int mpiperf_root;
+int mpiperf_rootreport;
+char *mpiperf_rootrepfile;
+FILE *mpiperf_rootrepstream;
+
+int mpiperf_histreport;
+char *mpiperf_histfile;
+FILE *mpiperf_histstream;
+
+int mpiperf_topo;
+int mpiperf_topo_degree;
+
+int mpiperf_pt2pt_window;
+int mpiperf_pt2pt_npairs;
+int mpiperf_pt2pt_pairing;
+int mpiperf_pt2pt_bothsided;
+
+int mpiperf_matrixreport;
+char *mpiperf_matrixfile;
+FILE *mpiperf_matrixstream;
+int mpiperf_matrix_nrounds;
 
 char *mpiperf_benchname = NULL;
 
@@ -81,8 +132,15 @@ int mpiperf_is_measure_started;
 static collbench_t *mpiperf_collbench = NULL;
 static pt2ptbench_t *mpiperf_pt2ptbench = NULL;
 static nbcbench_t *mpiperf_nbcbench = NULL;
+static persistentbench_t *mpiperf_persistentbench = NULL;
+static rmabench_t *mpiperf_rmabench = NULL;
+static threadbench_t *mpiperf_threadbench = NULL;
+
+static const char *mpiperf_optstring =
+    "p:P:x:X:g:G:s:S:e:E:r:R:l:z:w:t:o:c:O:y:Y:k:W:N:M:U:K:f:n:i:L:D:C:F:Z:Q:u:V:H:ABbadTjJmqh";
 
 static void mpiperf_checktimer();
+static int mpiperf_thread_level(int argc, char **argv);
 static void print_version();
 static void print_usage(int argc, char **argv);
 static int parse_options(int argc, char **argv);
@@ -90,13 +148,15 @@ static void set_default_options();
 
 int main(int argc, char **argv)
 {
-    int i;
+    int i, required;
 
     /* This flag can be used in MPI_Init by user library. */
     mpiperf_is_measure_started = 0;
 
-    MPI_Init(&argc, &argv);
+    required = mpiperf_thread_level(argc, argv);
+    MPI_Init_thread(&argc, &argv, required, &mpiperf_thread_provided);
     set_default_options();
+    mpiperf_thread_required = required;
 
     /* Save command line */
     mpiperf_cmdline = (char *)malloc(sizeof(*mpiperf_cmdline) *
@@ -121,6 +181,12 @@ int main(int argc, char **argv)
         run_pt2ptbench(mpiperf_pt2ptbench);
     } else if (mpiperf_nbcbench) {
         run_nbcbench(mpiperf_nbcbench);
+    } else if (mpiperf_persistentbench) {
+        run_persistentbench(mpiperf_persistentbench);
+    } else if (mpiperf_rmabench) {
+        run_rmabench(mpiperf_rmabench);
+    } else if (mpiperf_threadbench) {
+        run_threadbench(mpiperf_threadbench);
     }
     mpiperf_finalize();
 
@@ -146,18 +212,57 @@ void mpiperf_initialize()
         logger_log("hpctimer '%s' is initialized", mpiperf_timername);
     }
 
+    if (reduceop_initialize(mpiperf_reduceop) == MPIPERF_FAILURE) {
+        exit_error("Can't create reduction operation");
+    }
+
+    compkernel_initialize(mpiperf_compkernel, mpiperf_compkernel_size);
+
+    if (histogram_initialize() == MPIPERF_FAILURE) {
+        exit_error("Can't create reduction operation for histograms");
+    }
+    if (straggler_initialize() == MPIPERF_FAILURE) {
+        exit_error("Can't create reduction operation for stragglers");
+    }
+
     if (mpiperf_perprocreport) {
         if ( (mpiperf_repstream = fopen(mpiperf_repfile, "w")) == NULL)
             exit_error("Can't open per process report file: %s", optarg);
     }
+
+    if (mpiperf_rootreport && IS_MASTER_RANK) {
+        if ( (mpiperf_rootrepstream = fopen(mpiperf_rootrepfile, "w")) == NULL)
+            exit_error("Can't open per root report file: %s", mpiperf_rootrepfile);
+    }
+
+    if (mpiperf_histreport && IS_MASTER_RANK) {
+        if ( (mpiperf_histstream = fopen(mpiperf_histfile, "w")) == NULL)
+            exit_error("Can't open histogram file: %s", mpiperf_histfile);
+    }
+
+    if (mpiperf_matrixreport && IS_MASTER_RANK) {
+        if ( (mpiperf_matrixstream = fopen(mpiperf_matrixfile, "w")) == NULL)
+            exit_error("Can't open matrix file: %s", mpiperf_matrixfile);
+    }
 }
 
 /* mpiperf_finalize: */
 void mpiperf_finalize()
 {
-    if (mpiperf_perprocreport)
+    /* Streams are not opened if options are incorrect */
+    if (mpiperf_perprocreport && mpiperf_repstream)
         fclose(mpiperf_repstream);
-
+    if (mpiperf_rootreport && IS_MASTER_RANK && mpiperf_rootrepstream)
+        fclose(mpiperf_rootrepstream);
+    if (mpiperf_histreport && IS_MASTER_RANK && mpiperf_histstream)
+        fclose(mpiperf_histstream);
+    if (mpiperf_matrixreport && IS_MASTER_RANK && mpiperf_matrixstream)
+        fclose(mpiperf_matrixstream);
+
+    reduceop_finalize();
+    compkernel_finalize();
+    histogram_finalize();
+    straggler_finalize();
     logger_finalize();
     hpctimer_finalize();
 }
@@ -209,7 +314,8 @@ static void print_version()
 static void print_usage(int argc, char **argv)
 {
     fprintf(stderr, "Usage: %s [OPTIONS] BENCHMARK\n", mpiperf_progname);
-    fprintf(stderr, "Measure performance of MPI routines by BENCHMARK.\n");
+    fprintf(stderr, "       %s [OPTIONS] -V BASELINE REPORT\n", mpiperf_progname);
+    fprintf(stderr, "Measure performance of MPI routines by BENCHMARK or compare REPORT with BASELINE report.\n");
     fprintf(stderr, "\nOptions:\n");
     fprintf(stderr, "  -p <value>       Min number of processes (default: commsize)\n");
     fprintf(stderr, "  -P <value>       Max number of processes (defaul: commsize)\n");
@@ -221,17 +327,49 @@ static void print_usage(int argc, char **argv)
     fprintf(stderr, "  -S <step>        Data size is changed in a geometric progression with <step> (defaul: 2)\n");
     fprintf(stderr, "  -e <rse%%>        Terminate each test when relative standard error is less then <rse> (default: %d%%)\n",
             (int)(mpiperf_rse_max * 100));
+    fprintf(stderr, "  -e med:<w%%>      Terminate each collective test when half-width of bootstrap CI of median is less then <w>%% of median\n");
+    fprintf(stderr, "  -Z <n>           Bootstrap CI of Median, P90, P99, P99.9 of collectives with <n> replicates (default: off)\n");
     fprintf(stderr, "  -E <n>           Terminate each test when number of successful measurements is equal to or greater then <n> (default: %d)\n",
             mpiperf_nmeasures_max);
     fprintf(stderr, "  -r <runs>        Minimal number of runs for each parameter value (default: %d)\n",
             mpiperf_nruns_min);
     fprintf(stderr, "  -R <runs>        Maximal number of runs for each parameter value (default: %d)\n",
             mpiperf_nruns_max);
-    fprintf(stderr, "  -b               Measure NBC time in blocking mode (default: off)\n");
+    fprintf(stderr, "  -C <level%%>      Confidence level of intervals, 0 < <level> < 100 (default: %g%%)\n",
+            mpiperf_confidence_level);
+    fprintf(stderr, "  -V <file>        Compare report (instead of BENCHMARK) with baseline report <file> by Welch's t-test,\n"
+                    "                   exit status is nonzero if there are significant regressions\n");
+    fprintf(stderr, "  -H <threshold%%>  Minimal slowdown of significant regression in comparison of reports (default: %g%%)\n",
+            mpiperf_compare_threshold);
+    fprintf(stderr, "  -b               Measure NBC and persistent collectives time in blocking mode (default: off)\n");
+    fprintf(stderr, "  -A               Measure NBC overlap also with progress thread on a spare core (MPI_THREAD_MULTIPLE, default: off)\n");
+    fprintf(stderr, "  -f <usec>        Sweep interval of MPI_Test calls in NBC overlap down to <usec> (default: off)\n");
+    fprintf(stderr, "  -n <k>           Measure 1, 2, 4, ..., <k> outstanding NBC operations completed by MPI_Waitall (default: off)\n");
+    fprintf(stderr, "  -i <threads>     Maximal number of threads per process for thread benchmarks (default: 4)\n");
+    fprintf(stderr, "  -L <level>       Level of thread support: single, funneled, serialized, multiple\n");
+    fprintf(stderr, "                   (default: multiple for -A and thread benchmarks, single otherwise)\n");
+    fprintf(stderr, "  -K <kernel>      Compute kernel for NBC overlap: wait, triad[:<KB>], fma[:<KB>], dgemm[:<n>] (default: wait)\n");
     fprintf(stderr, "  -c               Number of iterations for compute time (on NBC overlap measuring, default: 10)\n");
+    fprintf(stderr, "  -O <op>          Reduction operation: sum, max, min, prod, band, maxloc, user, usersimd (default: sum)\n");
+    fprintf(stderr, "  -y <policy>      Root of rooted collectives: fixed[:<rank>], roundrobin, random (default: fixed:0)\n");
+    fprintf(stderr, "  -Y <file>        Write per root report in <file> (synctime, NBC blocking mode; default: off)\n");
+    fprintf(stderr, "  -D <file>        Write histograms of time of all processes in <file> (collectives, synctime; default: off)\n");
+    fprintf(stderr, "  -k <topo>        Topology for neighborhood collectives: cart2d, cart3d, graph[:<k>] (default: cart2d)\n");
+    fprintf(stderr, "  -W <n>           Window of outstanding messages for bandwidth benchmarks (default: %d)\n",
+            mpiperf_pt2pt_window);
+    fprintf(stderr, "  -N <n>[:<place>] Number of concurrent pairs for point-to-point benchmarks (n or all),\n"
+                    "                   placement: split (i <-> i + n), adjacent (2i <-> 2i + 1) (default: 1:split)\n");
+    fprintf(stderr, "  -B               Report receiver time and one-way latency of point-to-point benchmarks (default: off)\n");
+    fprintf(stderr, "  -M <file>        Measure point-to-point benchmark between all pairs, write matrix in <file> (default: off)\n");
+    fprintf(stderr, "  -U <rounds>      Measure random sample of <rounds> rounds of pairs in matrix mode (default: all)\n");
     fprintf(stderr, "  -z               Synchronization method: synctime, nosync (default: synctime)\n");
-    fprintf(stderr, "  -o <file>        Write per process report in <file> (default: off)\n");
+    fprintf(stderr, "  -o <file>        Write per process report in <file>: distribution and slowest processes (default: off)\n");
+    fprintf(stderr, "  -u <k>           Report <k> top stragglers of collectives: processes which determined time of runs (default: off)\n");
+    fprintf(stderr, "  -Q <file>        Write statistics of each process of collectives in <file> by MPI-IO (default: off)\n");
     fprintf(stderr, "  -a               Turn off statistical analysis of data (removing outliers, default: on)\n");
+    fprintf(stderr, "  -J               Turn off detection of warmup transient in collectives (MSER rule, default: on)\n");
+    fprintf(stderr, "  -F <filter>      Outliers filter: none, trim[:<lb%%>[:<ub%%>]], mad[:<k>], iqr[:<k>], mink[:<k>]\n");
+    fprintf(stderr, "                   (default: trim:25:25; mad:3, iqr:1.5 and mink:4 if <k> is omitted)\n");
     fprintf(stderr, "  -w <scale>       Time scale: sec, usec (default: usec)\n");
     fprintf(stderr, "  -d               CPU cache defeat flag (default: off)\n");
     fprintf(stderr, "  -t               Timer: tsc, mpi_wtime, gettimeofday (default: mpi_wtime)\n");
@@ -245,12 +383,34 @@ static void print_usage(int argc, char **argv)
     fprintf(stderr, "\nReport bugs to <mkurnosov@gmail.com>.\n");
 }
 
+/*
+ * mpiperf_thread_level: Returns level of thread support required by
+ *                       options (they are scanned before MPI_Init_thread).
+ */
+static int mpiperf_thread_level(int argc, char **argv)
+{
+    int opt, level = MPI_THREAD_SINGLE, userlevel = -1;
+
+    opterr = 0;
+    while ( (opt = getopt(argc, argv, mpiperf_optstring)) != -1) {
+        if (opt == 'A')
+            level = MPI_THREAD_MULTIPLE;
+        else if (opt == 'L')
+            userlevel = thread_level_lookup(optarg);
+    }
+    if (optind < argc && lookup_threadbench(argv[optind]))
+        level = MPI_THREAD_MULTIPLE;
+    opterr = 1;
+    optind = 1;
+    return (userlevel >= 0) ? userlevel : level;
+}
+
 /* parse_options: Parses command line options and sets global variables. */
 static int parse_options(int argc, char **argv)
 {
-    int opt;
+    int opt, rc;
 
-    while ( (opt = getopt(argc, argv, "p:P:x:X:g:G:s:S:e:E:r:R:l:z:w:t:o:c:badTjmqh")) != -1) {
+    while ( (opt = getopt(argc, argv, mpiperf_optstring)) != -1) {
         switch (opt) {
         case 'p':
             mpiperf_nprocs_min = atoi(optarg);
@@ -283,19 +443,132 @@ static int parse_options(int argc, char **argv)
         case 'b':
             mpiperf_nbcbench_mode = NBCBENCH_BLOCKING;
             break;
+        case 'A':
+            mpiperf_nbc_progress = 1;
+            break;
+        case 'f':
+            mpiperf_nbc_testsweep = atoi(optarg);
+            if (mpiperf_nbc_testsweep < 1) {
+                exit_error("Incorrect minimal interval of MPI_Test calls (-f)");
+            }
+            break;
+        case 'i':
+            mpiperf_nthreads = atoi(optarg);
+            if (mpiperf_nthreads < 1) {
+                exit_error("Incorrect number of threads (-i)");
+            }
+            break;
+        case 'L':
+            /* Level is requested by mpiperf_thread_level before MPI_Init */
+            if (thread_level_lookup(optarg) < 0) {
+                exit_error("Unknown level of thread support: %s", optarg);
+            }
+            break;
+        case 'n':
+            mpiperf_nbc_noutstanding = atoi(optarg);
+            if (mpiperf_nbc_noutstanding < 1) {
+                exit_error("Incorrect number of outstanding operations (-n)");
+            }
+            break;
+        case 'K':
+            if (compkernel_parse(optarg, &mpiperf_compkernel,
+                                 &mpiperf_compkernel_size) == MPIPERF_FAILURE)
+            {
+                exit_error("Unknown compute kernel: %s", optarg);
+            }
+            break;
         case 'c':
             mpiperf_comptime_niters = atoi(optarg);
             if (mpiperf_comptime_niters < 1) {
                 exit_error("Incorrect number of iterations for compute time (-c)");
             }
             break;
+        case 'O':
+            if ( (mpiperf_reduceop = reduceop_lookup(optarg)) < 0) {
+                exit_error("Unknown reduction operation: %s", optarg);
+            }
+            break;
+        case 'y':
+            if (rootpolicy_parse(optarg, &mpiperf_rootpolicy,
+                                 &mpiperf_root) == MPIPERF_FAILURE)
+            {
+                exit_error("Unknown root policy: %s", optarg);
+            }
+            break;
+        case 'Y':
+            mpiperf_rootreport = 1;
+            mpiperf_rootrepfile = optarg;
+            break;
+        case 'D':
+            mpiperf_histreport = 1;
+            mpiperf_histfile = optarg;
+            break;
+        case 'k':
+            if (topo_parse(optarg, &mpiperf_topo,
+                           &mpiperf_topo_degree) == MPIPERF_FAILURE)
+            {
+                exit_error("Unknown topology: %s", optarg);
+            }
+            break;
+        case 'W':
+            mpiperf_pt2pt_window = atoi(optarg);
+            if (mpiperf_pt2pt_window < 1) {
+                exit_error("Incorrect window of outstanding messages (-W)");
+            }
+            break;
+        case 'N':
+            if (pt2ptbench_parse_pairs(optarg, &mpiperf_pt2pt_npairs,
+                                       &mpiperf_pt2pt_pairing) == MPIPERF_FAILURE)
+            {
+                exit_error("Incorrect number of pairs: %s", optarg);
+            }
+            break;
+        case 'B':
+            mpiperf_pt2pt_bothsided = 1;
+            break;
+        case 'M':
+            mpiperf_matrixreport = 1;
+            mpiperf_matrixfile = optarg;
+            break;
+        case 'U':
+            mpiperf_matrix_nrounds = atoi(optarg);
+            if (mpiperf_matrix_nrounds < 1) {
+                exit_error("Incorrect number of rounds (-U)");
+            }
+            break;
         case 'a':
             mpiperf_statanalysis = 0;
             break;
+        case 'u':
+            mpiperf_nstragglers = atoi(optarg);
+            if (mpiperf_nstragglers < 1) {
+                exit_error("Incorrect number of stragglers (-u)");
+            }
+            break;
+        case 'Q':
+            mpiperf_procdump = 1;
+            mpiperf_procdumpfile = optarg;
+            break;
+        case 'J':
+            mpiperf_warmupdetect = 0;
+            break;
+        case 'F':
+            if (stat_outliers_parse(optarg, &mpiperf_outliers) != 0) {
+                exit_error("Incorrect outliers filter (-F)");
+            }
+            break;
         case 'd':
             mpiperf_isflushcache = 1;
             break;
         case 'e':
+            if (strncmp(optarg, "med:", 4) == 0) {
+                mpiperf_test_exit_cond = TEST_EXIT_COND_MEDIAN_CI;
+                mpiperf_ciw_max = atof(optarg + 4) / 100.0;
+                if (mpiperf_ciw_max <= 0.0) {
+                    exit_error("Incorrect relative width of median CI (-e)");
+                }
+                break;
+            }
             mpiperf_test_exit_cond = TEST_EXIT_COND_STDERR;
             mpiperf_rse_max = atoi(optarg) / 100.0;
             if (mpiperf_rse_max < 1E-3) {
@@ -304,6 +577,27 @@ static int parse_options(int argc, char **argv)
                 }
             }
             break;
+        case 'Z':
+            mpiperf_bootstrap_nreplicates = atoi(optarg);
+            if (mpiperf_bootstrap_nreplicates < 1) {
+                exit_error("Incorrect number of bootstrap replicates (-Z)");
+            }
+            break;
+        case 'V':
+            mpiperf_comparefile = optarg;
+            break;
+        case 'H':
+            mpiperf_compare_threshold = atof(optarg);
+            if (mpiperf_compare_threshold < 0.0) {
+                exit_error("Incorrect regression threshold (-H)");
+            }
+            break;
+        case 'C':
+            mpiperf_confidence_level = atof(optarg);
+            if (mpiperf_confidence_level <= 0.0 || mpiperf_confidence_level >= 100.0) {
+                exit_error("Incorrect confidence level (-C)");
+            }
+            break;
         case 'E':
             mpiperf_test_exit_cond = TEST_EXIT_COND_NRUNS;
             mpiperf_nmeasures_max = atoi(optarg);
@@ -368,6 +662,9 @@ static int parse_options(int argc, char **argv)
                 print_collbench_info();
                 print_pt2ptbench_info();
                 print_nbcbench_info();
+                print_persistentbench_info();
+                print_rmabench_info();
+                print_threadbench_info();
             }
             exit_success();
         case 'v':
@@ -384,6 +681,22 @@ static int parse_options(int argc, char **argv)
         }
     }
 
+    if (mpiperf_comparefile) {
+        if (optind >= argc) {
+            print_error("Expected report file");
+            return MPIPERF_FAILURE;
+        }
+        rc = 0;
+        if (IS_MASTER_RANK) {
+            rc = compare_reports(mpiperf_comparefile, argv[optind],
+                                 mpiperf_confidence_level,
+                                 mpiperf_compare_threshold);
+        }
+        MPI_Bcast(&rc, 1, MPI_INT, mpiperf_master_rank, MPI_COMM_WORLD);
+        MPI_Finalize();
+        exit((rc == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
     if (optind >= argc) {
         if (IS_MASTER_RANK) {
             print_usage(argc, argv);
@@ -406,6 +719,13 @@ static int parse_options(int argc, char **argv)
         }
     }
 
+    if (mpiperf_rootpolicy == ROOTPOLICY_FIXED &&
+        mpiperf_root >= mpiperf_nprocs_min)
+    {
+        exit_error("Incorrect root %d: must be less than number of processes %d",
+                   mpiperf_root, mpiperf_nprocs_min);
+    }
+
     if (mpiperf_count_min < 0 || mpiperf_count_max < 0 ||
         mpiperf_count_min > mpiperf_count_max)
     {
@@ -443,6 +763,12 @@ static int parse_options(int argc, char **argv)
         return MPIPERF_SUCCESS;
     else if ( (mpiperf_nbcbench = lookup_nbcbench(argv[optind])))
         return MPIPERF_SUCCESS;
+    else if ( (mpiperf_persistentbench = lookup_persistentbench(argv[optind])))
+        return MPIPERF_SUCCESS;
+    else if ( (mpiperf_rmabench = lookup_rmabench(argv[optind])))
+        return MPIPERF_SUCCESS;
+    else if ( (mpiperf_threadbench = lookup_threadbench(argv[optind])))
+        return MPIPERF_SUCCESS;
     else {
         if (IS_MASTER_RANK) {
             print_error("Unknown benchmark name");
@@ -472,9 +798,14 @@ static void set_default_options()
     mpiperf_perprocreport = 0;
     mpiperf_repfile = NULL;                     /* -o */
     mpiperf_repstream = NULL;
+    mpiperf_procdump = 0;
+    mpiperf_nstragglers = 0;                    /* -u */
+    mpiperf_procdumpfile = NULL;                /* -Q */
 
     mpiperf_isflushcache = 0;                   /* -c Cache defeat flag */
     mpiperf_statanalysis = 1;                   /* -a Stat. analysis */
+    stat_outliers_parse("trim", &mpiperf_outliers); /* -F */
+    mpiperf_warmupdetect = 1;                   /* -J */
     mpiperf_timescale = TIMESCALE_USEC;         /* -w */
     mpiperf_synctype = SYNC_TIME;               /* -z Sync. method */
     mpiperf_timername = "MPI_Wtime";            /* -t Timer */
@@ -482,16 +813,44 @@ static void set_default_options()
     mpiperf_test_exit_cond = TEST_EXIT_COND_NRUNS;  /* -E */
     mpiperf_nmeasures_max = 30;  /* -E Maximal number of successful measurements */
     mpiperf_rse_max = 0.05;      /* -e Maximal value of relative standard error */
+    mpiperf_ciw_max = 0.05;      /* -e med: Maximal relative half-width of median CI */
     mpiperf_nruns_min = 10;      /* -r Minimal number of runs per test */
     mpiperf_nruns_max = 100;     /* -R Maximal number of runs per test */
 
     mpiperf_logfile = NULL;      /* -l Log filename */
     mpiperf_logmaster_only = 0;  /* -m Log by master process only */
 
-    mpiperf_confidence_level_type = STAT_CONFIDENCE_LEVEL_95;
-    mpiperf_confidence_level = 95;
+    mpiperf_confidence_level = 95.0;            /* -C */
+    mpiperf_comparefile = NULL;                 /* -V */
+    mpiperf_compare_threshold = COMPARE_THRESHOLD_DEFAULT; /* -H */
+    mpiperf_bootstrap_nreplicates = 0;          /* -Z */
 
     mpiperf_nbcbench_mode = NBCBENCH_OVERLAP;
     mpiperf_comptime_niters = 10;
+    mpiperf_nbc_progress = 0;                   /* -A */
+    mpiperf_nbc_testsweep = 0;                  /* -f */
+    mpiperf_nbc_noutstanding = 0;               /* -n */
+    mpiperf_nthreads = 4;                       /* -i */
+    mpiperf_compkernel = COMPKERNEL_WAIT;       /* -K */
+    mpiperf_compkernel_size = 0;
+    mpiperf_reduceop = REDUCEOP_SUM;            /* -O */
+    mpiperf_rootpolicy = ROOTPOLICY_FIXED;      /* -y */
+    mpiperf_root = 0;
+    mpiperf_rootreport = 0;
+    mpiperf_rootrepfile = NULL;                 /* -Y */
+    mpiperf_rootrepstream = NULL;
+    mpiperf_histreport = 0;
+    mpiperf_histfile = NULL;                    /* -D */
+    mpiperf_histstream = NULL;
+    mpiperf_topo = TOPO_CART2D;                 /* -k */
+    mpiperf_topo_degree = TOPO_GRAPH_DEGREE_DEFAULT;
+    mpiperf_pt2pt_window = 64;                  /* -W */
+    mpiperf_pt2pt_npairs = 1;                   /* -N */
+    mpiperf_pt2pt_pairing = PAIRING_SPLIT;
+    mpiperf_pt2pt_bothsided = 0;                /* -B */
+    mpiperf_matrixreport = 0;
+    mpiperf_matrixfile = NULL;                  /* -M */
+    mpiperf_matrixstream = NULL;
+    mpiperf_matrix_nrounds = 0;                 /* -U */
     mpiperf_benchname = NULL;
 }
@@ -9,13 +9,12 @@
 
 #include <stdio.h>
 #include "version.h"
+#include "stat.h"
 
 #define NELEMS(v) (sizeof(v) / sizeof((v)[0]))
 #define IS_MASTER_RANK (mpiperf_rank == mpiperf_master_rank)
 
 #define TEST_SLOTLEN_SCALE 1.1
-#define OUTLIERS_FILTER_MIN 25
-#define OUTLIERS_FILTER_MAX 25
 
 enum ReturnCode {
     MPIPERF_SUCCESS = 0,
@@ -29,7 +28,8 @@ enum ParamStepType {
 
 enum ExitConditionType {
     TEST_EXIT_COND_NRUNS = 0,
-    TEST_EXIT_COND_STDERR = 1
+    TEST_EXIT_COND_STDERR = 1,
+    TEST_EXIT_COND_MEDIAN_CI = 2
 };
 
 enum TimeScaleType {
@@ -69,6 +69,8 @@ extern char *mpiperf_progname;    /* mpiperf application name */
 
 extern int mpiperf_rank;          /* Rank of current process in MPI_COMM_WORLD */
 extern int mpiperf_commsize;      /* Size of MPI_COMM_WORLD */
+extern int mpiperf_thread_required;
+extern int mpiperf_thread_provided;
 extern int mpiperf_master_rank;   /* Process which generates report */
 extern char *mpiperf_cmdline;
 
@@ -83,11 +85,16 @@ extern int mpiperf_count_step_type;
 extern int mpiperf_count_step;
 
 extern int mpiperf_perprocreport;
+extern int mpiperf_procdump;
+extern int mpiperf_nstragglers;
+extern char *mpiperf_procdumpfile;
 extern char *mpiperf_repfile;
 extern FILE *mpiperf_repstream;
 
 extern int mpiperf_isflushcache;
 extern int mpiperf_statanalysis;
+extern int mpiperf_warmupdetect;
+extern stat_outliers_t mpiperf_outliers;
 extern int mpiperf_timescale;
 extern int mpiperf_synctype;
 extern char *mpiperf_timername;
@@ -95,17 +102,51 @@ extern char *mpiperf_timername;
 extern int mpiperf_test_exit_cond;
 extern int mpiperf_nmeasures_max;
 extern double mpiperf_rse_max;
+extern double mpiperf_ciw_max;
+extern int mpiperf_bootstrap_nreplicates;
 extern int mpiperf_nruns_min;
 extern int mpiperf_nruns_max;
 
 extern char *mpiperf_logfile;
 extern int mpiperf_logmaster_only;
 
-extern int mpiperf_confidence_level_type;
-extern int mpiperf_confidence_level;
+extern double mpiperf_confidence_level;
+extern char *mpiperf_comparefile;
+extern double mpiperf_compare_threshold;
 
 extern int mpiperf_nbcbench_mode;
 extern int mpiperf_comptime_niters;
+extern int mpiperf_nbc_progress;
+extern int mpiperf_nbc_testsweep;
+extern int mpiperf_nbc_noutstanding;
+extern int mpiperf_nthreads;
+extern int mpiperf_compkernel;
+extern int mpiperf_compkernel_size;
+
+extern int mpiperf_reduceop;
+
+extern int mpiperf_rootpolicy;
+extern int mpiperf_root;
+extern int mpiperf_rootreport;
+extern char *mpiperf_rootrepfile;
+extern FILE *mpiperf_rootrepstream;
+
+extern int mpiperf_histreport;
+extern char *mpiperf_histfile;
+extern FILE *mpiperf_histstream;
+
+extern int mpiperf_topo;
+extern int mpiperf_topo_degree;
+
+extern int mpiperf_pt2pt_window;
+extern int mpiperf_pt2pt_npairs;
+extern int mpiperf_pt2pt_pairing;
+extern int mpiperf_pt2pt_bothsided;
+
+extern int mpiperf_matrixreport;
+extern char *mpiperf_matrixfile;
+extern FILE *mpiperf_matrixstream;
+extern int mpiperf_matrix_nrounds;
 
 extern char *mpiperf_benchname;
 
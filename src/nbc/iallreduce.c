@@ -4,6 +4,8 @@
  * Copyright (C) 2012 Mikhail Kurnosov
  */
 
+#include <stdlib.h>
+
 #include <mpi.h>
 
 #include "iallreduce.h"
@@ -13,22 +15,28 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
+static MPI_Request *reqs = NULL;   /* Outstanding operations (-n) */
 
 int bench_iallreduce_init(nbctest_params_t *params)
 {
-    sbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
+    /* Outstanding operations (-n) use separate buffers */
+    sbufpool = mempool_create(params->count * reduceop_typesize() *
+                              params->noutstanding, mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * reduceop_typesize() *
+                              params->noutstanding, mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
         mempool_free(rbufpool);
         return MPIPERF_FAILURE;
     }
-    sbufsize = params->count * sizeof(double);
-    rbufsize = params->count * sizeof(double);
+    sbufsize = params->count * reduceop_typesize();
+    rbufsize = params->count * reduceop_typesize();
+    reqs = xmalloc(sizeof(*reqs) * params->noutstanding);
     return MPIPERF_SUCCESS;
 }
 
@@ -36,13 +44,16 @@ int bench_iallreduce_free()
 {
     mempool_free(sbufpool);
     mempool_free(rbufpool);
+    free(reqs);
+    reqs = NULL;
     return MPIPERF_SUCCESS;
 }
 
 int bench_iallreduce_printinfo()
 {
     printf("* Iallreduce\n"
-           "  proto: MPI_Iallreduce(sbuf, rbuf, count, MPI_DOUBLE, MPI_SUM, comm)\n");
+           "  proto: MPI_Iallreduce(sbuf, rbuf, count, %s, %s, comm)\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -58,7 +69,7 @@ int measure_iallreduce_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iallreduce(mempool_alloc(sbufpool, sbufsize),
                         mempool_alloc(rbufpool, rbufsize), params->count,
-                        MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                        reduceop_datatype(), reduceop_op(), params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -86,7 +97,7 @@ int measure_iallreduce_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iallreduce(mempool_alloc(sbufpool, sbufsize),
                         mempool_alloc(rbufpool, rbufsize), params->count,
-                        MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                        reduceop_datatype(), reduceop_op(), params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
@@ -101,3 +112,33 @@ int measure_iallreduce_overlap(nbctest_params_t *params,
 #endif
     return MEASURE_FAILURE;
 }
+
+int measure_iallreduce_multi(nbctest_params_t *params, nbctest_result_t *result)
+{
+#ifdef HAVE_NBC
+    double starttime, endtime;
+    char *sbuf, *rbuf;
+    int i, rc;
+
+    sbuf = mempool_alloc(sbufpool, sbufsize * params->noutstanding);
+    rbuf = mempool_alloc(rbufpool, rbufsize * params->noutstanding);
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    for (i = 0; i < params->noutstanding; i++) {
+        MPI_Iallreduce(sbuf + i * sbufsize, rbuf + i * rbufsize, params->count,
+                       reduceop_datatype(), reduceop_op(), params->comm,
+                       &reqs[i]);
+    }
+    result->inittime = hpctimer_wtime() - result->inittime;
+    result->waittime = hpctimer_wtime();
+    rc = MPI_Waitall(params->noutstanding, reqs, MPI_STATUSES_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
@@ -18,5 +18,6 @@ int measure_iallreduce_blocking(nbctest_params_t *params,
                                 nbctest_result_t *result);
 int measure_iallreduce_overlap(nbctest_params_t *params,
                                nbctest_result_t *result);
+int measure_iallreduce_multi(nbctest_params_t *params, nbctest_result_t *result);
 
 #endif /* IALLREDUCE_H */
@@ -4,6 +4,8 @@
  * Copyright (C) 2012 Mikhail Kurnosov
  */
 
+#include <stdlib.h>
+
 #include <mpi.h>
 
 #include "ialltoall.h"
@@ -17,11 +19,15 @@
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
+static MPI_Request *reqs = NULL;   /* Outstanding operations (-n) */
 
 int bench_ialltoall_init(nbctest_params_t *params)
 {
-    sbufpool = mempool_create(params->count * params->nprocs, mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * params->nprocs, mpiperf_isflushcache);
+    /* Outstanding operations (-n) use separate buffers */
+    sbufpool = mempool_create(params->count * params->nprocs *
+                              params->noutstanding, mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * params->nprocs *
+                              params->noutstanding, mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
         mempool_free(rbufpool);
@@ -29,6 +35,7 @@ int bench_ialltoall_init(nbctest_params_t *params)
     }
     sbufsize = params->count * sizeof(char) * params->nprocs;
     rbufsize = params->count * sizeof(char) * params->nprocs;
+    reqs = xmalloc(sizeof(*reqs) * params->noutstanding);
     return MPIPERF_SUCCESS;
 }
 
@@ -36,6 +43,8 @@ int bench_ialltoall_free()
 {
     mempool_free(sbufpool);
     mempool_free(rbufpool);
+    free(reqs);
+    reqs = NULL;
     return MPIPERF_SUCCESS;
 }
 
@@ -102,3 +111,33 @@ int measure_ialltoall_overlap(nbctest_params_t *params,
 #endif
     return MEASURE_FAILURE;
 }
+
+int measure_ialltoall_multi(nbctest_params_t *params, nbctest_result_t *result)
+{
+#ifdef HAVE_NBC
+    double starttime, endtime;
+    char *sbuf, *rbuf;
+    int i, rc;
+
+    sbuf = mempool_alloc(sbufpool, sbufsize * params->noutstanding);
+    rbuf = mempool_alloc(rbufpool, rbufsize * params->noutstanding);
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    for (i = 0; i < params->noutstanding; i++) {
+        MPI_Ialltoall(sbuf + i * sbufsize, params->count, MPI_BYTE,
+                      rbuf + i * rbufsize, params->count, MPI_BYTE,
+                      params->comm, &reqs[i]);
+    }
+    result->inittime = hpctimer_wtime() - result->inittime;
+    result->waittime = hpctimer_wtime();
+    rc = MPI_Waitall(params->noutstanding, reqs, MPI_STATUSES_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
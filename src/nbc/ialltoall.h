@@ -18,5 +18,6 @@ int measure_ialltoall_blocking(nbctest_params_t *params,
                                nbctest_result_t *result);
 int measure_ialltoall_overlap(nbctest_params_t *params,
                               nbctest_result_t *result);
+int measure_ialltoall_multi(nbctest_params_t *params, nbctest_result_t *result);
 
 #endif /* IALLTOALL_H */
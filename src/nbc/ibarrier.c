@@ -4,6 +4,8 @@
  * Copyright (C) 2012 Mikhail Kurnosov
  */
 
+#include <stdlib.h>
+
 #include <mpi.h>
 
 #include "ibarrier.h"
@@ -14,13 +16,18 @@
 #include "util.h"
 #include "mempool.h"
 
+static MPI_Request *reqs = NULL;   /* Outstanding operations (-n) */
+
 int bench_ibarrier_init(nbctest_params_t *params)
 {
+    reqs = xmalloc(sizeof(*reqs) * params->noutstanding);
     return MPIPERF_SUCCESS;
 }
 
 int bench_ibarrier_free()
 {
+    free(reqs);
+    reqs = NULL;
     return MPIPERF_SUCCESS;
 }
 
@@ -80,3 +87,28 @@ int measure_ibarrier_overlap(nbctest_params_t *params, nbctest_result_t *result)
 #endif
     return MEASURE_FAILURE;
 }
+
+int measure_ibarrier_multi(nbctest_params_t *params, nbctest_result_t *result)
+{
+#ifdef HAVE_NBC
+    double starttime, endtime;
+    int i, rc;
+
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    for (i = 0; i < params->noutstanding; i++) {
+        MPI_Ibarrier(params->comm, &reqs[i]);
+    }
+    result->inittime = hpctimer_wtime() - result->inittime;
+    result->waittime = hpctimer_wtime();
+    rc = MPI_Waitall(params->noutstanding, reqs, MPI_STATUSES_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
@@ -18,5 +18,6 @@ int measure_ibarrier_blocking(nbctest_params_t *params,
                               nbctest_result_t *result);
 int measure_ibarrier_overlap(nbctest_params_t *params,
                              nbctest_result_t *result);
+int measure_ibarrier_multi(nbctest_params_t *params, nbctest_result_t *result);
 
 #endif /* IBARRIER_H */
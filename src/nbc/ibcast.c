@@ -4,6 +4,8 @@
  * Copyright (C) 2012 Mikhail Kurnosov
  */
 
+#include <stdlib.h>
+
 #include <mpi.h>
 
 #include "ibcast.h"
@@ -13,30 +15,36 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *bufpool = NULL;
 static int bufsize;
-static int root = 0;
+static MPI_Request *reqs = NULL;   /* Outstanding operations (-n) */
 
 int bench_ibcast_init(nbctest_params_t *params)
 {
-    bufpool = mempool_create(params->count, mpiperf_isflushcache);
+    /* Outstanding operations (-n) use separate buffers */
+    bufpool = mempool_create(params->count * params->noutstanding,
+                             mpiperf_isflushcache);
     if (bufpool == NULL)
         return MPIPERF_FAILURE;
     bufsize = params->count * sizeof(char);
+    reqs = xmalloc(sizeof(*reqs) * params->noutstanding);
     return MPIPERF_SUCCESS;
 }
 
 int bench_ibcast_free()
 {
     mempool_free(bufpool);
+    free(reqs);
+    reqs = NULL;
     return MPIPERF_SUCCESS;
 }
 
 int bench_ibcast_printinfo()
 {
     printf("* Ibcast\n"
-           "  proto: MPI_Ibcast(buf, count, MPI_BYTE, %d, comm)\n", root);
+           "  proto: MPI_Ibcast(buf, count, MPI_BYTE, root, comm)\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -51,7 +59,7 @@ int measure_ibcast_blocking(nbctest_params_t *params,
     starttime = timeslot_startsync();
     result->inittime = hpctimer_wtime();
     rc = MPI_Ibcast(mempool_alloc(bufpool, bufsize), params->count,
-                    MPI_BYTE, root, params->comm, &req);
+                    MPI_BYTE, params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -78,7 +86,7 @@ int measure_ibcast_overlap(nbctest_params_t *params,
     starttime = timeslot_startsync();
     result->inittime = hpctimer_wtime();
     rc = MPI_Ibcast(mempool_alloc(bufpool, bufsize), params->count,
-                    MPI_BYTE, root, params->comm, &req);
+                    MPI_BYTE, params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
@@ -94,3 +102,30 @@ int measure_ibcast_overlap(nbctest_params_t *params,
     return MEASURE_FAILURE;
 }
 
+int measure_ibcast_multi(nbctest_params_t *params, nbctest_result_t *result)
+{
+#ifdef HAVE_NBC
+    double starttime, endtime;
+    char *buf;
+    int i, rc;
+
+    buf = mempool_alloc(bufpool, bufsize * params->noutstanding);
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    for (i = 0; i < params->noutstanding; i++) {
+        MPI_Ibcast(buf + i * bufsize, params->count, MPI_BYTE, params->root,
+                   params->comm, &reqs[i]);
+    }
+    result->inittime = hpctimer_wtime() - result->inittime;
+    result->waittime = hpctimer_wtime();
+    rc = MPI_Waitall(params->noutstanding, reqs, MPI_STATUSES_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
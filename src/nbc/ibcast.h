@@ -18,5 +18,6 @@ int measure_ibcast_blocking(nbctest_params_t *params,
                             nbctest_result_t *result);
 int measure_ibcast_overlap(nbctest_params_t *params,
                            nbctest_result_t *result);
+int measure_ibcast_multi(nbctest_params_t *params, nbctest_result_t *result);
 
 #endif /* IBCAST_H */
@@ -13,6 +13,7 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -20,15 +21,17 @@ static int sbufsize, rbufsize;
 
 int bench_iexscan_init(nbctest_params_t *params)
 {
-    sbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
+    sbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
         mempool_free(rbufpool);
         return MPIPERF_FAILURE;
     }
-    sbufsize = params->count * sizeof(double);
-    rbufsize = params->count * sizeof(double);
+    sbufsize = params->count * reduceop_typesize();
+    rbufsize = params->count * reduceop_typesize();
     return MPIPERF_SUCCESS;
 }
 
@@ -42,8 +45,9 @@ int bench_iexscan_free()
 int bench_iexscan_printinfo()
 {
     printf("* Iexscan\n"
-           "  proto: MPI_Iexscan(sbuf, rbuf, count, MPI_DOUBLE, \n"
-           "                     MPI_SUM, comm)\n");
+           "  proto: MPI_Iexscan(sbuf, rbuf, count, %s, \n"
+           "                     %s, comm)\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -59,7 +63,7 @@ int measure_iexscan_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iexscan(mempool_alloc(sbufpool, sbufsize),
                       mempool_alloc(rbufpool, sbufsize), params->count,
-                      MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                      reduceop_datatype(), reduceop_op(), params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -87,7 +91,7 @@ int measure_iexscan_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iexscan(mempool_alloc(sbufpool, sbufsize),
                      mempool_alloc(rbufpool, sbufsize), params->count,
-                     MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                     reduceop_datatype(), reduceop_op(), params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
@@ -13,11 +13,11 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
-static int root = 0;
 
 int bench_igather_init(nbctest_params_t *params)
 {
@@ -33,7 +33,7 @@ int bench_igather_init(nbctest_params_t *params)
     sbufsize = params->count * sizeof(char);
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         rbufpool = mempool_create(params->count * params->nprocs, mpiperf_isflushcache);
         if (rbufpool == NULL) {
             mempool_free(sbufpool);
@@ -55,7 +55,7 @@ int bench_igather_printinfo()
 {
     printf("* Igather\n"
            "  proto: MPI_Igather(sbuf, count, MPI_BYTE, \n"
-           "                     rbuf, count, MPI_BYTE, %d, comm)\n", root);
+           "                     rbuf, count, MPI_BYTE, root, comm)\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -71,7 +71,7 @@ int measure_igather_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Igather(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                       mempool_alloc(rbufpool, rbufsize), params->count, MPI_BYTE,
-                      root, params->comm, &req);
+                      params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -99,7 +99,7 @@ int measure_igather_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Igather(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                      mempool_alloc(rbufpool, rbufsize), params->count, MPI_BYTE,
-                     root, params->comm, &req);
+                     params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
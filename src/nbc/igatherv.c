@@ -13,6 +13,7 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -20,7 +21,6 @@ static int *recvcounts = NULL;
 static int *displs = NULL;
 static int sbufsize;
 static int rbufsize;
-static int root = 0;
 
 int bench_igatherv_init(nbctest_params_t *params)
 {
@@ -38,7 +38,7 @@ int bench_igatherv_init(nbctest_params_t *params)
     sbufsize = params->count * sizeof(char);
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         recvcounts = malloc(sizeof(*recvcounts) * params->nprocs);
         displs = malloc(sizeof(*displs) * params->nprocs);
         if (recvcounts == NULL || displs == NULL) {
@@ -82,8 +82,8 @@ int bench_igatherv_printinfo()
 {
     printf("* Igatherv\n"
            "  proto: MPI_Igatherv(sbuf, count, MPI_BYTE, rbuf, recvcounts, displs,\n"
-           "                      MPI_BYTE, %d, comm)\n"
-           "  For each element: recvcounts[i] = count\n", root);
+           "                      MPI_BYTE, root, comm)\n"
+           "  For each element: recvcounts[i] = count\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -99,7 +99,7 @@ int measure_igatherv_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Igatherv(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                       mempool_alloc(rbufpool, rbufsize), recvcounts, displs,
-                      MPI_BYTE, root, params->comm, &req);
+                      MPI_BYTE, params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -127,7 +127,7 @@ int measure_igatherv_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Igatherv(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                       mempool_alloc(rbufpool, rbufsize), recvcounts, displs,
-                      MPI_BYTE, root, params->comm, &req);
+                      MPI_BYTE, params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
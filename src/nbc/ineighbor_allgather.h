@@ -0,0 +1,23 @@
+/*
+ * ineighbor_allgather.h: Benchmark functions for Ineighbor_allgather.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef INEIGHBOR_ALLGATHER_H
+#define INEIGHBOR_ALLGATHER_H
+
+#include "bench_nbc.h"
+#include "topo.h"
+
+int bench_ineighbor_allgather_init(nbctest_params_t *params);
+int bench_ineighbor_allgather_free();
+int bench_ineighbor_allgather_printinfo();
+int measure_ineighbor_allgather_blocking(nbctest_params_t *params,
+                                         nbctest_result_t *result);
+int measure_ineighbor_allgather_overlap(nbctest_params_t *params,
+                                        nbctest_result_t *result);
+
+#endif /* INEIGHBOR_ALLGATHER_H */
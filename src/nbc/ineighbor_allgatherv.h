@@ -0,0 +1,23 @@
+/*
+ * ineighbor_allgatherv.h: Benchmark functions for Ineighbor_allgatherv.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef INEIGHBOR_ALLGATHERV_H
+#define INEIGHBOR_ALLGATHERV_H
+
+#include "bench_nbc.h"
+#include "topo.h"
+
+int bench_ineighbor_allgatherv_init(nbctest_params_t *params);
+int bench_ineighbor_allgatherv_free();
+int bench_ineighbor_allgatherv_printinfo();
+int measure_ineighbor_allgatherv_blocking(nbctest_params_t *params,
+                                          nbctest_result_t *result);
+int measure_ineighbor_allgatherv_overlap(nbctest_params_t *params,
+                                         nbctest_result_t *result);
+
+#endif /* INEIGHBOR_ALLGATHERV_H */
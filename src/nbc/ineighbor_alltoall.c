@@ -0,0 +1,117 @@
+/*
+ * ineighbor_alltoall.c: Benchmark functions for Ineighbor_alltoall.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "ineighbor_alltoall.h"
+#include "bench_nbc.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "hpctimer.h"
+#include "util.h"
+#include "mempool.h"
+#include "topo.h"
+
+static mempool_t *sbufpool = NULL;
+static mempool_t *rbufpool = NULL;
+static int sbufsize, rbufsize;
+static MPI_Comm topocomm = MPI_COMM_NULL;
+static int indegree, outdegree;
+
+int bench_ineighbor_alltoall_init(nbctest_params_t *params)
+{
+    topocomm = topo_createcomm(params->comm);
+    topo_neighbors_count(topocomm, &indegree, &outdegree);
+
+    sbufpool = mempool_create(params->count * outdegree, mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * indegree, mpiperf_isflushcache);
+    if (sbufpool == NULL || rbufpool == NULL) {
+        mempool_free(sbufpool);
+        mempool_free(rbufpool);
+        sbufpool = NULL;
+        rbufpool = NULL;
+        MPI_Comm_free(&topocomm);
+        return MPIPERF_FAILURE;
+    }
+    sbufsize = params->count * outdegree * sizeof(char);
+    rbufsize = params->count * indegree * sizeof(char);
+    return MPIPERF_SUCCESS;
+}
+
+int bench_ineighbor_alltoall_free()
+{
+    mempool_free(sbufpool);
+    mempool_free(rbufpool);
+    if (topocomm != MPI_COMM_NULL)
+        MPI_Comm_free(&topocomm);
+    return MPIPERF_SUCCESS;
+}
+
+int bench_ineighbor_alltoall_printinfo()
+{
+    printf("* Ineighbor_alltoall\n"
+           "  proto: MPI_Ineighbor_alltoall(sbuf, count, MPI_BYTE,\n"
+           "                                rbuf, count, MPI_BYTE, comm)\n"
+           "  comm: topology from option -k (default: cart2d)\n");
+    return MPIPERF_SUCCESS;
+}
+
+int measure_ineighbor_alltoall_blocking(nbctest_params_t *params,
+                                        nbctest_result_t *result)
+{
+#ifdef HAVE_NEIGHBOR_COLL
+    double starttime, endtime;
+    int rc;
+    static MPI_Request req;
+
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    rc = MPI_Ineighbor_alltoall(mempool_alloc(sbufpool, sbufsize), params->count,
+                                MPI_BYTE, mempool_alloc(rbufpool, rbufsize),
+                                params->count, MPI_BYTE, topocomm, &req);
+    result->inittime = hpctimer_wtime() - result->inittime;
+    result->waittime = hpctimer_wtime();
+    rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
+
+int measure_ineighbor_alltoall_overlap(nbctest_params_t *params,
+                                       nbctest_result_t *result)
+{
+#ifdef HAVE_NEIGHBOR_COLL
+    double starttime, endtime;
+    int rc;
+    static MPI_Request req;
+
+    starttime = timeslot_startsync();
+    result->inittime = hpctimer_wtime();
+    rc = MPI_Ineighbor_alltoall(mempool_alloc(sbufpool, sbufsize), params->count,
+                                MPI_BYTE, mempool_alloc(rbufpool, rbufsize),
+                                params->count, MPI_BYTE, topocomm, &req);
+    result->inittime = hpctimer_wtime() - result->inittime;
+    nbcbench_simulate_computing(params, &req, result);
+    result->waittime = hpctimer_wtime();
+    rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
+    result->waittime = hpctimer_wtime() - result->waittime;
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        result->totaltime = endtime - starttime;
+        return MEASURE_SUCCESS;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
@@ -0,0 +1,23 @@
+/*
+ * ineighbor_alltoall.h: Benchmark functions for Ineighbor_alltoall.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef INEIGHBOR_ALLTOALL_H
+#define INEIGHBOR_ALLTOALL_H
+
+#include "bench_nbc.h"
+#include "topo.h"
+
+int bench_ineighbor_alltoall_init(nbctest_params_t *params);
+int bench_ineighbor_alltoall_free();
+int bench_ineighbor_alltoall_printinfo();
+int measure_ineighbor_alltoall_blocking(nbctest_params_t *params,
+                                        nbctest_result_t *result);
+int measure_ineighbor_alltoall_overlap(nbctest_params_t *params,
+                                       nbctest_result_t *result);
+
+#endif /* INEIGHBOR_ALLTOALL_H */
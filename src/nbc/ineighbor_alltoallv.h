@@ -0,0 +1,23 @@
+/*
+ * ineighbor_alltoallv.h: Benchmark functions for Ineighbor_alltoallv.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef INEIGHBOR_ALLTOALLV_H
+#define INEIGHBOR_ALLTOALLV_H
+
+#include "bench_nbc.h"
+#include "topo.h"
+
+int bench_ineighbor_alltoallv_init(nbctest_params_t *params);
+int bench_ineighbor_alltoallv_free();
+int bench_ineighbor_alltoallv_printinfo();
+int measure_ineighbor_alltoallv_blocking(nbctest_params_t *params,
+                                         nbctest_result_t *result);
+int measure_ineighbor_alltoallv_overlap(nbctest_params_t *params,
+                                        nbctest_result_t *result);
+
+#endif /* INEIGHBOR_ALLTOALLV_H */
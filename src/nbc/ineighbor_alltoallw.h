@@ -0,0 +1,23 @@
+/*
+ * ineighbor_alltoallw.h: Benchmark functions for Ineighbor_alltoallw.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef INEIGHBOR_ALLTOALLW_H
+#define INEIGHBOR_ALLTOALLW_H
+
+#include "bench_nbc.h"
+#include "topo.h"
+
+int bench_ineighbor_alltoallw_init(nbctest_params_t *params);
+int bench_ineighbor_alltoallw_free();
+int bench_ineighbor_alltoallw_printinfo();
+int measure_ineighbor_alltoallw_blocking(nbctest_params_t *params,
+                                         nbctest_result_t *result);
+int measure_ineighbor_alltoallw_overlap(nbctest_params_t *params,
+                                        nbctest_result_t *result);
+
+#endif /* INEIGHBOR_ALLTOALLW_H */
@@ -13,11 +13,12 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
-static int root = 0;
 
 int bench_ireduce_init(nbctest_params_t *params)
 {
@@ -26,21 +27,22 @@ int bench_ireduce_init(nbctest_params_t *params)
     rbufpool = NULL;
     rbufsize = 0;
 
-    sbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
+    sbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
     if (sbufpool == NULL) {
         return MPIPERF_FAILURE;
     }
-    sbufsize = params->count * sizeof(double);
+    sbufsize = params->count * reduceop_typesize();
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
-        rbufpool = mempool_create(params->count * sizeof(double),
+    if (rank == params->root || !rootpolicy_isfixed()) {
+        rbufpool = mempool_create(params->count * reduceop_typesize(),
                                   mpiperf_isflushcache);
         if (rbufpool == NULL) {
             mempool_free(sbufpool);
             return MPIPERF_FAILURE;
         }
-        rbufsize = params->count * sizeof(double);
+        rbufsize = params->count * reduceop_typesize();
     }
     return MPIPERF_SUCCESS;
 }
@@ -55,8 +57,9 @@ int bench_ireduce_free()
 int bench_ireduce_printinfo()
 {
     printf("* Ireduce\n"
-           "  proto: MPI_Ireduce(sbuf, rbuf, count, MPI_DOUBLE, \n"
-           "                     MPI_SUM, %d, comm)\n", root);
+           "  proto: MPI_Ireduce(sbuf, rbuf, count, %s, \n"
+           "                     %s, root, comm)\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -72,7 +75,8 @@ int measure_ireduce_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Ireduce(mempool_alloc(sbufpool, sbufsize),
                      mempool_alloc(rbufpool, sbufsize), params->count,
-                     MPI_DOUBLE, MPI_SUM, root, params->comm, &req);
+                     reduceop_datatype(), reduceop_op(), params->root,
+                     params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -100,7 +104,8 @@ int measure_ireduce_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Ireduce(mempool_alloc(sbufpool, sbufsize),
                      mempool_alloc(rbufpool, sbufsize), params->count,
-                     MPI_DOUBLE, MPI_SUM, root, params->comm, &req);
+                     reduceop_datatype(), reduceop_op(), params->root,
+                     params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
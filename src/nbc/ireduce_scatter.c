@@ -13,6 +13,7 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -29,8 +30,9 @@ int bench_ireduce_scatter_init(nbctest_params_t *params)
         return MPIPERF_FAILURE;
     }
 
-    sbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * sizeof(double) * params->nprocs,
+    sbufpool = mempool_create(params->count * reduceop_typesize(),
+                              mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * reduceop_typesize() * params->nprocs,
                               mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
@@ -45,8 +47,8 @@ int bench_ireduce_scatter_init(nbctest_params_t *params)
         recvcounts[i * params->nprocs / (params->count % params->nprocs)]++;
     }
     MPI_Comm_rank(params->comm, &rank);
-    sbufsize = params->count * sizeof(double);
-    rbufsize = recvcounts[rank] * sizeof(double);
+    sbufsize = params->count * reduceop_typesize();
+    rbufsize = recvcounts[rank] * reduceop_typesize();
 
     return MPIPERF_SUCCESS;
 }
@@ -62,9 +64,10 @@ int bench_ireduce_scatter_free()
 int bench_ireduce_scatter_printinfo()
 {
     printf("* Ireduce_scatter\n"
-           "  proto: MPI_Ireduce_scatter(sbuf, rbuf, recvcounts, MPI_DOUBLE, \n"
-           "                             MPI_SUM, comm)\n"
-           "  Send buffer is divided onto equal parts and scattered among processes\n");
+           "  proto: MPI_Ireduce_scatter(sbuf, rbuf, recvcounts, %s, \n"
+           "                             %s, comm)\n"
+           "  Send buffer is divided onto equal parts and scattered among processes\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -80,7 +83,8 @@ int measure_ireduce_scatter_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Ireduce_scatter(mempool_alloc(sbufpool, sbufsize),
                              mempool_alloc(rbufpool, rbufsize), recvcounts,
-                             MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                             reduceop_datatype(), reduceop_op(), params->comm,
+                             &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -108,7 +112,8 @@ int measure_ireduce_scatter_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Ireduce_scatter(mempool_alloc(sbufpool, sbufsize),
                              mempool_alloc(rbufpool, rbufsize), recvcounts,
-                             MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                             reduceop_datatype(), reduceop_op(), params->comm,
+                             &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
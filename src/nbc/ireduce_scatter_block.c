@@ -13,6 +13,7 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "reduceop.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -20,16 +21,17 @@ static int sbufsize, rbufsize;
 
 int bench_ireduce_scatter_block_init(nbctest_params_t *params)
 {
-    sbufpool = mempool_create(params->count * sizeof(double) * params->nprocs,
+    sbufpool = mempool_create(params->count * reduceop_typesize() * params->nprocs,
+                              mpiperf_isflushcache);
+    rbufpool = mempool_create(params->count * reduceop_typesize(),
                               mpiperf_isflushcache);
-    rbufpool = mempool_create(params->count * sizeof(double), mpiperf_isflushcache);
     if (sbufpool == NULL || rbufpool == NULL) {
         mempool_free(sbufpool);
         mempool_free(rbufpool);
         return MPIPERF_FAILURE;
     }
-    sbufsize = params->count * sizeof(double) * params->nprocs;
-    rbufsize = params->count * sizeof(double);
+    sbufsize = params->count * reduceop_typesize() * params->nprocs;
+    rbufsize = params->count * reduceop_typesize();
     return MPIPERF_SUCCESS;
 }
 
@@ -43,8 +45,9 @@ int bench_ireduce_scatter_block_free()
 int bench_ireduce_scatter_block_printinfo()
 {
     printf("* Ireduce_scatter_block\n"
-           "  proto: MPI_Ireduce_scatter_block(sbuf, rbuf, count, MPI_DOUBLE, \n"
-           "                                   MPI_SUM, comm)\n");
+           "  proto: MPI_Ireduce_scatter_block(sbuf, rbuf, count, %s, \n"
+           "                                   %s, comm)\n",
+           reduceop_typename(), reduceop_opname());
     return MPIPERF_SUCCESS;
 }
 
@@ -60,7 +63,8 @@ int measure_ireduce_scatter_block_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Ireduce_scatter_block(mempool_alloc(sbufpool, sbufsize),
                                    mempool_alloc(rbufpool, rbufsize), params->count,
-                                   MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                                   reduceop_datatype(), reduceop_op(), params->comm,
+                                   &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -88,7 +92,8 @@ int measure_ireduce_scatter_block_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Ireduce_scatter_block(mempool_alloc(sbufpool, sbufsize),
                                    mempool_alloc(rbufpool, rbufsize), params->count,
-                                   MPI_DOUBLE, MPI_SUM, params->comm, &req);
+                                   reduceop_datatype(), reduceop_op(), params->comm,
+                                   &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
@@ -13,11 +13,11 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
 static int sbufsize, rbufsize;
-static int root = 0;
 
 int bench_iscatter_init(nbctest_params_t *params)
 {
@@ -27,7 +27,7 @@ int bench_iscatter_init(nbctest_params_t *params)
     sbufsize = 0;
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         sbufpool = mempool_create(params->count * params->nprocs, mpiperf_isflushcache);
         if (sbufpool == NULL) {
             return MPIPERF_FAILURE;
@@ -54,7 +54,7 @@ int bench_iscatter_printinfo()
 {
     printf("* Iscatter\n"
            "  proto: MPI_Iscatter(sbuf, count, MPI_BYTE, \n"
-           "                      rbuf, count, MPI_BYTE, %d, comm)\n", root);
+           "                      rbuf, count, MPI_BYTE, root, comm)\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -70,7 +70,7 @@ int measure_iscatter_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iscatter(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                       mempool_alloc(rbufpool, rbufsize), params->count, MPI_BYTE,
-                      root, params->comm, &req);
+                      params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -98,7 +98,7 @@ int measure_iscatter_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iscatter(mempool_alloc(sbufpool, sbufsize), params->count, MPI_BYTE,
                       mempool_alloc(rbufpool, rbufsize), params->count, MPI_BYTE,
-                      root, params->comm, &req);
+                      params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
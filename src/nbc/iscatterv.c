@@ -13,6 +13,7 @@
 #include "hpctimer.h"
 #include "util.h"
 #include "mempool.h"
+#include "rootpolicy.h"
 
 static mempool_t *sbufpool = NULL;
 static mempool_t *rbufpool = NULL;
@@ -20,7 +21,6 @@ static int *sendcounts = NULL;
 static int *displs = NULL;
 static int sbufsize;
 static int rbufsize;
-static int root = 0;
 
 int bench_iscatterv_init(nbctest_params_t *params)
 {
@@ -32,7 +32,7 @@ int bench_iscatterv_init(nbctest_params_t *params)
     displs = NULL;
 
     MPI_Comm_rank(params->comm, &rank);
-    if (rank == root) {
+    if (rank == params->root || !rootpolicy_isfixed()) {
         sendcounts = malloc(sizeof(*sendcounts) * params->nprocs);
         displs = malloc(sizeof(*displs) * params->nprocs);
         if (sendcounts == NULL || displs == NULL) {
@@ -84,8 +84,8 @@ int bench_iscatterv_printinfo()
 {
     printf("* Iscatterv\n"
            "  proto: MPI_Iscatterv(sbuf, sendcounts, displs, MPI_BYTE, \n"
-           "                       rbuf, count, MPI_BYTE, %d, comm)\n"
-           "  For each element: sendcounts[i] = count\n", root);
+           "                       rbuf, count, MPI_BYTE, root, comm)\n"
+           "  For each element: sendcounts[i] = count\n");
     return MPIPERF_SUCCESS;
 }
 
@@ -101,7 +101,7 @@ int measure_iscatterv_blocking(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iscatterv(mempool_alloc(sbufpool, sbufsize), sendcounts, displs,
                        MPI_BYTE, mempool_alloc(rbufpool, rbufsize), params->count,
-                       MPI_BYTE, root, params->comm, &req);
+                       MPI_BYTE, params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     result->waittime = hpctimer_wtime();
     rc = MPI_Wait(&req, MPI_STATUS_IGNORE);
@@ -129,7 +129,7 @@ int measure_iscatterv_overlap(nbctest_params_t *params,
     result->inittime = hpctimer_wtime();
     rc = MPI_Iscatterv(mempool_alloc(sbufpool, sbufsize), sendcounts, displs,
                        MPI_BYTE, mempool_alloc(rbufpool, rbufsize), params->count,
-                       MPI_BYTE, root, params->comm, &req);
+                       MPI_BYTE, params->root, params->comm, &req);
     result->inittime = hpctimer_wtime() - result->inittime;
     nbcbench_simulate_computing(params, &req, result);
     result->waittime = hpctimer_wtime();
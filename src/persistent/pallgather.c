@@ -0,0 +1,99 @@
+/*
+ * pallgather.c: Benchmark functions for Allgather_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#include "pallgather.h"
+#include "bench_persistent.h"
+#include "mpiperf.h"
+#include "hpctimer.h"
+#include "util.h"
+#include "mempool.h"
+
+static mempool_t *sbufpool = NULL;
+static mempool_t *rbufpool = NULL;
+static int sbufsize, rbufsize;
+static MPI_Request req = MPI_REQUEST_NULL;
+
+/*
+ * bench_pallgather_init: Creates buffers and persistent request.
+ *                        Request is bound to the buffers, so cache defeat
+ *                        (-d) is not applicable.
+ */
+int bench_pallgather_init(nbctest_params_t *params)
+{
+    double time;
+
+    sbufpool = mempool_create(params->count, 0);
+    rbufpool = mempool_create(params->count * params->nprocs, 0);
+    if (sbufpool == NULL || rbufpool == NULL)
+        goto errhandler;
+    sbufsize = params->count;
+    rbufsize = params->count * params->nprocs;
+
+    if (measure_pallgather_reqinit(params, &time) != MEASURE_SUCCESS)
+        goto errhandler;
+    return MPIPERF_SUCCESS;
+
+errhandler:
+    mempool_free(sbufpool);
+    mempool_free(rbufpool);
+    sbufpool = NULL;
+    rbufpool = NULL;
+    return MPIPERF_FAILURE;
+}
+
+int bench_pallgather_free()
+{
+    if (req != MPI_REQUEST_NULL)
+        MPI_Request_free(&req);
+    mempool_free(sbufpool);
+    mempool_free(rbufpool);
+    return MPIPERF_SUCCESS;
+}
+
+int bench_pallgather_printinfo()
+{
+    printf("* Allgather_init\n"
+           "  proto: MPI_Allgather_init(sbuf, count, MPI_BYTE,\n"
+           "                            rbuf, count, MPI_BYTE, comm, info, req)\n"
+           "         MPI_Start(req), MPI_Wait(req)\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_pallgather_reqinit: Measures time of persistent request creation. */
+int measure_pallgather_reqinit(nbctest_params_t *params, double *time)
+{
+#ifdef HAVE_PERSISTENT_COLL
+    int rc;
+
+    if (req != MPI_REQUEST_NULL)
+        MPI_Request_free(&req);
+    *time = hpctimer_wtime();
+    rc = MPI_Allgather_init(mempool_alloc(sbufpool, sbufsize), params->count,
+                            MPI_BYTE, mempool_alloc(rbufpool, rbufsize),
+                            params->count, MPI_BYTE, params->comm,
+                            MPI_INFO_NULL, &req);
+    *time = hpctimer_wtime() - *time;
+
+    if (rc == MPI_SUCCESS)
+        return MEASURE_SUCCESS;
+    req = MPI_REQUEST_NULL;
+#endif
+    return MEASURE_FAILURE;
+}
+
+int measure_pallgather_blocking(nbctest_params_t *params,
+                                nbctest_result_t *result)
+{
+    return measure_persistent_blocking(&req, params, result);
+}
+
+int measure_pallgather_overlap(nbctest_params_t *params,
+                               nbctest_result_t *result)
+{
+    return measure_persistent_overlap(&req, params, result);
+}
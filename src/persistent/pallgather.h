@@ -0,0 +1,23 @@
+/*
+ * pallgather.h: Benchmark functions for Allgather_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PALLGATHER_H
+#define PALLGATHER_H
+
+#include "bench_persistent.h"
+
+int bench_pallgather_init(nbctest_params_t *params);
+int bench_pallgather_free();
+int bench_pallgather_printinfo();
+int measure_pallgather_reqinit(nbctest_params_t *params, double *time);
+int measure_pallgather_blocking(nbctest_params_t *params,
+                                nbctest_result_t *result);
+int measure_pallgather_overlap(nbctest_params_t *params,
+                               nbctest_result_t *result);
+
+#endif /* PALLGATHER_H */
@@ -0,0 +1,23 @@
+/*
+ * pallreduce.h: Benchmark functions for Allreduce_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PALLREDUCE_H
+#define PALLREDUCE_H
+
+#include "bench_persistent.h"
+
+int bench_pallreduce_init(nbctest_params_t *params);
+int bench_pallreduce_free();
+int bench_pallreduce_printinfo();
+int measure_pallreduce_reqinit(nbctest_params_t *params, double *time);
+int measure_pallreduce_blocking(nbctest_params_t *params,
+                                nbctest_result_t *result);
+int measure_pallreduce_overlap(nbctest_params_t *params,
+                               nbctest_result_t *result);
+
+#endif /* PALLREDUCE_H */
@@ -0,0 +1,23 @@
+/*
+ * palltoall.h: Benchmark functions for Alltoall_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PALLTOALL_H
+#define PALLTOALL_H
+
+#include "bench_persistent.h"
+
+int bench_palltoall_init(nbctest_params_t *params);
+int bench_palltoall_free();
+int bench_palltoall_printinfo();
+int measure_palltoall_reqinit(nbctest_params_t *params, double *time);
+int measure_palltoall_blocking(nbctest_params_t *params,
+                               nbctest_result_t *result);
+int measure_palltoall_overlap(nbctest_params_t *params,
+                              nbctest_result_t *result);
+
+#endif /* PALLTOALL_H */
@@ -0,0 +1,71 @@
+/*
+ * pbarrier.c: Benchmark functions for Barrier_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#include "pbarrier.h"
+#include "bench_persistent.h"
+#include "mpiperf.h"
+#include "hpctimer.h"
+#include "util.h"
+
+static MPI_Request req = MPI_REQUEST_NULL;
+
+/* bench_pbarrier_init: Creates persistent request. */
+int bench_pbarrier_init(nbctest_params_t *params)
+{
+    double time;
+
+    if (measure_pbarrier_reqinit(params, &time) != MEASURE_SUCCESS)
+        return MPIPERF_FAILURE;
+    return MPIPERF_SUCCESS;
+}
+
+int bench_pbarrier_free()
+{
+    if (req != MPI_REQUEST_NULL)
+        MPI_Request_free(&req);
+    return MPIPERF_SUCCESS;
+}
+
+int bench_pbarrier_printinfo()
+{
+    printf("* Barrier_init\n"
+           "  proto: MPI_Barrier_init(comm, info, req)\n"
+           "         MPI_Start(req), MPI_Wait(req)\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_pbarrier_reqinit: Measures time of persistent request creation. */
+int measure_pbarrier_reqinit(nbctest_params_t *params, double *time)
+{
+#ifdef HAVE_PERSISTENT_COLL
+    int rc;
+
+    if (req != MPI_REQUEST_NULL)
+        MPI_Request_free(&req);
+    *time = hpctimer_wtime();
+    rc = MPI_Barrier_init(params->comm, MPI_INFO_NULL, &req);
+    *time = hpctimer_wtime() - *time;
+
+    if (rc == MPI_SUCCESS)
+        return MEASURE_SUCCESS;
+    req = MPI_REQUEST_NULL;
+#endif
+    return MEASURE_FAILURE;
+}
+
+int measure_pbarrier_blocking(nbctest_params_t *params,
+                              nbctest_result_t *result)
+{
+    return measure_persistent_blocking(&req, params, result);
+}
+
+int measure_pbarrier_overlap(nbctest_params_t *params,
+                             nbctest_result_t *result)
+{
+    return measure_persistent_overlap(&req, params, result);
+}
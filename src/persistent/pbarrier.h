@@ -0,0 +1,23 @@
+/*
+ * pbarrier.h: Benchmark functions for Barrier_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PBARRIER_H
+#define PBARRIER_H
+
+#include "bench_persistent.h"
+
+int bench_pbarrier_init(nbctest_params_t *params);
+int bench_pbarrier_free();
+int bench_pbarrier_printinfo();
+int measure_pbarrier_reqinit(nbctest_params_t *params, double *time);
+int measure_pbarrier_blocking(nbctest_params_t *params,
+                              nbctest_result_t *result);
+int measure_pbarrier_overlap(nbctest_params_t *params,
+                             nbctest_result_t *result);
+
+#endif /* PBARRIER_H */
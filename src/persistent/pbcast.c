@@ -0,0 +1,91 @@
+/*
+ * pbcast.c: Benchmark functions for Bcast_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#include "pbcast.h"
+#include "bench_persistent.h"
+#include "mpiperf.h"
+#include "hpctimer.h"
+#include "util.h"
+#include "mempool.h"
+
+static mempool_t *bufpool = NULL;
+static int bufsize;
+static MPI_Request req = MPI_REQUEST_NULL;
+
+/*
+ * bench_pbcast_init: Creates buffers and persistent request.
+ *                    Request is bound to the buffers, so cache defeat
+ *                    (-d) is not applicable.
+ */
+int bench_pbcast_init(nbctest_params_t *params)
+{
+    double time;
+
+    bufpool = mempool_create(params->count, 0);
+    if (bufpool == NULL)
+        goto errhandler;
+    bufsize = params->count;
+
+    if (measure_pbcast_reqinit(params, &time) != MEASURE_SUCCESS)
+        goto errhandler;
+    return MPIPERF_SUCCESS;
+
+errhandler:
+    mempool_free(bufpool);
+    bufpool = NULL;
+    return MPIPERF_FAILURE;
+}
+
+int bench_pbcast_free()
+{
+    if (req != MPI_REQUEST_NULL)
+        MPI_Request_free(&req);
+    mempool_free(bufpool);
+    return MPIPERF_SUCCESS;
+}
+
+int bench_pbcast_printinfo()
+{
+    printf("* Bcast_init\n"
+           "  proto: MPI_Bcast_init(buf, count, MPI_BYTE, root, comm, info, req)\n"
+           "         MPI_Start(req), MPI_Wait(req)\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_pbcast_reqinit: Measures time of persistent request creation. */
+int measure_pbcast_reqinit(nbctest_params_t *params, double *time)
+{
+#ifdef HAVE_PERSISTENT_COLL
+    int rc;
+
+    if (req != MPI_REQUEST_NULL)
+        MPI_Request_free(&req);
+    *time = hpctimer_wtime();
+    rc = MPI_Bcast_init(mempool_alloc(bufpool, bufsize), params->count,
+                        MPI_BYTE, params->root, params->comm, MPI_INFO_NULL,
+                        &req);
+    *time = hpctimer_wtime() - *time;
+
+    if (rc == MPI_SUCCESS)
+        return MEASURE_SUCCESS;
+    req = MPI_REQUEST_NULL;
+#endif
+    return MEASURE_FAILURE;
+}
+
+int measure_pbcast_blocking(nbctest_params_t *params,
+                            nbctest_result_t *result)
+{
+    return measure_persistent_blocking(&req, params, result);
+}
+
+int measure_pbcast_overlap(nbctest_params_t *params,
+                           nbctest_result_t *result)
+{
+    return measure_persistent_overlap(&req, params, result);
+}
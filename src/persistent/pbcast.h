@@ -0,0 +1,23 @@
+/*
+ * pbcast.h: Benchmark functions for Bcast_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PBCAST_H
+#define PBCAST_H
+
+#include "bench_persistent.h"
+
+int bench_pbcast_init(nbctest_params_t *params);
+int bench_pbcast_free();
+int bench_pbcast_printinfo();
+int measure_pbcast_reqinit(nbctest_params_t *params, double *time);
+int measure_pbcast_blocking(nbctest_params_t *params,
+                            nbctest_result_t *result);
+int measure_pbcast_overlap(nbctest_params_t *params,
+                           nbctest_result_t *result);
+
+#endif /* PBCAST_H */
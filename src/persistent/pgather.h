@@ -0,0 +1,23 @@
+/*
+ * pgather.h: Benchmark functions for Gather_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PGATHER_H
+#define PGATHER_H
+
+#include "bench_persistent.h"
+
+int bench_pgather_init(nbctest_params_t *params);
+int bench_pgather_free();
+int bench_pgather_printinfo();
+int measure_pgather_reqinit(nbctest_params_t *params, double *time);
+int measure_pgather_blocking(nbctest_params_t *params,
+                             nbctest_result_t *result);
+int measure_pgather_overlap(nbctest_params_t *params,
+                            nbctest_result_t *result);
+
+#endif /* PGATHER_H */
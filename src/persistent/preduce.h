@@ -0,0 +1,23 @@
+/*
+ * preduce.h: Benchmark functions for Reduce_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PREDUCE_H
+#define PREDUCE_H
+
+#include "bench_persistent.h"
+
+int bench_preduce_init(nbctest_params_t *params);
+int bench_preduce_free();
+int bench_preduce_printinfo();
+int measure_preduce_reqinit(nbctest_params_t *params, double *time);
+int measure_preduce_blocking(nbctest_params_t *params,
+                             nbctest_result_t *result);
+int measure_preduce_overlap(nbctest_params_t *params,
+                            nbctest_result_t *result);
+
+#endif /* PREDUCE_H */
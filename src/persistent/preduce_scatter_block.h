@@ -0,0 +1,23 @@
+/*
+ * preduce_scatter_block.h: Benchmark functions for Reduce_scatter_block_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PREDUCE_SCATTER_BLOCK_H
+#define PREDUCE_SCATTER_BLOCK_H
+
+#include "bench_persistent.h"
+
+int bench_preduce_scatter_block_init(nbctest_params_t *params);
+int bench_preduce_scatter_block_free();
+int bench_preduce_scatter_block_printinfo();
+int measure_preduce_scatter_block_reqinit(nbctest_params_t *params, double *time);
+int measure_preduce_scatter_block_blocking(nbctest_params_t *params,
+                                           nbctest_result_t *result);
+int measure_preduce_scatter_block_overlap(nbctest_params_t *params,
+                                          nbctest_result_t *result);
+
+#endif /* PREDUCE_SCATTER_BLOCK_H */
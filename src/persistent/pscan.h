@@ -0,0 +1,23 @@
+/*
+ * pscan.h: Benchmark functions for Scan_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PSCAN_H
+#define PSCAN_H
+
+#include "bench_persistent.h"
+
+int bench_pscan_init(nbctest_params_t *params);
+int bench_pscan_free();
+int bench_pscan_printinfo();
+int measure_pscan_reqinit(nbctest_params_t *params, double *time);
+int measure_pscan_blocking(nbctest_params_t *params,
+                           nbctest_result_t *result);
+int measure_pscan_overlap(nbctest_params_t *params,
+                          nbctest_result_t *result);
+
+#endif /* PSCAN_H */
@@ -0,0 +1,23 @@
+/*
+ * pscatter.h: Benchmark functions for Scatter_init.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PSCATTER_H
+#define PSCATTER_H
+
+#include "bench_persistent.h"
+
+int bench_pscatter_init(nbctest_params_t *params);
+int bench_pscatter_free();
+int bench_pscatter_printinfo();
+int measure_pscatter_reqinit(nbctest_params_t *params, double *time);
+int measure_pscatter_blocking(nbctest_params_t *params,
+                              nbctest_result_t *result);
+int measure_pscatter_overlap(nbctest_params_t *params,
+                             nbctest_result_t *result);
+
+#endif /* PSCATTER_H */
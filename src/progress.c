@@ -0,0 +1,176 @@
+/*
+ * progress.c: Asynchronous progress thread for NBC overlap benchmarks.
+ *
+ * Progress thread waits for a request of the current run and calls MPI_Test
+ * on it while the main thread computes. The main thread passes the request
+ * to the thread by progress_start and takes it back by progress_stop, so
+ * the request is never used by both threads concurrently.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include <mpi.h>
+
+#include "progress.h"
+#include "mpiperf.h"
+#include "logger.h"
+#include "util.h"
+
+enum ProgressState {
+    PROGRESS_IDLE = 0,      /* Waiting for request */
+    PROGRESS_POLL = 1,      /* Polling request */
+    PROGRESS_STOP = 2,      /* Main thread takes request back */
+    PROGRESS_EXIT = 3
+};
+
+static pthread_t thread;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static volatile int state = PROGRESS_IDLE;
+static MPI_Request *progress_request = NULL;
+static int progress_ntests = 0;
+static int progress_cpuid = -1;
+static int isstarted = 0;
+
+static void *progress_thread(void *arg);
+static int progress_spare_cpu();
+
+/* progress_initialize: */
+int progress_initialize()
+{
+    int provided;
+
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_MULTIPLE) {
+        exit_error("Progress thread requires MPI_THREAD_MULTIPLE (provided level: %d)",
+                   provided);
+    }
+
+    progress_cpuid = progress_spare_cpu();
+    state = PROGRESS_IDLE;
+    if (pthread_create(&thread, NULL, progress_thread, NULL) != 0) {
+        exit_error("Can't create progress thread");
+    }
+    isstarted = 1;
+    logger_log("Progress thread is started (core %d)", progress_cpuid);
+    return MPIPERF_SUCCESS;
+}
+
+/* progress_finalize: */
+void progress_finalize()
+{
+    if (!isstarted)
+        return;
+    pthread_mutex_lock(&lock);
+    state = PROGRESS_EXIT;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&lock);
+    pthread_join(thread, NULL);
+    isstarted = 0;
+}
+
+/* progress_start: */
+void progress_start(MPI_Request *request)
+{
+    pthread_mutex_lock(&lock);
+    progress_request = request;
+    progress_ntests = 0;
+    state = PROGRESS_POLL;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&lock);
+}
+
+/* progress_stop: */
+int progress_stop()
+{
+    int ntests;
+
+    pthread_mutex_lock(&lock);
+    state = PROGRESS_STOP;
+    while (state != PROGRESS_IDLE)
+        pthread_cond_wait(&cond, &lock);
+    ntests = progress_ntests;
+    progress_request = NULL;
+    pthread_mutex_unlock(&lock);
+    return ntests;
+}
+
+/* progress_cpu: */
+int progress_cpu()
+{
+    return progress_cpuid;
+}
+
+/* progress_thread: Polls request until the main thread takes it back. */
+static void *progress_thread(void *arg)
+{
+    cpu_set_t set;
+    int flag = 0;
+
+    if (progress_cpuid >= 0) {
+        CPU_ZERO(&set);
+        CPU_SET(progress_cpuid, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (state == PROGRESS_IDLE)
+            pthread_cond_wait(&cond, &lock);
+        if (state == PROGRESS_EXIT)
+            break;
+
+        flag = 0;
+        while (state == PROGRESS_POLL) {
+            pthread_mutex_unlock(&lock);
+            if (!flag) {
+                MPI_Test(progress_request, &flag, MPI_STATUS_IGNORE);
+                progress_ntests++;
+            }
+            pthread_mutex_lock(&lock);
+        }
+        if (state == PROGRESS_STOP) {
+            state = PROGRESS_IDLE;
+            pthread_cond_broadcast(&cond);
+        }
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+/*
+ * progress_spare_cpu: Returns core for progress thread: processes of a node
+ *                     take cores from the end of the affinity mask
+ *                     (skipping the core of the main thread).
+ */
+static int progress_spare_cpu()
+{
+    cpu_set_t set;
+    int cpu, self, localrank = 0;
+#if MPI_VERSION >= 3
+    MPI_Comm nodecomm;
+
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+                        MPI_INFO_NULL, &nodecomm);
+    MPI_Comm_rank(nodecomm, &localrank);
+    MPI_Comm_free(&nodecomm);
+#endif
+
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        return -1;
+    self = sched_getcpu();
+    for (cpu = CPU_SETSIZE - 1; cpu >= 0; cpu--) {
+        if (CPU_ISSET(cpu, &set) && cpu != self) {
+            if (localrank-- == 0)
+                return cpu;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,35 @@
+/*
+ * progress.h: Asynchronous progress thread for NBC overlap benchmarks.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <mpi.h>
+
+/*
+ * progress_initialize: Starts progress thread pinned to a spare core.
+ *                      MPI must be initialized with MPI_THREAD_MULTIPLE.
+ */
+int progress_initialize();
+
+/*
+ * progress_start: Progress thread starts polling of request by MPI_Test.
+ *                 Calling thread must not use request until progress_stop.
+ */
+void progress_start(MPI_Request *request);
+
+/*
+ * progress_stop: Stops polling of request and returns number
+ *                of MPI_Test calls.
+ */
+int progress_stop();
+
+/* progress_cpu: Returns core of progress thread or -1 if it is not pinned. */
+int progress_cpu();
+
+void progress_finalize();
+
+#endif /* PROGRESS_H */
@@ -0,0 +1,109 @@
+/*
+ * bandwidth.c: Benchmark functions for Bandwidth (window of messages).
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "bandwidth.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "mempool.h"
+#include "util.h"
+
+enum {
+    BANDWIDTH_TAG = 0,
+    BANDWIDTH_ACK_TAG = 1
+};
+
+static mempool_t *buf = NULL;
+static MPI_Request *reqs = NULL;
+static int bufsize;
+static int window;
+static int rank, peer, issender;
+
+/* bench_bandwidth_init: */
+int bench_bandwidth_init(pt2pttest_params_t *params)
+{
+    window = mpiperf_pt2pt_window;
+    params->nmsgs = window;
+
+    /* Each message of the window has own buffer */
+    bufsize = params->count * window * sizeof(char);
+    buf = mempool_create(bufsize, mpiperf_isflushcache);
+    if (buf == NULL) {
+        return MPIPERF_FAILURE;
+    }
+    reqs = xmalloc(sizeof(*reqs) * window);
+    MPI_Comm_rank(params->comm, &rank);
+    peer = pt2ptbench_peer(params, rank, &issender);
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_bandwidth_free: */
+int bench_bandwidth_free()
+{
+    mempool_free(buf);
+    buf = NULL;
+    free(reqs);
+    reqs = NULL;
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_bandwidth_printinfo: */
+int bench_bandwidth_printinfo()
+{
+    printf("* Bandwidth\n"
+           "  proto: MPI_Isend(sbuf[i], count, MPI_BYTE, 1, 0, comm, &reqs[i]), i = 0, ..., window - 1\n"
+           "         MPI_Waitall(window, reqs)\n"
+           "         MPI_Recv(NULL, 0, MPI_BYTE, 1, 1, comm)\n"
+           "  Process 1 posts window of MPI_Irecv and sends zero-byte ack after MPI_Waitall\n"
+           "  Window is set by option -W. This benchmark measures time of master process only\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_bandwidth_sync: */
+int measure_bandwidth_sync(pt2pttest_params_t *params, double *time)
+{
+    double starttime, endtime;
+    char *p;
+    int i, rc = MPI_SUCCESS;
+
+    starttime = timeslot_startsync();
+    p = mempool_alloc(buf, bufsize);
+    if (issender) {
+        for (i = 0; i < window; i++) {
+            MPI_Isend(p + i * params->count, params->count, MPI_BYTE, peer,
+                      BANDWIDTH_TAG, params->comm, &reqs[i]);
+        }
+        rc = MPI_Waitall(window, reqs, MPI_STATUSES_IGNORE);
+        if (rc == MPI_SUCCESS) {
+            rc = MPI_Recv(NULL, 0, MPI_BYTE, peer, BANDWIDTH_ACK_TAG, params->comm,
+                          MPI_STATUS_IGNORE);
+        }
+    } else {
+        for (i = 0; i < window; i++) {
+            MPI_Irecv(p + i * params->count, params->count, MPI_BYTE, peer,
+                      BANDWIDTH_TAG, params->comm, &reqs[i]);
+        }
+        rc = MPI_Waitall(window, reqs, MPI_STATUSES_IGNORE);
+        if (rc == MPI_SUCCESS) {
+            rc = MPI_Send(NULL, 0, MPI_BYTE, peer, BANDWIDTH_ACK_TAG, params->comm);
+        }
+    }
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+    return MEASURE_FAILURE;
+}
@@ -0,0 +1,19 @@
+/*
+ * bandwidth.h: Benchmark functions for Bandwidth.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef BANDWIDTH_H
+#define BANDWIDTH_H
+
+#include "bench_pt2pt.h"
+
+int bench_bandwidth_init(pt2pttest_params_t *params);
+int bench_bandwidth_free();
+int bench_bandwidth_printinfo();
+int measure_bandwidth_sync(pt2pttest_params_t *params, double *time);
+
+#endif /* BANDWIDTH_H */
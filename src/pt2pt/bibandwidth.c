@@ -0,0 +1,103 @@
+/*
+ * bibandwidth.c: Benchmark functions for BiBandwidth (window of messages
+ *                in both directions).
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "bibandwidth.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "mempool.h"
+#include "util.h"
+
+static mempool_t *sbuf = NULL;
+static mempool_t *rbuf = NULL;
+static MPI_Request *reqs = NULL;
+static int bufsize;
+static int window;
+static int rank, peer, issender;
+
+/* bench_bibandwidth_init: */
+int bench_bibandwidth_init(pt2pttest_params_t *params)
+{
+    window = mpiperf_pt2pt_window;
+    /* Master sends and receives window of messages */
+    params->nmsgs = 2 * window;
+
+    bufsize = params->count * window * sizeof(char);
+    sbuf = mempool_create(bufsize, mpiperf_isflushcache);
+    rbuf = mempool_create(bufsize, mpiperf_isflushcache);
+    if (sbuf == NULL || rbuf == NULL) {
+        mempool_free(sbuf);
+        mempool_free(rbuf);
+        sbuf = NULL;
+        rbuf = NULL;
+        return MPIPERF_FAILURE;
+    }
+    reqs = xmalloc(sizeof(*reqs) * 2 * window);
+    MPI_Comm_rank(params->comm, &rank);
+    peer = pt2ptbench_peer(params, rank, &issender);
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_bibandwidth_free: */
+int bench_bibandwidth_free()
+{
+    mempool_free(sbuf);
+    mempool_free(rbuf);
+    sbuf = NULL;
+    rbuf = NULL;
+    free(reqs);
+    reqs = NULL;
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_bibandwidth_printinfo: */
+int bench_bibandwidth_printinfo()
+{
+    printf("* BiBandwidth\n"
+           "  proto: MPI_Irecv(rbuf[i], count, MPI_BYTE, peer, 0, comm, &reqs[i]), i = 0, ..., window - 1\n"
+           "         MPI_Isend(sbuf[i], count, MPI_BYTE, peer, 0, comm, &reqs[window + i])\n"
+           "         MPI_Waitall(2 * window, reqs)\n"
+           "  Processes 0 and 1 exchange windows of messages simultaneously\n"
+           "  Window is set by option -W. This benchmark measures time of master process only\n");
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_bibandwidth_sync: */
+int measure_bibandwidth_sync(pt2pttest_params_t *params, double *time)
+{
+    double starttime, endtime;
+    char *sp, *rp;
+    int i, rc;
+
+    starttime = timeslot_startsync();
+    sp = mempool_alloc(sbuf, bufsize);
+    rp = mempool_alloc(rbuf, bufsize);
+    for (i = 0; i < window; i++) {
+        MPI_Irecv(rp + i * params->count, params->count, MPI_BYTE, peer, 0,
+                  params->comm, &reqs[i]);
+    }
+    for (i = 0; i < window; i++) {
+        MPI_Isend(sp + i * params->count, params->count, MPI_BYTE, peer, 0,
+                  params->comm, &reqs[window + i]);
+    }
+    rc = MPI_Waitall(2 * window, reqs, MPI_STATUSES_IGNORE);
+    endtime = timeslot_stopsync();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+    return MEASURE_FAILURE;
+}
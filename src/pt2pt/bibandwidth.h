@@ -0,0 +1,19 @@
+/*
+ * bibandwidth.h: Benchmark functions for BiBandwidth.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef BIBANDWIDTH_H
+#define BIBANDWIDTH_H
+
+#include "bench_pt2pt.h"
+
+int bench_bibandwidth_init(pt2pttest_params_t *params);
+int bench_bibandwidth_free();
+int bench_bibandwidth_printinfo();
+int measure_bibandwidth_sync(pt2pttest_params_t *params, double *time);
+
+#endif /* BIBANDWIDTH_H */
@@ -19,7 +19,7 @@
 
 static mempool_t *buf = NULL;
 static int bufsize;
-static int rank;
+static int rank, peer, issender;
 
 /* bench_send_init: */
 int bench_send_init(pt2pttest_params_t *params)
@@ -30,6 +30,7 @@ int bench_send_init(pt2pttest_params_t *params)
         return MPIPERF_FAILURE;
     }
     MPI_Comm_rank(params->comm, &rank);
+    peer = pt2ptbench_peer(params, rank, &issender);
     return MPIPERF_SUCCESS;
 }
 
@@ -57,12 +58,12 @@ int measure_send_sync(pt2pttest_params_t *params, double *time)
     int rc = 0;
     
     starttime = timeslot_startsync();
-    if (rank == 0) {
-        rc = MPI_Send(mempool_alloc(buf, bufsize), params->count, MPI_BYTE, 1, 0,
-                      params->comm);
-    } else if (rank == 1) {
-        rc = MPI_Recv(mempool_alloc(buf, bufsize), params->count, MPI_BYTE, 0, 0,
-                      params->comm, MPI_STATUS_IGNORE);
+    if (issender) {
+        rc = MPI_Send(mempool_alloc(buf, bufsize), params->count, MPI_BYTE, peer,
+                      0, params->comm);
+    } else {
+        rc = MPI_Recv(mempool_alloc(buf, bufsize), params->count, MPI_BYTE, peer,
+                      0, params->comm, MPI_STATUS_IGNORE);
     }
     endtime = timeslot_stopsync();
 
@@ -77,3 +78,27 @@ int measure_send_sync(pt2pttest_params_t *params, double *time)
     return MEASURE_FAILURE;
 }
 
+
+/* measure_send_pingpong: */
+int measure_send_pingpong(pt2pttest_params_t *params, double *time)
+{
+    void *sbuf;
+    int rc;
+
+    sbuf = mempool_alloc(buf, bufsize);
+    if (issender) {
+        rc = MPI_Send(sbuf, params->count, MPI_BYTE, peer, 0, params->comm);
+        if (rc == MPI_SUCCESS) {
+            rc = MPI_Recv(sbuf, params->count, MPI_BYTE, peer, 0,
+                          params->comm, MPI_STATUS_IGNORE);
+        }
+    } else {
+        rc = MPI_Recv(sbuf, params->count, MPI_BYTE, peer, 0, params->comm,
+                      MPI_STATUS_IGNORE);
+        if (rc == MPI_SUCCESS) {
+            rc = MPI_Send(sbuf, params->count, MPI_BYTE, peer, 0,
+                          params->comm);
+        }
+    }
+    return (rc == MPI_SUCCESS) ? MEASURE_SUCCESS : MEASURE_FAILURE;
+}
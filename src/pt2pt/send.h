@@ -16,4 +16,10 @@ int bench_send_free();
 int bench_send_printinfo();
 int measure_send_sync(pt2pttest_params_t *params, double *time);
 
+/*
+ * measure_send_pingpong: Message is sent to peer and back (nosync mode),
+ *                        time is not measured.
+ */
+int measure_send_pingpong(pt2pttest_params_t *params, double *time);
+
 #endif /* SEND_H */
@@ -21,7 +21,7 @@ static mempool_t *sbuf = NULL;
 static mempool_t *rbuf = NULL;
 static int sbufsize;
 static int rbufsize;
-static int rank;
+static int rank, peer, issender;
 
 /* bench_sendrecv_init: */
 int bench_sendrecv_init(pt2pttest_params_t *params)
@@ -36,6 +36,7 @@ int bench_sendrecv_init(pt2pttest_params_t *params)
         return MPIPERF_FAILURE;
     }
     MPI_Comm_rank(params->comm, &rank);
+    peer = pt2ptbench_peer(params, rank, &issender);
     return MPIPERF_SUCCESS;
 }
 
@@ -63,19 +64,11 @@ int measure_sendrecv_sync(pt2pttest_params_t *params, double *time)
     int rc = 0;
     
     starttime = timeslot_startsync();
-    if (rank == 0) {
-        rc = MPI_Sendrecv(mempool_alloc(sbuf, sizeof(char) * params->count),
-                          params->count, MPI_BYTE, 1, 0,
-                          mempool_alloc(rbuf, sizeof(char) * params->count),
-                          params->count, MPI_BYTE, 1, 0, params->comm,
-                          MPI_STATUS_IGNORE);
-    } else if (rank == 1) {
-        rc = MPI_Sendrecv(mempool_alloc(sbuf, sizeof(char) * params->count),
-                          params->count, MPI_BYTE, 0, 0,
-                          mempool_alloc(rbuf, sizeof(char) * params->count),
-                          params->count, MPI_BYTE, 0, 0, params->comm,
-                          MPI_STATUS_IGNORE);
-    }
+    rc = MPI_Sendrecv(mempool_alloc(sbuf, sizeof(char) * params->count),
+                      params->count, MPI_BYTE, peer, 0,
+                      mempool_alloc(rbuf, sizeof(char) * params->count),
+                      params->count, MPI_BYTE, peer, 0, params->comm,
+                      MPI_STATUS_IGNORE);
     endtime = timeslot_stopsync();
 
     if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
@@ -0,0 +1,252 @@
+/*
+ * reduceop.c: Reduction operations for benchmarks of reduce routines.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include <mpi.h>
+
+#include "reduceop.h"
+#include "mpiperf.h"
+#include "logger.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  include <immintrin.h>
+#  define HAVE_REDUCEOP_SIMD
+#endif
+
+typedef void (*reduceop_userfn_ptr_t)(void *, void *, int *, MPI_Datatype *);
+
+/* Reduction operation */
+typedef struct {
+    char *name;             /* Name for command line option -O */
+    char *opname;           /* Name in reports */
+    int type;
+} reduceop_t;
+
+static reduceop_t reduceoptab[] = {
+    {"sum",      "MPI_SUM",    REDUCEOP_SUM},
+    {"max",      "MPI_MAX",    REDUCEOP_MAX},
+    {"min",      "MPI_MIN",    REDUCEOP_MIN},
+    {"prod",     "MPI_PROD",   REDUCEOP_PROD},
+    {"band",     "MPI_BAND",   REDUCEOP_BAND},
+    {"maxloc",   "MPI_MAXLOC", REDUCEOP_MAXLOC},
+    {"user",     "user_sum",   REDUCEOP_USER},
+    {"usersimd", "user_sum_simd", REDUCEOP_USER_SIMD}
+};
+
+static int reduceop_type = REDUCEOP_SUM;
+static MPI_Op reduceop_userop = MPI_OP_NULL;
+static size_t reduceop_extent = sizeof(double);
+static const char *reduceop_username = NULL;
+
+static void reduceop_user_sum(void *in, void *inout, int *len,
+                              MPI_Datatype *dtype);
+#ifdef HAVE_REDUCEOP_SIMD
+static void reduceop_user_sum_avx2(void *in, void *inout, int *len,
+                                   MPI_Datatype *dtype);
+static void reduceop_user_sum_avx512(void *in, void *inout, int *len,
+                                     MPI_Datatype *dtype);
+#endif
+
+/* reduceop_lookup: Returns type of operation by name or -1. */
+int reduceop_lookup(const char *name)
+{
+    int i;
+
+    for (i = 0; i < NELEMS(reduceoptab); i++) {
+        if (strcasecmp(reduceoptab[i].name, name) == 0) {
+            return reduceoptab[i].type;
+        }
+    }
+    return -1;
+}
+
+/* reduceop_initialize: Creates user-defined operation (if needed). */
+int reduceop_initialize(int optype)
+{
+    reduceop_userfn_ptr_t userfn = NULL;
+    MPI_Aint lb, extent;
+
+    reduceop_type = optype;
+    reduceop_userop = MPI_OP_NULL;
+    reduceop_username = NULL;
+
+    if (reduceop_type == REDUCEOP_USER) {
+        userfn = reduceop_user_sum;
+        reduceop_username = "scalar";
+    } else if (reduceop_type == REDUCEOP_USER_SIMD) {
+        userfn = reduceop_user_sum;
+        reduceop_username = "scalar (no SIMD support)";
+#ifdef HAVE_REDUCEOP_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            userfn = reduceop_user_sum_avx512;
+            reduceop_username = "avx512f";
+        } else if (__builtin_cpu_supports("avx2")) {
+            userfn = reduceop_user_sum_avx2;
+            reduceop_username = "avx2";
+        }
+#endif
+    }
+
+    if (userfn) {
+        if (MPI_Op_create(userfn, 1, &reduceop_userop) != MPI_SUCCESS)
+            return MPIPERF_FAILURE;
+        logger_log("User-defined reduction operation is created: %s",
+                   reduceop_username);
+    }
+
+    MPI_Type_get_extent(reduceop_datatype(), &lb, &extent);
+    reduceop_extent = extent;
+    return MPIPERF_SUCCESS;
+}
+
+/* reduceop_finalize: */
+void reduceop_finalize()
+{
+    if (reduceop_userop != MPI_OP_NULL)
+        MPI_Op_free(&reduceop_userop);
+}
+
+/* reduceop_op: Returns MPI operation for reduce routines. */
+MPI_Op reduceop_op()
+{
+    switch (reduceop_type) {
+    case REDUCEOP_MAX:
+        return MPI_MAX;
+    case REDUCEOP_MIN:
+        return MPI_MIN;
+    case REDUCEOP_PROD:
+        return MPI_PROD;
+    case REDUCEOP_BAND:
+        return MPI_BAND;
+    case REDUCEOP_MAXLOC:
+        return MPI_MAXLOC;
+    case REDUCEOP_USER:
+    case REDUCEOP_USER_SIMD:
+        return reduceop_userop;
+    }
+    return MPI_SUM;
+}
+
+/*
+ * reduceop_datatype: Returns type of buffer elements.
+ *                    Bitwise operations require integer type and
+ *                    MPI_MAXLOC requires pair type.
+ */
+MPI_Datatype reduceop_datatype()
+{
+    if (reduceop_type == REDUCEOP_BAND) {
+        return MPI_LONG_LONG;
+    } else if (reduceop_type == REDUCEOP_MAXLOC) {
+        return MPI_DOUBLE_INT;
+    }
+    return MPI_DOUBLE;
+}
+
+/* reduceop_typesize: Returns extent of buffer element. */
+size_t reduceop_typesize()
+{
+    return reduceop_extent;
+}
+
+/* reduceop_opname: */
+const char *reduceop_opname()
+{
+    int i;
+
+    for (i = 0; i < NELEMS(reduceoptab); i++) {
+        if (reduceoptab[i].type == reduceop_type) {
+            return reduceoptab[i].opname;
+        }
+    }
+    return "MPI_SUM";
+}
+
+/* reduceop_typename: */
+const char *reduceop_typename()
+{
+    if (reduceop_type == REDUCEOP_BAND) {
+        return "MPI_LONG_LONG";
+    } else if (reduceop_type == REDUCEOP_MAXLOC) {
+        return "MPI_DOUBLE_INT";
+    }
+    return "MPI_DOUBLE";
+}
+
+/* reduceop_print_ops: Prints operation for report header. */
+void reduceop_print_ops()
+{
+    printf("# Reduction operation: %s, %s", reduceop_opname(),
+           reduceop_typename());
+    if (reduceop_username)
+        printf(" (user-defined: %s)", reduceop_username);
+    printf("\n");
+}
+
+/*
+ * reduceop_user_sum: User-defined sum of doubles.
+ *                    Vectorization is disabled to measure pure scalar loop.
+ */
+#ifdef __GNUC__
+__attribute__((optimize("no-tree-vectorize")))
+#endif
+static void reduceop_user_sum(void *in, void *inout, int *len,
+                              MPI_Datatype *dtype)
+{
+    double *a = (double *)in, *b = (double *)inout;
+    int i, n = *len;
+
+    for (i = 0; i < n; i++) {
+        b[i] += a[i];
+    }
+}
+
+#ifdef HAVE_REDUCEOP_SIMD
+/* reduceop_user_sum_avx2: User-defined sum of doubles (AVX2). */
+__attribute__((target("avx2")))
+static void reduceop_user_sum_avx2(void *in, void *inout, int *len,
+                                   MPI_Datatype *dtype)
+{
+    double *a = (double *)in, *b = (double *)inout;
+    int i, n = *len;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(a + i);
+        __m256d x1 = _mm256_loadu_pd(a + i + 4);
+        __m256d y0 = _mm256_loadu_pd(b + i);
+        __m256d y1 = _mm256_loadu_pd(b + i + 4);
+        _mm256_storeu_pd(b + i, _mm256_add_pd(x0, y0));
+        _mm256_storeu_pd(b + i + 4, _mm256_add_pd(x1, y1));
+    }
+    for (; i < n; i++) {
+        b[i] += a[i];
+    }
+}
+
+/* reduceop_user_sum_avx512: User-defined sum of doubles (AVX-512F). */
+__attribute__((target("avx512f")))
+static void reduceop_user_sum_avx512(void *in, void *inout, int *len,
+                                     MPI_Datatype *dtype)
+{
+    double *a = (double *)in, *b = (double *)inout;
+    int i, n = *len;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m512d x0 = _mm512_loadu_pd(a + i);
+        __m512d x1 = _mm512_loadu_pd(a + i + 8);
+        __m512d y0 = _mm512_loadu_pd(b + i);
+        __m512d y1 = _mm512_loadu_pd(b + i + 8);
+        _mm512_storeu_pd(b + i, _mm512_add_pd(x0, y0));
+        _mm512_storeu_pd(b + i + 8, _mm512_add_pd(x1, y1));
+    }
+    for (; i < n; i++) {
+        b[i] += a[i];
+    }
+}
+#endif /* HAVE_REDUCEOP_SIMD */
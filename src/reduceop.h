@@ -0,0 +1,45 @@
+/*
+ * reduceop.h: Reduction operations for benchmarks of reduce routines.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef REDUCEOP_H
+#define REDUCEOP_H
+
+#include <stddef.h>
+
+#include <mpi.h>
+
+enum ReduceOpType {
+    REDUCEOP_SUM = 0,
+    REDUCEOP_MAX = 1,
+    REDUCEOP_MIN = 2,
+    REDUCEOP_PROD = 3,
+    REDUCEOP_BAND = 4,
+    REDUCEOP_MAXLOC = 5,
+    REDUCEOP_USER = 6,        /* MPI_Op_create: scalar loop */
+    REDUCEOP_USER_SIMD = 7    /* MPI_Op_create: AVX2/AVX-512 loop */
+};
+
+/* reduceop_lookup: Returns type of operation by name or -1. */
+int reduceop_lookup(const char *name);
+
+/*
+ * reduceop_initialize: Creates user-defined operation (if needed).
+ *                      Must be called after MPI_Init.
+ */
+int reduceop_initialize(int optype);
+void reduceop_finalize();
+
+MPI_Op reduceop_op();
+MPI_Datatype reduceop_datatype();
+size_t reduceop_typesize();
+
+/* Names for reports and printinfo functions */
+const char *reduceop_opname();
+const char *reduceop_typename();
+
+void reduceop_print_ops();
+
+#endif /* REDUCEOP_H */
@@ -15,11 +15,16 @@
 #include "stat.h"
 #include "util.h"
 #include "hpctimer.h"
+#include "reduceop.h"
+#include "rootpolicy.h"
+#include "topo.h"
+#include "compkernel.h"
 
 int report_write_header()
 {
     int i, namelen;
     char procname[MPI_MAX_PROCESSOR_NAME];
+    char buf[128];
 
     if (IS_MASTER_RANK) {
         printf("# mpiperf %d.%d.%d report\n", MPIPERF_VERSION_MAJOR,
@@ -39,20 +44,43 @@ int report_write_header()
         } else if (mpiperf_test_exit_cond == TEST_EXIT_COND_STDERR) {
             printf("# Test exit condition: relative stdandard error of measurements <= %.2f\n",
                    mpiperf_rse_max);
+        } else if (mpiperf_test_exit_cond == TEST_EXIT_COND_MEDIAN_CI) {
+            printf("# Test exit condition: relative half-width of bootstrap CI of median <= %.2f\n",
+                   mpiperf_ciw_max);
+        }
+        if (mpiperf_bootstrap_nreplicates > 0) {
+            printf("# Bootstrap replicates: %d\n", mpiperf_bootstrap_nreplicates);
         }
 
         printf("# Minimal number of runs: %d\n", mpiperf_nruns_min);
         printf("# Maximal number of runs: %d\n", mpiperf_nruns_max);
         printf("# Statistical analysis of data (removing outliers): %s\n",
                mpiperf_statanalysis ? "on" : "off");
+        printf("# Detection of warmup transient: %s\n",
+               mpiperf_warmupdetect ? "on" : "off");
+        if (mpiperf_statanalysis) {
+            printf("# Outliers filter: %s\n",
+                   stat_outliers_name(&mpiperf_outliers, buf, sizeof(buf)));
+        }
         printf("# Compute time iterations: %d\n", mpiperf_comptime_niters);
+        compkernel_print_info();
         printf("# Cache defeat: %s\n", mpiperf_isflushcache ? "on" : "off");
+        reduceop_print_ops();
+        if (rootpolicy_isfixed()) {
+            printf("# Root policy: fixed (root %d)\n", mpiperf_root);
+        } else {
+            printf("# Root policy: %s\n", rootpolicy_name());
+        }
+        topo_print_info();
         printf("# Timer: %s\n", mpiperf_timername);
         if (mpiperf_timescale == TIMESCALE_SEC) {
             printf("# Time scale: seconds\n");
         } else {
             printf("# Time scale: microseconds\n");
         }
+        printf("# Thread support: %s (required %s)\n",
+               thread_level_name(mpiperf_thread_provided),
+               thread_level_name(mpiperf_thread_required));
         if (mpiperf_synctype == SYNC_TIME) {
             printf("# Synchronization method: synctime\n");
         } else {
@@ -61,6 +89,18 @@ int report_write_header()
         if (mpiperf_perprocreport) {
             printf("# Per process report file: %s\n", mpiperf_repfile);
         }
+        if (mpiperf_procdump) {
+            printf("# Per process dump file (MPI-IO): %s\n", mpiperf_procdumpfile);
+        }
+        if (mpiperf_rootreport) {
+            printf("# Per root report file: %s\n", mpiperf_rootrepfile);
+        }
+        if (mpiperf_histreport) {
+            printf("# Histogram file: %s\n", mpiperf_histfile);
+        }
+        if (mpiperf_matrixreport) {
+            printf("# Matrix file: %s\n", mpiperf_matrixfile);
+        }
         if (mpiperf_logfile) {
             printf("# Log file: %s\n", mpiperf_logfile);
             printf("# Log master only: %s\n", mpiperf_logmaster_only ? "on" : "off");
@@ -0,0 +1,87 @@
+/*
+ * accumulate.c: Benchmark functions for Accumulate.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "accumulate.h"
+#include "bench_rma.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "mempool.h"
+#include "util.h"
+
+static mempool_t *buf = NULL;
+static int bufsize;
+
+/* bench_accumulate_init: */
+int bench_accumulate_init(pt2pttest_params_t *params)
+{
+    bufsize = params->count * sizeof(char);
+    buf = mempool_create(params->count, mpiperf_isflushcache);
+    if (buf == NULL) {
+        return MPIPERF_FAILURE;
+    }
+    if (rmabench_win_create(params, params->count, 1) == MPIPERF_FAILURE) {
+        mempool_free(buf);
+        buf = NULL;
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_accumulate_free: */
+int bench_accumulate_free()
+{
+    rmabench_win_free();
+    mempool_free(buf);
+    buf = NULL;
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_accumulate_printinfo: */
+int bench_accumulate_printinfo(rmabench_t *bench)
+{
+    printf("* %s\n"
+           "  proto: MPI_Accumulate(buf, count, MPI_UNSIGNED_CHAR, 1, 0, count,\n"
+           "                        MPI_UNSIGNED_CHAR, MPI_SUM, win)\n"
+           "  sync: %s\n"
+           "  win: MPI_Win_allocate(count, 1, ...) on processes 0 and 1\n"
+           "  This benchmark measures time of origin process 0 (epoch and operation)\n",
+           bench->pt2pt.name, rmabench_syncname(bench->sync));
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_accumulate_sync: */
+int measure_accumulate_sync(pt2pttest_params_t *params, double *time)
+{
+    double starttime, endtime;
+    int rc;
+
+    starttime = timeslot_startsync();
+    rc = rmabench_epoch_begin();
+    if ((rc == MPI_SUCCESS) && rmabench_isorigin()) {
+        rc = MPI_Accumulate(mempool_alloc(buf, bufsize), params->count,
+                            MPI_UNSIGNED_CHAR, 1, 0, params->count,
+                            MPI_UNSIGNED_CHAR, MPI_SUM, rmabench_win());
+    }
+    if (rc == MPI_SUCCESS)
+        rc = rmabench_epoch_end();
+    endtime = timeslot_stopsync();
+    rmabench_epoch_release();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+    return MEASURE_FAILURE;
+}
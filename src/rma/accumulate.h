@@ -0,0 +1,19 @@
+/*
+ * accumulate.h: Benchmark functions for Accumulate.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef ACCUMULATE_H
+#define ACCUMULATE_H
+
+#include "bench_rma.h"
+
+int bench_accumulate_init(pt2pttest_params_t *params);
+int bench_accumulate_free();
+int bench_accumulate_printinfo(rmabench_t *bench);
+int measure_accumulate_sync(pt2pttest_params_t *params, double *time);
+
+#endif /* ACCUMULATE_H */
@@ -0,0 +1,91 @@
+/*
+ * fetch_and_op.c: Benchmark functions for Fetch_and_op.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+
+#include "fetch_and_op.h"
+#include "bench_rma.h"
+#include "mpiperf.h"
+#include "timeslot.h"
+#include "util.h"
+
+static long long *result = NULL;
+static long long operand = 1;
+
+/* bench_fetch_and_op_init: */
+int bench_fetch_and_op_init(pt2pttest_params_t *params)
+{
+    /* count is a number of atomic operations in one epoch */
+    params->nmsgs = params->count;
+    params->msgsize = sizeof(long long);
+
+    result = xmalloc(sizeof(*result) * params->count);
+    if (rmabench_win_create(params, sizeof(long long),
+                            sizeof(long long)) == MPIPERF_FAILURE)
+    {
+        free(result);
+        result = NULL;
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_fetch_and_op_free: */
+int bench_fetch_and_op_free()
+{
+    rmabench_win_free();
+    free(result);
+    result = NULL;
+    return MPIPERF_SUCCESS;
+}
+
+/* bench_fetch_and_op_printinfo: */
+int bench_fetch_and_op_printinfo(rmabench_t *bench)
+{
+    printf("* %s\n"
+           "  proto: MPI_Fetch_and_op(&operand, &result[i], MPI_LONG_LONG, 1, 0,\n"
+           "                          MPI_SUM, win), i = 0, 1, ..., count - 1\n"
+           "  sync: %s\n"
+           "  win: MPI_Win_allocate(sizeof(long long), sizeof(long long), ...)\n"
+           "  Count is a number of atomic operations in one epoch (Msg/s - atomic rate)\n",
+           bench->pt2pt.name, rmabench_syncname(bench->sync));
+    return MPIPERF_SUCCESS;
+}
+
+/* measure_fetch_and_op_sync: */
+int measure_fetch_and_op_sync(pt2pttest_params_t *params, double *time)
+{
+#ifdef HAVE_RMA
+    double starttime, endtime;
+    int i, rc;
+
+    starttime = timeslot_startsync();
+    rc = rmabench_epoch_begin();
+    if ((rc == MPI_SUCCESS) && rmabench_isorigin()) {
+        for (i = 0; i < params->count && rc == MPI_SUCCESS; i++) {
+            rc = MPI_Fetch_and_op(&operand, &result[i], MPI_LONG_LONG, 1, 0,
+                                  MPI_SUM, rmabench_win());
+        }
+    }
+    if (rc == MPI_SUCCESS)
+        rc = rmabench_epoch_end();
+    endtime = timeslot_stopsync();
+    rmabench_epoch_release();
+
+    if ((rc == MPI_SUCCESS) && (starttime > 0.0) && (endtime > 0.0)) {
+        *time = endtime - starttime;
+        return MEASURE_SUCCESS;
+    } else if (starttime < 0.0) {
+        return MEASURE_STARTED_LATE;
+    } else if (endtime < 0.0) {
+        return MEASURE_TIME_TOOLONG;
+    }
+#endif
+    return MEASURE_FAILURE;
+}
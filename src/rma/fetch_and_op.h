@@ -0,0 +1,19 @@
+/*
+ * fetch_and_op.h: Benchmark functions for Fetch_and_op.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef FETCH_AND_OP_H
+#define FETCH_AND_OP_H
+
+#include "bench_rma.h"
+
+int bench_fetch_and_op_init(pt2pttest_params_t *params);
+int bench_fetch_and_op_free();
+int bench_fetch_and_op_printinfo(rmabench_t *bench);
+int measure_fetch_and_op_sync(pt2pttest_params_t *params, double *time);
+
+#endif /* FETCH_AND_OP_H */
@@ -0,0 +1,19 @@
+/*
+ * get.h: Benchmark functions for Get.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef GET_H
+#define GET_H
+
+#include "bench_rma.h"
+
+int bench_get_init(pt2pttest_params_t *params);
+int bench_get_free();
+int bench_get_printinfo(rmabench_t *bench);
+int measure_get_sync(pt2pttest_params_t *params, double *time);
+
+#endif /* GET_H */
@@ -0,0 +1,19 @@
+/*
+ * put.h: Benchmark functions for Put.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef PUT_H
+#define PUT_H
+
+#include "bench_rma.h"
+
+int bench_put_init(pt2pttest_params_t *params);
+int bench_put_free();
+int bench_put_printinfo(rmabench_t *bench);
+int measure_put_sync(pt2pttest_params_t *params, double *time);
+
+#endif /* PUT_H */
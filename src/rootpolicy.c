@@ -0,0 +1,188 @@
+/*
+ * rootpolicy.c: Selection of root process for rooted collectives.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+
+#include "rootpolicy.h"
+#include "mpiperf.h"
+#include "stat.h"
+#include "util.h"
+
+static int rootpolicy_run;
+static uint64_t rootpolicy_randstate = RNG_SEED;
+
+static stat_sample_t **rootstat = NULL;
+static int rootstat_size = 0;
+
+/* rootpolicy_parse: Parses policy string: fixed[:root], roundrobin, random. */
+int rootpolicy_parse(const char *s, int *policy, int *root)
+{
+    const char *p;
+
+    if (strncasecmp(s, "fixed", 5) == 0) {
+        *policy = ROOTPOLICY_FIXED;
+        *root = 0;
+        if ( (p = strchr(s, ':')) != NULL) {
+            *root = atoi(p + 1);
+            if (*root < 0)
+                return MPIPERF_FAILURE;
+        }
+    } else if (strcasecmp(s, "roundrobin") == 0 || strcasecmp(s, "rr") == 0) {
+        *policy = ROOTPOLICY_ROUNDROBIN;
+    } else if (strcasecmp(s, "random") == 0) {
+        *policy = ROOTPOLICY_RANDOM;
+    } else {
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* rootpolicy_reset: Starts new sequence of roots. */
+int rootpolicy_reset(int nprocs)
+{
+    rootpolicy_run = 0;
+    rootpolicy_randstate = RNG_SEED;
+    if (mpiperf_rootpolicy == ROOTPOLICY_FIXED)
+        return mpiperf_root;
+    return 0;
+}
+
+/* rootpolicy_next: Returns root for the next run. */
+int rootpolicy_next(int nprocs)
+{
+    if (mpiperf_rootpolicy == ROOTPOLICY_ROUNDROBIN) {
+        return rootpolicy_run++ % nprocs;
+    } else if (mpiperf_rootpolicy == ROOTPOLICY_RANDOM) {
+        return rng_range(&rootpolicy_randstate, nprocs);
+    }
+    return mpiperf_root;
+}
+
+/* rootpolicy_isfixed: */
+int rootpolicy_isfixed()
+{
+    return mpiperf_rootpolicy == ROOTPOLICY_FIXED;
+}
+
+/* rootpolicy_name: */
+const char *rootpolicy_name()
+{
+    if (mpiperf_rootpolicy == ROOTPOLICY_ROUNDROBIN) {
+        return "round-robin";
+    } else if (mpiperf_rootpolicy == ROOTPOLICY_RANDOM) {
+        return "random";
+    }
+    return "fixed";
+}
+
+/* rootpolicy_stat_reset: Cleans per-root statistics for new test. */
+void rootpolicy_stat_reset(int nprocs)
+{
+    int i;
+
+    if (!mpiperf_rootreport || !IS_MASTER_RANK)
+        return;
+
+    if (nprocs > rootstat_size) {
+        rootstat = xrealloc(rootstat, sizeof(*rootstat) * nprocs);
+        for (i = rootstat_size; i < nprocs; i++) {
+            if ( (rootstat[i] = stat_sample_create()) == NULL)
+                exit_error("No enough memory");
+        }
+        rootstat_size = nprocs;
+    }
+    for (i = 0; i < rootstat_size; i++)
+        stat_sample_clean(rootstat[i]);
+}
+
+/* rootpolicy_stat_add: Adds time of correct run to statistics of root. */
+void rootpolicy_stat_add(int root, double time)
+{
+    if (!mpiperf_rootreport || !IS_MASTER_RANK)
+        return;
+    if (root >= 0 && root < rootstat_size)
+        stat_sample_add(rootstat[root], time);
+}
+
+/* rootpolicy_stat_free: */
+void rootpolicy_stat_free()
+{
+    int i;
+
+    for (i = 0; i < rootstat_size; i++)
+        stat_sample_free(rootstat[i]);
+    free(rootstat);
+    rootstat = NULL;
+    rootstat_size = 0;
+}
+
+int report_write_rootstat_header(const char *benchname)
+{
+    if (!mpiperf_rootreport || !IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    fprintf(mpiperf_rootrepstream, "# Characteristics of measurements:\n");
+    fprintf(mpiperf_rootrepstream, "#   Procs - total number of processes\n");
+    fprintf(mpiperf_rootrepstream, "#   Count - count of elements in send/recv buffer\n");
+    fprintf(mpiperf_rootrepstream, "#   Root - rank of root process\n");
+    fprintf(mpiperf_rootrepstream, "#   CRuns - number of correct measurements with this root\n");
+    fprintf(mpiperf_rootrepstream, "#   Mean - arithmetic mean of execution time\n");
+    fprintf(mpiperf_rootrepstream, "#   StdErr - standard error of the mean: StdDev / sqrt(CRuns)\n");
+    fprintf(mpiperf_rootrepstream, "#   Min - minimal value\n");
+    fprintf(mpiperf_rootrepstream, "#   Max - maximal value\n");
+    fprintf(mpiperf_rootrepstream, "#\n");
+    fprintf(mpiperf_rootrepstream, "# Time of run j is max_of_all_procs(t[0][j], ..., t[Procs - 1][j])\n");
+    fprintf(mpiperf_rootrepstream, "#\n");
+    fprintf(mpiperf_rootrepstream, "# ------------------------------------------------------------------\n");
+    fprintf(mpiperf_rootrepstream, "# Benchmark: %s\n", benchname);
+    fprintf(mpiperf_rootrepstream, "# Root policy: %s\n", rootpolicy_name());
+    fprintf(mpiperf_rootrepstream, "# ------------------------------------------------------------------\n");
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fprintf(mpiperf_rootrepstream, "# [Procs] [Count]     [Root]  [CRuns] [Mean]       [StdErr]     [Min]        [Max]\n");
+    } else {
+        /* usec */
+        fprintf(mpiperf_rootrepstream, "# [Procs] [Count]     [Root]  [CRuns] [Mean]         [StdErr]       [Min]          [Max]\n");
+    }
+    fprintf(mpiperf_rootrepstream, "#\n");
+    return MPIPERF_SUCCESS;
+}
+
+int report_write_rootstat(int nprocs, int count)
+{
+    const char *fmt = NULL;
+    double timescale;
+    int i;
+
+    if (!mpiperf_rootreport || !IS_MASTER_RANK)
+        return MPIPERF_SUCCESS;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "  %-7d %-11d %-7d %-7d %-12.6f %-12.6f %-12.6f %-12.6f\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "  %-7d %-11d %-7d %-7d %-14.2f %-14.2f %-14.2f %-14.2f\n";
+        timescale = 1E6;
+    }
+
+    for (i = 0; i < nprocs && i < rootstat_size; i++) {
+        if (stat_sample_size(rootstat[i]) == 0) {
+            /* Root was not used (or all its runs are invalid) */
+            continue;
+        }
+        fprintf(mpiperf_rootrepstream, fmt, nprocs, count, i,
+                stat_sample_size(rootstat[i]),
+                stat_sample_mean(rootstat[i]) * timescale,
+                stat_sample_stderr(rootstat[i]) * timescale,
+                stat_sample_min(rootstat[i]) * timescale,
+                stat_sample_max(rootstat[i]) * timescale);
+    }
+    return MPIPERF_SUCCESS;
+}
@@ -0,0 +1,47 @@
+/*
+ * rootpolicy.h: Selection of root process for rooted collectives.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef ROOTPOLICY_H
+#define ROOTPOLICY_H
+
+enum RootPolicyType {
+    ROOTPOLICY_FIXED = 0,       /* Root is constant (-y fixed:<root>) */
+    ROOTPOLICY_ROUNDROBIN = 1,  /* Root is changed on each run: 0, 1, 2, ... */
+    ROOTPOLICY_RANDOM = 2       /* Root is chosen randomly on each run */
+};
+
+/* rootpolicy_parse: Parses policy string: fixed[:root], roundrobin, random. */
+int rootpolicy_parse(const char *s, int *policy, int *root);
+
+/*
+ * rootpolicy_reset: Starts new sequence of roots for communicator of
+ *                   nprocs processes. Returns root of the first run.
+ */
+int rootpolicy_reset(int nprocs);
+
+/*
+ * rootpolicy_next: Returns root for the next run. The sequence is
+ *                  the same in all processes.
+ */
+int rootpolicy_next(int nprocs);
+
+/* rootpolicy_isfixed: Returns 1 if root is the same in all runs. */
+int rootpolicy_isfixed();
+
+const char *rootpolicy_name();
+
+/*
+ * Per-root statistics (-Y): execution time of each correct run is
+ * accounted to the root of that run.
+ */
+void rootpolicy_stat_reset(int nprocs);
+void rootpolicy_stat_add(int root, double time);
+void rootpolicy_stat_free();
+
+int report_write_rootstat_header(const char *benchname);
+int report_write_rootstat(int nprocs, int count);
+
+#endif /* ROOTPOLICY_H */
@@ -4,12 +4,37 @@
  * Copyright (C) 2010-2011 Mikhail Kurnosov
  */
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <strings.h>
 #include <math.h>
 #include <float.h>
 
 #include "stat.h"
 
+enum {
+    P2_NMARKERS = 5
+};
+
+/*
+ * P^2 estimator of quantile: five markers, heights of markers are
+ * estimates of min, p/2, p, (1 + p)/2 quantiles and max [Jain R.,
+ * Chlamtac I. The P^2 algorithm for dynamic calculation of quantiles
+ * and histograms without storing observations // CACM, 1985].
+ */
+typedef struct {
+    double q[P2_NMARKERS];      /* Heights of markers */
+    double n[P2_NMARKERS];      /* Positions of markers: 1, 2, ..., size */
+    double np[P2_NMARKERS];     /* Desired positions of markers */
+    double dn[P2_NMARKERS];     /* Increments of desired positions */
+} p2_estimator_t;
+
+/* Probabilities of quantiles in order of StatQuantiles */
+static const double stat_quantile_probs[STAT_NQUANTILES] = {
+    0.5, 0.9, 0.99, 0.999
+};
+
 /* Statistical sample */
 struct stat_sample {
     double sum;         /* Sum of sample elements: x_0 + x_1 + ... + x_n */
@@ -19,64 +44,42 @@ struct stat_sample {
     int min_index;      /* Elements are numbered from 0: 0, 1, 2, ... */
     int max_index;
     int size;           /* Number of elements in sample */
-};
 
-/*
- * Student's t-distribution (two tails probability)
- */
-static int tstud_sample_size = 100;
-static double tstud_p90_ninf = 1.645;
-static double tstud_tab_p90[] = {
-    6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895,
-    1.860, 1.833, 1.812, 1.796, 1.782, 1.771, 1.761, 1.753,
-    1.746, 1.740, 1.734, 1.729, 1.725, 1.721, 1.717, 1.714,
-    1.711, 1.708, 1.706, 1.703, 1.701, 1.699, 1.697, 1.696,
-    1.694, 1.692, 1.691, 1.690, 1.688, 1.687, 1.686, 1.685,
-    1.684, 1.683, 1.682, 1.681, 1.680, 1.679, 1.679, 1.678,
-    1.677, 1.677, 1.676, 1.675, 1.675, 1.674, 1.674, 1.673,
-    1.673, 1.672, 1.672, 1.671, 1.671, 1.670, 1.670, 1.669,
-    1.669, 1.669, 1.668, 1.668, 1.668, 1.667, 1.667, 1.667,
-    1.666, 1.666, 1.666, 1.665, 1.665, 1.665, 1.665, 1.664,
-    1.664, 1.664, 1.664, 1.663, 1.663, 1.663, 1.663, 1.663,
-    1.662, 1.662, 1.662, 1.662, 1.662, 1.661, 1.661, 1.661,
-    1.661, 1.661, 1.661, 1.660
+    /* Streaming estimators of quantiles (memory is bounded) */
+    double first[P2_NMARKERS];  /* First elements (markers initialization) */
+    p2_estimator_t quantiles[STAT_NQUANTILES];
 };
 
-static double tstud_p95_ninf = 1.960;
-static double tstud_tab_p95[] = {
-    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365,
-    2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
-    2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069,
-    2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042, 2.040,
-    2.037, 2.035, 2.032, 2.030, 2.028, 2.026, 2.024, 2.023,
-    2.021, 2.020, 2.018, 2.017, 2.015, 2.014, 2.013, 2.012,
-    2.011, 2.010, 2.009, 2.008, 2.007, 2.006, 2.005, 2.004,
-    2.003, 2.002, 2.002, 2.001, 2.000, 2.000, 1.999, 1.998,
-    1.998, 1.997, 1.997, 1.996, 1.995, 1.995, 1.994, 1.994,
-    1.993, 1.993, 1.993, 1.992, 1.992, 1.991, 1.991, 1.990,
-    1.990, 1.990, 1.989, 1.989, 1.989, 1.988, 1.988, 1.988,
-    1.987, 1.987, 1.987, 1.986, 1.986, 1.986, 1.986, 1.985,
-    1.985, 1.985, 1.984, 1.984
+enum {
+    STATIONARITY_SIZE_MIN = 8,      /* Shorter sequences are not tested */
+    AUTOCORR_NLAGS_MAX = 16,
+    TSTUD_NITERS_MAX = 200,     /* Limit of bisection steps */
+    BETACF_NITERS_MAX = 300     /* Limit of continued fraction terms */
 };
 
-static double tstud_p99_ninf = 2.576;
-static double tstud_tab_p99[] = {
-    63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499,
-    3.355, 3.250, 3.169, 3.106, 3.055, 3.012, 2.977, 2.947,
-    2.921, 2.898, 2.878, 2.861, 2.845, 2.831, 2.819, 2.807,
-    2.797, 2.787, 2.779, 2.771, 2.763, 2.756, 2.750, 2.744,
-    2.738, 2.733, 2.728, 2.724, 2.719, 2.715, 2.712, 2.708,
-    2.704, 2.701, 2.698, 2.695, 2.692, 2.690, 2.687, 2.685,
-    2.682, 2.680, 2.678, 2.676, 2.674, 2.672, 2.670, 2.668,
-    2.667, 2.665, 2.663, 2.662, 2.660, 2.659, 2.657, 2.656,
-    2.655, 2.654, 2.652, 2.651, 2.650, 2.649, 2.648, 2.647,
-    2.646, 2.645, 2.644, 2.643, 2.642, 2.641, 2.640, 2.640,
-    2.639, 2.638, 2.637, 2.636, 2.636, 2.635, 2.634, 2.634,
-    2.633, 2.632, 2.632, 2.631, 2.630, 2.630, 2.629, 2.629,
-    2.628, 2.627, 2.627, 2.626
-};
+#define OUTLIERS_TRIM_DEFAULT 25.0
+#define OUTLIERS_MAD_K_DEFAULT 3.0
+#define OUTLIERS_IQR_K_DEFAULT 1.5
+#define OUTLIERS_MINK_K_DEFAULT 4
+#define MAD_NORMAL_SCALE 1.4826     /* MAD * 1.4826 estimates StdDev of normal */
+
+#define CUSUM_CRIT 1.358             /* 5% point of sup of Brownian bridge */
+#define AUTOCORR_SIGNIFICANCE 0.05
+
+#define TSTUD_EPS 1E-12
+#define BETACF_EPS 1E-15
+#define BETACF_FPMIN 1E-300
 
 static int fcmp(const void *p, const void *q);
+static void p2_initialize(p2_estimator_t *e, double p, double *first);
+static void p2_add(p2_estimator_t *e, double val);
+static double stat_select(double *data, int size, int k);
+static double stat_dataset_quantile(double *data, int size, double p);
+static int stat_dataset_remove_mad(double *data, int size, double k);
+static int stat_dataset_remove_iqr(double *data, int size, double k);
+static int stat_dataset_min_of_k(double *data, int size, int k);
+static double stat_betai(double a, double b, double x);
+static double stat_betacf(double a, double b, double x);
 
 /* stat_sample_create: */
 stat_sample_t *stat_sample_create()
@@ -100,6 +103,8 @@ void stat_sample_free(stat_sample_t *sample)
 /* stat_sample_add: */
 void stat_sample_add(stat_sample_t *sample, double val)
 {
+    int i;
+
     sample->sum += val;
     sample->sum_pow2 += val * val;
 
@@ -111,6 +116,19 @@ void stat_sample_add(stat_sample_t *sample, double val)
         sample->max = val;
         sample->max_index = sample->size;
     }
+
+    if (sample->size < P2_NMARKERS) {
+        sample->first[sample->size] = val;
+        if (sample->size == P2_NMARKERS - 1) {
+            for (i = 0; i < STAT_NQUANTILES; i++) {
+                p2_initialize(&sample->quantiles[i], stat_quantile_probs[i],
+                              sample->first);
+            }
+        }
+    } else {
+        for (i = 0; i < STAT_NQUANTILES; i++)
+            p2_add(&sample->quantiles[i], val);
+    }
     sample->size++;
 }
 
@@ -208,6 +226,81 @@ int stat_sample_size(stat_sample_t *sample)
     return sample->size;
 }
 
+/*
+ * stat_sample_quantile: Returns estimate of quantile (StatQuantiles).
+ *                       Quantiles of samples with less than 5 elements
+ *                       are exact (linear interpolation).
+ */
+double stat_sample_quantile(stat_sample_t *sample, int quantile)
+{
+    double data[P2_NMARKERS], pos, val;
+    int i;
+
+    if (quantile < 0 || quantile >= STAT_NQUANTILES || sample->size == 0)
+        return 0.0;
+
+    if (sample->size >= P2_NMARKERS) {
+        /* Estimators are independent: keep quantiles nondecreasing */
+        val = sample->quantiles[quantile].q[2];
+        if (quantile > 0)
+            val = stat_fmax2(val, stat_sample_quantile(sample, quantile - 1));
+        return stat_fmin2(val, sample->max);
+    }
+
+    for (i = 0; i < sample->size; i++)
+        data[i] = sample->first[i];
+    qsort(data, sample->size, sizeof(*data), fcmp);
+    pos = stat_quantile_probs[quantile] * (sample->size - 1);
+    i = (int)pos;
+    if (i + 1 < sample->size)
+        return data[i] + (pos - i) * (data[i + 1] - data[i]);
+    return data[i];
+}
+
+/* stat_quantile_prob: Returns probability of quantile (StatQuantiles). */
+double stat_quantile_prob(int quantile)
+{
+    if (quantile < 0 || quantile >= STAT_NQUANTILES)
+        return 0.0;
+    return stat_quantile_probs[quantile];
+}
+
+/* stat_quantile_rank: */
+int stat_quantile_rank(int size, double p)
+{
+    int k;
+
+    k = (int)ceil(p * size) - 1;
+    if (k < 0)
+        k = 0;
+    if (k > size - 1)
+        k = size - 1;
+    return k;
+}
+
+/* stat_dataset_quantiles: */
+void stat_dataset_quantiles(const double *data, int size, double *quantiles)
+{
+    double *sorted;
+    int i;
+
+    if (size < 1) {
+        for (i = 0; i < STAT_NQUANTILES; i++)
+            quantiles[i] = 0.0;
+        return;
+    }
+    if ( (sorted = malloc(sizeof(*sorted) * size)) == NULL) {
+        for (i = 0; i < STAT_NQUANTILES; i++)
+            quantiles[i] = 0.0;
+        return;
+    }
+    memcpy(sorted, data, sizeof(*sorted) * size);
+    qsort(sorted, size, sizeof(*sorted), fcmp);
+    for (i = 0; i < STAT_NQUANTILES; i++)
+        quantiles[i] = sorted[stat_quantile_rank(size, stat_quantile_probs[i])];
+    free(sorted);
+}
+
 /* stat_mean: Returns sample mean of the dataset. */
 double stat_mean(double *data, int size)
 {
@@ -342,39 +435,446 @@ static int fcmp(const void *a, const void *b)
     return 0;
 }
 
+/* p2_initialize: Initializes markers by first 5 elements of sample. */
+static void p2_initialize(p2_estimator_t *e, double p, double *first)
+{
+    int i;
+
+    for (i = 0; i < P2_NMARKERS; i++) {
+        e->q[i] = first[i];
+        e->n[i] = i + 1;
+    }
+    qsort(e->q, P2_NMARKERS, sizeof(*e->q), fcmp);
+
+    e->np[0] = 1.0;
+    e->np[1] = 1.0 + 2.0 * p;
+    e->np[2] = 1.0 + 4.0 * p;
+    e->np[3] = 3.0 + 2.0 * p;
+    e->np[4] = 5.0;
+
+    e->dn[0] = 0.0;
+    e->dn[1] = p / 2.0;
+    e->dn[2] = p;
+    e->dn[3] = (1.0 + p) / 2.0;
+    e->dn[4] = 1.0;
+}
+
+/* p2_add: Adjusts heights and positions of markers by new element. */
+static void p2_add(p2_estimator_t *e, double val)
+{
+    double d, qp;
+    int i, k;
+
+    /* Find cell k: q[k] <= val < q[k + 1] */
+    if (val < e->q[0]) {
+        e->q[0] = val;
+        k = 0;
+    } else if (val >= e->q[4]) {
+        e->q[4] = val;
+        k = 3;
+    } else {
+        for (k = 0; k < 3 && val >= e->q[k + 1]; k++);
+    }
+
+    for (i = k + 1; i < P2_NMARKERS; i++)
+        e->n[i] += 1.0;
+    for (i = 0; i < P2_NMARKERS; i++)
+        e->np[i] += e->dn[i];
+
+    /* Adjust heights of middle markers */
+    for (i = 1; i < P2_NMARKERS - 1; i++) {
+        d = e->np[i] - e->n[i];
+        if ((d >= 1.0 && e->n[i + 1] - e->n[i] > 1.0) ||
+            (d <= -1.0 && e->n[i - 1] - e->n[i] < -1.0))
+        {
+            d = (d > 0.0) ? 1.0 : -1.0;
+
+            /* Piecewise-parabolic prediction */
+            qp = e->q[i] + d / (e->n[i + 1] - e->n[i - 1]) *
+                 ((e->n[i] - e->n[i - 1] + d) * (e->q[i + 1] - e->q[i]) /
+                  (e->n[i + 1] - e->n[i]) +
+                  (e->n[i + 1] - e->n[i] - d) * (e->q[i] - e->q[i - 1]) /
+                  (e->n[i] - e->n[i - 1]));
+
+            if (e->q[i - 1] < qp && qp < e->q[i + 1]) {
+                e->q[i] = qp;
+            } else {
+                /* Linear prediction */
+                k = i + (int)d;
+                e->q[i] += d * (e->q[k] - e->q[i]) / (e->n[k] - e->n[i]);
+            }
+            e->n[i] += d;
+        }
+    }
+}
+
 /*
  * stat_dataset_remove_outliers: Removes lb percents of minimal values from
  *                               dataset and ub percents of maximal values.
+ *                               Values are selected in O(n) without sorting,
+ *                               order of remaining values is arbitrary.
  *                               Returns size of modified dataset
  *                               and -1 on error.
  */
-int stat_dataset_remove_outliers(double *data, int size, int lb, int ub)
+int stat_dataset_remove_outliers(double *data, int size, double lb, double ub)
 {
     int i, nmin, nmax, newsize;
 
-    if (!data || (lb + ub > 100)) {
+    if (!data || lb < 0.0 || ub < 0.0 || (lb + ub > 100.0)) {
         return -1;
     }
-    if (size == 0 || (lb + ub == 100)) {
+    if (size == 0 || (lb + ub == 100.0)) {
         return 0;
     }
 
-    qsort(data, size, sizeof(*data), fcmp);
-
     nmin = size / 100.0 * lb;
     nmax = size / 100.0 * ub;
     newsize = size - nmin - nmax;
+    if (nmin > 0)
+        stat_select(data, size, nmin);
+    if (nmax > 0)
+        stat_select(data + nmin, size - nmin, newsize);
     for (i = 0; i < newsize; i++) {
         data[i] = data[i + nmin];
     }
     return newsize;
 }
 
+/*
+ * stat_dataset_filter_outliers: Removes outliers from dataset by filter.
+ *                               Returns size of modified dataset
+ *                               and -1 on error.
+ */
+int stat_dataset_filter_outliers(double *data, int size,
+                                 const stat_outliers_t *filter)
+{
+    if (!data || !filter)
+        return -1;
+
+    switch (filter->method) {
+    case STAT_OUTLIERS_NONE:
+        return size;
+    case STAT_OUTLIERS_TRIM:
+        return stat_dataset_remove_outliers(data, size, filter->lb, filter->ub);
+    case STAT_OUTLIERS_MAD:
+        return stat_dataset_remove_mad(data, size, filter->k);
+    case STAT_OUTLIERS_IQR:
+        return stat_dataset_remove_iqr(data, size, filter->k);
+    case STAT_OUTLIERS_MINK:
+        return stat_dataset_min_of_k(data, size, (int)filter->k);
+    }
+    return -1;
+}
+
+/*
+ * stat_outliers_parse: Parses filter string: none, trim[:<lb>[:<ub>]],
+ *                      mad[:<k>], iqr[:<k>], mink[:<k>].
+ *                      Returns 0 on success and -1 on error.
+ */
+int stat_outliers_parse(const char *s, stat_outliers_t *filter)
+{
+    const char *p;
+    char *end;
+
+    filter->lb = filter->ub = 0.0;
+    filter->k = 0.0;
+    p = strchr(s, ':');
+    if (strcasecmp(s, "none") == 0) {
+        filter->method = STAT_OUTLIERS_NONE;
+        return 0;
+    } else if (strncasecmp(s, "trim", 4) == 0 && (s[4] == '\0' || s[4] == ':')) {
+        filter->method = STAT_OUTLIERS_TRIM;
+        filter->lb = filter->ub = OUTLIERS_TRIM_DEFAULT;
+        if (p) {
+            filter->lb = filter->ub = strtod(p + 1, &end);
+            if (*end == ':')
+                filter->ub = strtod(end + 1, &end);
+            if (*end != '\0' || filter->lb < 0.0 || filter->ub < 0.0 ||
+                filter->lb + filter->ub >= 100.0)
+            {
+                return -1;
+            }
+        }
+        return 0;
+    } else if (strncasecmp(s, "mad", 3) == 0 && (s[3] == '\0' || s[3] == ':')) {
+        filter->method = STAT_OUTLIERS_MAD;
+        filter->k = OUTLIERS_MAD_K_DEFAULT;
+    } else if (strncasecmp(s, "iqr", 3) == 0 && (s[3] == '\0' || s[3] == ':')) {
+        filter->method = STAT_OUTLIERS_IQR;
+        filter->k = OUTLIERS_IQR_K_DEFAULT;
+    } else if (strncasecmp(s, "mink", 4) == 0 && (s[4] == '\0' || s[4] == ':')) {
+        filter->method = STAT_OUTLIERS_MINK;
+        filter->k = OUTLIERS_MINK_K_DEFAULT;
+    } else {
+        return -1;
+    }
+    if (p) {
+        filter->k = strtod(p + 1, &end);
+        if (*end != '\0' || filter->k <= 0.0)
+            return -1;
+        if (filter->method == STAT_OUTLIERS_MINK && filter->k != (int)filter->k)
+            return -1;
+    }
+    return 0;
+}
+
+/* stat_outliers_name: Writes description of filter to buf. */
+const char *stat_outliers_name(const stat_outliers_t *filter, char *buf,
+                               int size)
+{
+    switch (filter->method) {
+    case STAT_OUTLIERS_TRIM:
+        snprintf(buf, size, "trimming of %g%% minimal and %g%% maximal values",
+                 filter->lb, filter->ub);
+        break;
+    case STAT_OUTLIERS_MAD:
+        snprintf(buf, size, "MAD, |t - Median| > %g * 1.4826 * MAD", filter->k);
+        break;
+    case STAT_OUTLIERS_IQR:
+        snprintf(buf, size, "Tukey fences, t out of [Q1 - %g * IQR, Q3 + %g * IQR]",
+                 filter->k, filter->k);
+        break;
+    case STAT_OUTLIERS_MINK:
+        snprintf(buf, size, "min-of-%d (minimum of each %d consecutive runs)",
+                 (int)filter->k, (int)filter->k);
+        break;
+    default:
+        snprintf(buf, size, "none");
+    }
+    return buf;
+}
+
+/*
+ * stat_select: Rearranges data so that data[k] is the k-th smallest value,
+ *              values before it are not greater and after it are not less
+ *              (Hoare's selection, expected O(n)). Returns data[k].
+ */
+static double stat_select(double *data, int size, int k)
+{
+    int lo, hi, i, j;
+    double pivot, tmp;
+
+    lo = 0;
+    hi = size - 1;
+    while (lo < hi) {
+        pivot = data[lo + (hi - lo) / 2];
+        i = lo;
+        j = hi;
+        while (i <= j) {
+            while (data[i] < pivot)
+                i++;
+            while (data[j] > pivot)
+                j--;
+            if (i <= j) {
+                tmp = data[i];
+                data[i] = data[j];
+                data[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return data[k];
+}
+
+/*
+ * stat_dataset_quantile: Returns p-quantile of dataset with linear
+ *                        interpolation. Order of dataset is changed.
+ */
+static double stat_dataset_quantile(double *data, int size, double p)
+{
+    double pos, lo, hi;
+    int i;
+
+    pos = p * (size - 1);
+    i = (int)pos;
+    lo = stat_select(data, size, i);
+    if (i + 1 >= size)
+        return lo;
+    hi = stat_min(data + i + 1, size - i - 1);
+    return lo + (pos - i) * (hi - lo);
+}
+
+/*
+ * stat_dataset_remove_mad: Removes values which deviate from median by more
+ *                          than k scaled median absolute deviations.
+ *                          Dataset is not changed if MAD is zero.
+ */
+static int stat_dataset_remove_mad(double *data, int size, double k)
+{
+    double *dev, median, mad, bound;
+    int i, newsize;
+
+    if (size < 3)
+        return size;
+    if ( (dev = malloc(sizeof(*dev) * size)) == NULL)
+        return -1;
+
+    median = stat_dataset_quantile(data, size, 0.5);
+    for (i = 0; i < size; i++)
+        dev[i] = fabs(data[i] - median);
+    mad = stat_dataset_quantile(dev, size, 0.5);
+    free(dev);
+    if (mad <= 0.0)
+        return size;
+
+    bound = k * MAD_NORMAL_SCALE * mad;
+    newsize = 0;
+    for (i = 0; i < size; i++) {
+        if (fabs(data[i] - median) <= bound)
+            data[newsize++] = data[i];
+    }
+    return newsize;
+}
+
+/*
+ * stat_dataset_remove_iqr: Removes values out of Tukey's fences
+ *                          [Q1 - k * IQR, Q3 + k * IQR].
+ */
+static int stat_dataset_remove_iqr(double *data, int size, double k)
+{
+    double q1, q3, lb, ub;
+    int i, newsize;
+
+    if (size < 4)
+        return size;
+
+    q1 = stat_dataset_quantile(data, size, 0.25);
+    q3 = stat_dataset_quantile(data, size, 0.75);
+    lb = q1 - k * (q3 - q1);
+    ub = q3 + k * (q3 - q1);
+    newsize = 0;
+    for (i = 0; i < size; i++) {
+        if (data[i] >= lb && data[i] <= ub)
+            data[newsize++] = data[i];
+    }
+    return newsize;
+}
+
+/*
+ * stat_dataset_min_of_k: Replaces each k consecutive values (the last group
+ *                        may be shorter) by their minimum.
+ */
+static int stat_dataset_min_of_k(double *data, int size, int k)
+{
+    int i, newsize;
+
+    if (k < 1)
+        return -1;
+    newsize = 0;
+    for (i = 0; i < size; i += k)
+        data[newsize++] = stat_min(data + i, (size - i < k) ? size - i : k);
+    return newsize;
+}
+
+/*
+ * stat_dataset_transient_length: Returns length of initial transient
+ *                                (warmup) of sequence by MSER rule: truncation
+ *                                point d <= size / 2 minimizes
+ *                                sum_{i >= d} (x_i - mean_d)^2 / (size - d)^2
+ *                                [White K.P. An effective truncation heuristic
+ *                                for bias reduction in simulation output //
+ *                                Simulation, 1997].
+ */
+int stat_dataset_transient_length(const double *data, int size)
+{
+    double sum, sum_pow2, m, v, vmin;
+    int i, d;
+
+    if (!data || size < STATIONARITY_SIZE_MIN)
+        return 0;
+
+    /* Suffix sums: from the end of sequence to truncation point */
+    sum = sum_pow2 = 0.0;
+    for (i = size - 1; i > size / 2; i--) {
+        sum += data[i];
+        sum_pow2 += data[i] * data[i];
+    }
+    d = 0;
+    vmin = DBL_MAX;
+    for (i = size / 2; i >= 0; i--) {
+        sum += data[i];
+        sum_pow2 += data[i] * data[i];
+        m = size - i;
+        v = (sum_pow2 - sum * sum / m) / (m * m);
+        if (v <= vmin) {
+            vmin = v;
+            d = i;
+        }
+    }
+    return d;
+}
+
+/*
+ * stat_dataset_stationarity: Tests sequence for drift of mean by CUSUM
+ *                            of residuals (sup |S_k| / (StdDev * sqrt(n))
+ *                            against Brownian bridge) and for periodic noise
+ *                            by autocorrelations of lags 1, 2, ...
+ *                            (Bonferroni correction over lags).
+ */
+int stat_dataset_stationarity(const double *data, int size)
+{
+    double mean, var, s, smax, r, crit;
+    int i, lag, nlags;
+
+    if (!data || size < STATIONARITY_SIZE_MIN)
+        return STAT_STATIONARY;
+
+    mean = stat_mean((double *)data, size);
+    var = 0.0;
+    for (i = 0; i < size; i++)
+        var += (data[i] - mean) * (data[i] - mean);
+    if (var <= 0.0)
+        return STAT_STATIONARY;
+
+    s = smax = 0.0;
+    for (i = 0; i < size; i++) {
+        s += data[i] - mean;
+        smax = stat_fmax2(smax, fabs(s));
+    }
+    if (smax / sqrt(var) > CUSUM_CRIT)
+        return STAT_DRIFT;
+
+    nlags = size / 4;
+    if (nlags > AUTOCORR_NLAGS_MAX)
+        nlags = AUTOCORR_NLAGS_MAX;
+    crit = stat_tstud_quantile(1.0 - AUTOCORR_SIGNIFICANCE / nlags, size) /
+           sqrt(size);
+    for (lag = 1; lag <= nlags; lag++) {
+        r = 0.0;
+        for (i = lag; i < size; i++)
+            r += (data[i] - mean) * (data[i - lag] - mean);
+        if (fabs(r / var) > crit)
+            return STAT_PERIODIC;
+    }
+    return STAT_STATIONARY;
+}
+
+/* stat_stationarity_name: */
+const char *stat_stationarity_name(int stationarity)
+{
+    switch (stationarity) {
+    case STAT_DRIFT:
+        return "drift";
+    case STAT_PERIODIC:
+        return "period";
+    }
+    return "ok";
+}
+
 /*
  *  stat_sample_confidence_interval: Returns confidence interval for the given
- *                                   sample and given confidence level.
+ *                                   sample and given confidence level
+ *                                   (in percents).
  */
-int stat_sample_confidence_interval(stat_sample_t *sample, int level,
+int stat_sample_confidence_interval(stat_sample_t *sample, double level,
                                     double *lb, double *ub, double *err)
 {
     double mean, t;
@@ -385,26 +885,123 @@ int stat_sample_confidence_interval(stat_sample_t *sample, int level,
     if (sample->size == 0)
         return -1;
 
+    if (level <= 0.0 || level >= 100.0)
+        return -1;
+
+    mean = stat_sample_mean(sample);
     if (sample->size == 1) {
         *err = 0.0;
-        *lb = *ub = stat_sample_mean(sample);
-    }
-
-    if (level == STAT_CONFIDENCE_LEVEL_90) {
-        t = (sample->size <= tstud_sample_size) ? tstud_tab_p90[sample->size - 2]
-                                                : tstud_p90_ninf;
-    } else if (level == STAT_CONFIDENCE_LEVEL_95) {
-        t = (sample->size <= tstud_sample_size) ? tstud_tab_p95[sample->size - 2]
-                                                : tstud_p95_ninf;
-    } else if (level == STAT_CONFIDENCE_LEVEL_99) {
-        t = (sample->size <= tstud_sample_size) ? tstud_tab_p99[sample->size - 2]
-                                                : tstud_p99_ninf;
-    } else {
-        return -1;
+        *lb = *ub = mean;
+        return 0;
     }
+
+    t = stat_tstud_quantile(level / 100.0, sample->size - 1);
     *err = stat_sample_stderr(sample) * t;
-    mean = stat_sample_mean(sample);
     *lb = mean - *err;
     *ub = mean + *err;
     return 0;
 }
+
+/*
+ * stat_tstud_quantile: Returns t such that P(|T| <= t) = p for Student's
+ *                      t-distribution with df degrees of freedom.
+ *                      Two tails probability P(|T| > t) = I_x(df/2, 1/2),
+ *                      x = df / (df + t^2), is monotone in t, so t is found
+ *                      by bisection.
+ */
+double stat_tstud_quantile(double p, int df)
+{
+    double alpha, lo, hi, mid;
+    int i;
+
+    if (df < 1 || p <= 0.0 || p >= 1.0)
+        return 0.0;
+
+    alpha = 1.0 - p;
+    lo = 0.0;
+    hi = 1.0;
+    while (stat_betai(0.5 * df, 0.5, df / (df + hi * hi)) > alpha && hi < 1E300)
+        hi *= 2.0;
+
+    for (i = 0; i < TSTUD_NITERS_MAX && hi - lo > TSTUD_EPS * hi; i++) {
+        mid = 0.5 * (lo + hi);
+        if (stat_betai(0.5 * df, 0.5, df / (df + mid * mid)) > alpha)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+/* stat_tstud_pvalue: */
+double stat_tstud_pvalue(double t, double df)
+{
+    if (df <= 0.0)
+        return 1.0;
+    return stat_betai(0.5 * df, 0.5, df / (df + t * t));
+}
+
+/* stat_betai: Returns regularized incomplete beta function I_x(a, b). */
+static double stat_betai(double a, double b, double x)
+{
+    double bt;
+
+    if (x <= 0.0)
+        return 0.0;
+    if (x >= 1.0)
+        return 1.0;
+
+    bt = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) +
+             b * log(1.0 - x));
+
+    /* Continued fraction converges rapidly for x < (a + 1) / (a + b + 2) */
+    if (x < (a + 1.0) / (a + b + 2.0))
+        return bt * stat_betacf(a, b, x) / a;
+    return 1.0 - bt * stat_betacf(b, a, 1.0 - x) / b;
+}
+
+/*
+ * stat_betacf: Evaluates continued fraction for incomplete beta function
+ *              by modified Lentz's method.
+ */
+static double stat_betacf(double a, double b, double x)
+{
+    double aa, c, d, del, h, qab, qam, qap;
+    int m, m2;
+
+    qab = a + b;
+    qap = a + 1.0;
+    qam = a - 1.0;
+    c = 1.0;
+    d = 1.0 - qab * x / qap;
+    if (fabs(d) < BETACF_FPMIN)
+        d = BETACF_FPMIN;
+    d = 1.0 / d;
+    h = d;
+    for (m = 1; m <= BETACF_NITERS_MAX; m++) {
+        m2 = 2 * m;
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+        d = 1.0 + aa * d;
+        if (fabs(d) < BETACF_FPMIN)
+            d = BETACF_FPMIN;
+        c = 1.0 + aa / c;
+        if (fabs(c) < BETACF_FPMIN)
+            c = BETACF_FPMIN;
+        d = 1.0 / d;
+        h *= d * c;
+
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+        d = 1.0 + aa * d;
+        if (fabs(d) < BETACF_FPMIN)
+            d = BETACF_FPMIN;
+        c = 1.0 + aa / c;
+        if (fabs(c) < BETACF_FPMIN)
+            c = BETACF_FPMIN;
+        d = 1.0 / d;
+        del = d * c;
+        h *= del;
+        if (fabs(del - 1.0) < BETACF_EPS)
+            break;
+    }
+    return h;
+}
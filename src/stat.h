@@ -7,10 +7,36 @@
 #ifndef STAT_H
 #define STAT_H
 
-enum StatConfidenceLevels {
-    STAT_CONFIDENCE_LEVEL_90 = 0,
-    STAT_CONFIDENCE_LEVEL_95 = 1,
-    STAT_CONFIDENCE_LEVEL_99 = 2
+/* Quantiles estimated by stat_sample */
+enum StatQuantiles {
+    STAT_QUANTILE_MEDIAN = 0,
+    STAT_QUANTILE_P90 = 1,
+    STAT_QUANTILE_P99 = 2,
+    STAT_QUANTILE_P999 = 3,
+    STAT_NQUANTILES = 4
+};
+
+/* Methods of outliers filtering */
+enum StatOutliersMethod {
+    STAT_OUTLIERS_NONE = 0,
+    STAT_OUTLIERS_TRIM = 1,     /* Trimming of lb% minimal and ub% maximal */
+    STAT_OUTLIERS_MAD = 2,      /* |x - Median| > k * 1.4826 * MAD */
+    STAT_OUTLIERS_IQR = 3,      /* Tukey's fences: Q1 - k * IQR, Q3 + k * IQR */
+    STAT_OUTLIERS_MINK = 4      /* Minimum of each k consecutive values */
+};
+
+typedef struct {
+    int method;
+    double lb;                  /* Percents of minimal values (trim) */
+    double ub;                  /* Percents of maximal values (trim) */
+    double k;                   /* Parameter of mad, iqr and mink */
+} stat_outliers_t;
+
+/* Results of stationarity test of sequence */
+enum StatStationarity {
+    STAT_STATIONARY = 0,
+    STAT_DRIFT = 1,             /* Shift or trend of mean */
+    STAT_PERIODIC = 2           /* Significant autocorrelation */
 };
 
 typedef struct stat_sample stat_sample_t;
@@ -31,6 +57,21 @@ double stat_sample_max(stat_sample_t *sample);
 int stat_sample_min_index(stat_sample_t *sample);
 int stat_sample_max_index(stat_sample_t *sample);
 int stat_sample_size(stat_sample_t *sample);
+double stat_sample_quantile(stat_sample_t *sample, int quantile);
+double stat_quantile_prob(int quantile);
+
+/*
+ * stat_quantile_rank: Returns index of p-quantile in sorted dataset
+ *                     of size elements (nearest rank).
+ */
+int stat_quantile_rank(int size, double p);
+
+/*
+ * stat_dataset_quantiles: Computes exact quantiles StatQuantiles of dataset
+ *                         (nearest rank, as in bootstrap intervals).
+ *                         Dataset is not changed.
+ */
+void stat_dataset_quantiles(const double *data, int size, double *quantiles);
 
 double stat_mean(double *data, int size);
 double stat_var(double *data, int size);
@@ -45,7 +86,29 @@ int stat_max_index(double *data, int size);
 double stat_fmax2(double a, double b);
 double stat_fmin2(double a, double b);
 
-int stat_dataset_remove_outliers(double *data, int size, int lb, int ub);
-int stat_sample_confidence_interval(stat_sample_t *sample, int level,
+int stat_dataset_remove_outliers(double *data, int size, double lb, double ub);
+int stat_dataset_filter_outliers(double *data, int size,
+                                 const stat_outliers_t *filter);
+int stat_outliers_parse(const char *s, stat_outliers_t *filter);
+const char *stat_outliers_name(const stat_outliers_t *filter, char *buf,
+                               int size);
+int stat_dataset_transient_length(const double *data, int size);
+int stat_dataset_stationarity(const double *data, int size);
+const char *stat_stationarity_name(int stationarity);
+
+int stat_sample_confidence_interval(stat_sample_t *sample, double level,
                                     double *lb, double *ub, double *err);
+
+/*
+ * stat_tstud_quantile: Returns two-sided critical value of Student's
+ *                      t-distribution: P(|T| <= t) = p, df degrees of freedom.
+ */
+double stat_tstud_quantile(double p, int df);
+
+/*
+ * stat_tstud_pvalue: Returns two-sided p-value P(|T| > |t|) of Student's
+ *                    t-distribution with df (may be fractional) degrees
+ *                    of freedom.
+ */
+double stat_tstud_pvalue(double t, double df);
 #endif /* STAT_H */
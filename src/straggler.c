@@ -0,0 +1,173 @@
+/*
+ * straggler.c: Attribution of run time to the slowest process.
+ *
+ * Time of collective run is the time of the slowest process. Instead
+ * of MPI_MAX the times are reduced by MPI_MAXLOC-like operation which
+ * also keeps the second maximum, so each process knows whether it
+ * determined time of run and by how much it delayed the others.
+ * Top stragglers are found by k rounds of MPI_Allreduce with MPI_MAXLOC,
+ * per process data are not gathered.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+#include <mpi.h>
+
+#include "straggler.h"
+#include "mpiperf.h"
+
+static MPI_Datatype stragglertype = MPI_DATATYPE_NULL;
+static MPI_Op stragglerop = MPI_OP_NULL;
+
+static int straggler_nslowest = 0;      /* Runs determined by this process */
+static int straggler_nruns = 0;         /* Correct runs of test */
+static double straggler_excess_sum = 0.0;
+
+static void straggler_merge(void *in, void *inout, int *len,
+                            MPI_Datatype *dtype);
+
+/* straggler_initialize: */
+int straggler_initialize()
+{
+    if (MPI_Type_contiguous(sizeof(straggler_t), MPI_BYTE,
+                            &stragglertype) != MPI_SUCCESS)
+    {
+        return MPIPERF_FAILURE;
+    }
+    MPI_Type_commit(&stragglertype);
+    if (MPI_Op_create(straggler_merge, 1, &stragglerop) != MPI_SUCCESS) {
+        MPI_Type_free(&stragglertype);
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* straggler_finalize: */
+void straggler_finalize()
+{
+    if (stragglerop != MPI_OP_NULL)
+        MPI_Op_free(&stragglerop);
+    if (stragglertype != MPI_DATATYPE_NULL)
+        MPI_Type_free(&stragglertype);
+}
+
+/* straggler_set: */
+void straggler_set(straggler_t *run, double time, int rank)
+{
+    run->max = time;
+    run->second = -DBL_MAX;
+    run->rank = rank;
+}
+
+/* straggler_allreduce: */
+int straggler_allreduce(straggler_t *in, straggler_t *out, int count,
+                        MPI_Comm comm)
+{
+    return MPI_Allreduce(in, out, count, stragglertype, stragglerop, comm);
+}
+
+/* straggler_excess: */
+double straggler_excess(straggler_t *run)
+{
+    return (run->second > -DBL_MAX) ? run->max - run->second : 0.0;
+}
+
+/* straggler_stat_reset: */
+void straggler_stat_reset()
+{
+    straggler_nslowest = 0;
+    straggler_nruns = 0;
+    straggler_excess_sum = 0.0;
+}
+
+/* straggler_stat_add: Accounts correct run (rank is rank of this process). */
+void straggler_stat_add(straggler_t *run, int rank)
+{
+    straggler_nruns++;
+    if (run->rank == rank) {
+        straggler_nslowest++;
+        straggler_excess_sum += straggler_excess(run);
+    }
+}
+
+/* report_write_stragglers: */
+int report_write_stragglers(MPI_Comm comm, int nprocs, int count)
+{
+    struct {
+        double val;
+        int rank;
+    } in, out;
+    struct {
+        int nslowest;
+        double excess;
+        char host[MPI_MAX_PROCESSOR_NAME];
+    } info;
+    const char *fmt = NULL;
+    double timescale;
+    int i, k, rank, len;
+
+    if (mpiperf_timescale == TIMESCALE_SEC) {
+        fmt = "# Straggler: procs %d, count %d, rank %d, host %s, slowest in %d of %d runs, excess %.6f sec. (%.6f per run)\n";
+        timescale = 1.0;
+    } else {
+        /* usec */
+        fmt = "# Straggler: procs %d, count %d, rank %d, host %s, slowest in %d of %d runs, excess %.2f usec. (%.2f per run)\n";
+        timescale = 1E6;
+    }
+
+    MPI_Comm_rank(comm, &rank);
+    in.val = (straggler_nslowest > 0) ? straggler_excess_sum : -1.0;
+    in.rank = rank;
+    k = (nprocs < mpiperf_nstragglers) ? nprocs : mpiperf_nstragglers;
+    for (i = 0; i < k; i++) {
+        MPI_Allreduce(&in, &out, 1, MPI_DOUBLE_INT, MPI_MAXLOC, comm);
+        if (out.val < 0.0) {
+            /* Other processes were never the slowest */
+            break;
+        }
+        if (out.rank == rank) {
+            in.val = -1.0;
+            info.nslowest = straggler_nslowest;
+            info.excess = straggler_excess_sum;
+            MPI_Get_processor_name(info.host, &len);
+        }
+        MPI_Bcast(&info, sizeof(info), MPI_BYTE, out.rank, comm);
+        if (IS_MASTER_RANK) {
+            printf(fmt, nprocs, count, out.rank, info.host, info.nslowest,
+                   straggler_nruns, info.excess * timescale,
+                   info.excess / info.nslowest * timescale);
+        }
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/*
+ * straggler_merge: User-defined reduction operation (MPI_Op): maximum
+ *                  with location (the lowest rank on ties) and the second
+ *                  maximum.
+ */
+static void straggler_merge(void *in, void *inout, int *len,
+                            MPI_Datatype *dtype)
+{
+    straggler_t *a = (straggler_t *)in;
+    straggler_t *b = (straggler_t *)inout;
+    int i;
+
+    for (i = 0; i < *len; i++) {
+        if (a[i].max > b[i].max ||
+            (a[i].max == b[i].max && a[i].rank < b[i].rank))
+        {
+            b[i].second = (b[i].max > a[i].second) ? b[i].max : a[i].second;
+            b[i].max = a[i].max;
+            b[i].rank = a[i].rank;
+        } else {
+            if (a[i].max > b[i].second)
+                b[i].second = a[i].max;
+        }
+    }
+}
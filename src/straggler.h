@@ -0,0 +1,51 @@
+/*
+ * straggler.h: Attribution of run time to the slowest process.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef STRAGGLER_H
+#define STRAGGLER_H
+
+#include <mpi.h>
+
+/* Time of run reduced over processes */
+typedef struct {
+    double max;         /* Time of the slowest process */
+    double second;      /* Time of the second slowest process */
+    int rank;           /* Rank of the slowest process */
+} straggler_t;
+
+/*
+ * straggler_initialize: Creates MPI datatype and reduction operation
+ *                       (MPI_MAXLOC with the second maximum).
+ */
+int straggler_initialize();
+void straggler_finalize();
+
+void straggler_set(straggler_t *run, double time, int rank);
+
+/* straggler_allreduce: Reduces times of count runs (one MPI_Allreduce). */
+int straggler_allreduce(straggler_t *in, straggler_t *out, int count,
+                        MPI_Comm comm);
+
+/*
+ * straggler_excess: Returns excess of the slowest process over the second
+ *                   slowest one (0 for one process).
+ */
+double straggler_excess(straggler_t *run);
+
+/*
+ * Per process statistics (-u): each process counts runs in which it was
+ * the slowest and cumulative excess time of these runs.
+ */
+void straggler_stat_reset();
+void straggler_stat_add(straggler_t *run, int rank);
+
+/*
+ * report_write_stragglers: Writes top stragglers by cumulative excess time
+ *                          and their hosts (collective on comm).
+ */
+int report_write_stragglers(MPI_Comm comm, int nprocs, int count);
+
+#endif /* STRAGGLER_H */
@@ -0,0 +1,33 @@
+/*
+ * tallreduce.c: Benchmark functions for Thread_Allreduce.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+
+#include <mpi.h>
+
+#include "tallreduce.h"
+#include "bench_thread.h"
+#include "mpiperf.h"
+#include "reduceop.h"
+
+int bench_tallreduce_printinfo()
+{
+    printf("* Thread_Allreduce\n"
+           "  proto: MPI_Allreduce(sbuf, rbuf, count, %s, %s, threadcomm)\n",
+           reduceop_typename(), reduceop_opname());
+    return MPIPERF_SUCCESS;
+}
+
+size_t bench_tallreduce_bufsize(threadtest_params_t *params)
+{
+    return params->count * reduceop_typesize();
+}
+
+int measure_tallreduce(threadtest_params_t *params, void *sbuf, void *rbuf)
+{
+    return MPI_Allreduce(sbuf, rbuf, params->count, reduceop_datatype(),
+                         reduceop_op(), params->comm);
+}
@@ -0,0 +1,18 @@
+/*
+ * tallreduce.h: Benchmark functions for Thread_Allreduce.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef TALLREDUCE_H
+#define TALLREDUCE_H
+
+#include "bench_thread.h"
+
+int bench_tallreduce_printinfo();
+size_t bench_tallreduce_bufsize(threadtest_params_t *params);
+int measure_tallreduce(threadtest_params_t *params, void *sbuf, void *rbuf);
+
+#endif /* TALLREDUCE_H */
@@ -0,0 +1,30 @@
+/*
+ * tbarrier.c: Benchmark functions for Thread_Barrier.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+
+#include <mpi.h>
+
+#include "tbarrier.h"
+#include "bench_thread.h"
+#include "mpiperf.h"
+
+int bench_tbarrier_printinfo()
+{
+    printf("* Thread_Barrier\n"
+           "  proto: MPI_Barrier(threadcomm)\n");
+    return MPIPERF_SUCCESS;
+}
+
+size_t bench_tbarrier_bufsize(threadtest_params_t *params)
+{
+    return 0;
+}
+
+int measure_tbarrier(threadtest_params_t *params, void *sbuf, void *rbuf)
+{
+    return MPI_Barrier(params->comm);
+}
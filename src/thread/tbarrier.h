@@ -0,0 +1,18 @@
+/*
+ * tbarrier.h: Benchmark functions for Thread_Barrier.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef TBARRIER_H
+#define TBARRIER_H
+
+#include "bench_thread.h"
+
+int bench_tbarrier_printinfo();
+size_t bench_tbarrier_bufsize(threadtest_params_t *params);
+int measure_tbarrier(threadtest_params_t *params, void *sbuf, void *rbuf);
+
+#endif /* TBARRIER_H */
@@ -0,0 +1,41 @@
+/*
+ * tsendrecv.c: Benchmark functions for Thread_Sendrecv.
+ *
+ * Each process sends message to the next process and receives message
+ * from the previous one (ring) in communicator of thread.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+
+#include <mpi.h>
+
+#include "tsendrecv.h"
+#include "bench_thread.h"
+#include "mpiperf.h"
+
+int bench_tsendrecv_printinfo()
+{
+    printf("* Thread_Sendrecv\n"
+           "  proto: MPI_Sendrecv(sbuf, count, MPI_BYTE, next, 0,\n"
+           "                      rbuf, count, MPI_BYTE, prev, 0, threadcomm)\n");
+    return MPIPERF_SUCCESS;
+}
+
+size_t bench_tsendrecv_bufsize(threadtest_params_t *params)
+{
+    return params->count * sizeof(char);
+}
+
+int measure_tsendrecv(threadtest_params_t *params, void *sbuf, void *rbuf)
+{
+    int rank;
+
+    MPI_Comm_rank(params->comm, &rank);
+    return MPI_Sendrecv(sbuf, params->count, MPI_BYTE,
+                        (rank + 1) % params->nprocs, 0,
+                        rbuf, params->count, MPI_BYTE,
+                        (rank - 1 + params->nprocs) % params->nprocs, 0,
+                        params->comm, MPI_STATUS_IGNORE);
+}
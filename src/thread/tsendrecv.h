@@ -0,0 +1,18 @@
+/*
+ * tsendrecv.h: Benchmark functions for Thread_Sendrecv.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <mpi.h>
+
+#ifndef TSENDRECV_H
+#define TSENDRECV_H
+
+#include "bench_thread.h"
+
+int bench_tsendrecv_printinfo();
+size_t bench_tsendrecv_bufsize(threadtest_params_t *params);
+int measure_tsendrecv(threadtest_params_t *params, void *sbuf, void *rbuf);
+
+#endif /* TSENDRECV_H */
@@ -115,6 +115,18 @@ double timeslot_stopsync()
     return hpctimer_wtime();
 }
 
+/* timeslot_last_starttime: */
+double timeslot_last_starttime()
+{
+    return timeslot_slotstart;
+}
+
+/* timeslot_last_stoptime: */
+double timeslot_last_stoptime()
+{
+    return timeslot_slotstop;
+}
+
 /* timeslot_finalize: */
 void timeslot_finalize()
 {
@@ -35,6 +35,13 @@ double timeslot_startsync();
  */
 double timeslot_stopsync();
 
+/*
+ * timeslot_last_starttime, timeslot_last_stoptime: Return local timestamps
+ *                          of the last timeslot_startsync/stopsync calls.
+ */
+double timeslot_last_starttime();
+double timeslot_last_stoptime();
+
 /* timeslot_finalize: */
 void timeslot_finalize();
 
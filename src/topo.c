@@ -0,0 +1,155 @@
+/*
+ * topo.c: Virtual topologies for neighborhood collectives.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+
+#include <mpi.h>
+
+#include "topo.h"
+#include "mpiperf.h"
+#include "util.h"
+
+static MPI_Comm topo_create_cart(MPI_Comm comm, int ndims);
+static MPI_Comm topo_create_graph(MPI_Comm comm, int degree);
+
+/* topo_parse: Parses topology string: cart2d, cart3d, graph[:k]. */
+int topo_parse(const char *s, int *type, int *degree)
+{
+    const char *p;
+
+    if (strcasecmp(s, "cart2d") == 0) {
+        *type = TOPO_CART2D;
+    } else if (strcasecmp(s, "cart3d") == 0) {
+        *type = TOPO_CART3D;
+    } else if (strncasecmp(s, "graph", 5) == 0) {
+        *type = TOPO_GRAPH;
+        *degree = TOPO_GRAPH_DEGREE_DEFAULT;
+        if ( (p = strchr(s, ':')) != NULL) {
+            *degree = atoi(p + 1);
+            if (*degree < 1)
+                return MPIPERF_FAILURE;
+        }
+    } else {
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* topo_createcomm: Creates communicator with virtual topology. */
+MPI_Comm topo_createcomm(MPI_Comm comm)
+{
+    if (mpiperf_topo == TOPO_CART3D) {
+        return topo_create_cart(comm, 3);
+    } else if (mpiperf_topo == TOPO_GRAPH) {
+        return topo_create_graph(comm, mpiperf_topo_degree);
+    }
+    return topo_create_cart(comm, 2);
+}
+
+/* topo_neighbors_count: Returns number of neighbors of calling process. */
+int topo_neighbors_count(MPI_Comm topocomm, int *indegree, int *outdegree)
+{
+    int status, ndims, weighted;
+
+    MPI_Topo_test(topocomm, &status);
+    if (status == MPI_CART) {
+        /* Two neighbors in each dimension (they are counted even if equal) */
+        MPI_Cartdim_get(topocomm, &ndims);
+        *indegree = 2 * ndims;
+        *outdegree = 2 * ndims;
+    } else if (status == MPI_DIST_GRAPH) {
+        MPI_Dist_graph_neighbors_count(topocomm, indegree, outdegree,
+                                       &weighted);
+    } else {
+        *indegree = 0;
+        *outdegree = 0;
+        return MPIPERF_FAILURE;
+    }
+    return MPIPERF_SUCCESS;
+}
+
+/* topo_print_info: Prints topology for report header. */
+void topo_print_info()
+{
+    if (mpiperf_topo == TOPO_CART3D) {
+        printf("# Topology: 3D periodic Cartesian grid\n");
+    } else if (mpiperf_topo == TOPO_GRAPH) {
+        printf("# Topology: random %d-regular distributed graph\n",
+               mpiperf_topo_degree);
+    } else {
+        printf("# Topology: 2D periodic Cartesian grid\n");
+    }
+}
+
+/* topo_create_cart: Creates periodic grid with balanced dimensions. */
+static MPI_Comm topo_create_cart(MPI_Comm comm, int ndims)
+{
+    int dims[3] = {0, 0, 0}, periods[3] = {1, 1, 1};
+    int nprocs;
+    MPI_Comm cartcomm;
+
+    MPI_Comm_size(comm, &nprocs);
+    MPI_Dims_create(nprocs, ndims, dims);
+    MPI_Cart_create(comm, ndims, dims, periods, 0, &cartcomm);
+    return cartcomm;
+}
+
+/*
+ * topo_create_graph: Creates random k-regular undirected graph.
+ *
+ * Graph is circulant: process i is connected with i + d and i - d (mod n)
+ * for each offset d from the set D of k/2 distinct offsets in [1, (n-1)/2].
+ * For odd k and even n the offset n/2 is added. Offsets are chosen randomly
+ * with the same seed in all processes, so no communication is required.
+ * Degree is decreased if there are not enough distinct neighbors.
+ */
+static MPI_Comm topo_create_graph(MPI_Comm comm, int degree)
+{
+    int nprocs, rank, noffsets, maxoffsets, nneighbors, i;
+    int *offsets, *neighbors, *weights;
+    uint64_t seed = RNG_SEED;
+    MPI_Comm graphcomm;
+
+    MPI_Comm_size(comm, &nprocs);
+    MPI_Comm_rank(comm, &rank);
+
+    if (degree > nprocs - 1)
+        degree = nprocs - 1;
+    maxoffsets = (nprocs - 1) / 2;
+    noffsets = degree / 2;
+
+    /* Random permutation of offsets 1, 2, ..., maxoffsets */
+    offsets = xmalloc(sizeof(*offsets) * (maxoffsets + 1));
+    for (i = 0; i < maxoffsets; i++)
+        offsets[i] = i + 1;
+    rng_shuffle(&seed, offsets, maxoffsets);
+
+    neighbors = xmalloc(sizeof(*neighbors) * (degree + 1));
+    weights = xmalloc(sizeof(*weights) * (degree + 1));
+    nneighbors = 0;
+    for (i = 0; i < noffsets; i++) {
+        neighbors[nneighbors++] = (rank + offsets[i]) % nprocs;
+        neighbors[nneighbors++] = (rank - offsets[i] + nprocs) % nprocs;
+    }
+    if ((degree % 2) && (nprocs % 2 == 0))
+        neighbors[nneighbors++] = (rank + nprocs / 2) % nprocs;
+
+    /* Unit weights instead of MPI_UNWEIGHTED (sentinel pointer confuses GCC) */
+    for (i = 0; i < nneighbors; i++)
+        weights[i] = 1;
+
+    MPI_Dist_graph_create_adjacent(comm, nneighbors, neighbors, weights,
+                                   nneighbors, neighbors, weights,
+                                   MPI_INFO_NULL, 0, &graphcomm);
+    free(weights);
+    free(neighbors);
+    free(offsets);
+    return graphcomm;
+}
@@ -0,0 +1,40 @@
+/*
+ * topo.h: Virtual topologies for neighborhood collectives.
+ *
+ * Copyright (C) 2012 Mikhail Kurnosov
+ */
+
+#ifndef TOPO_H
+#define TOPO_H
+
+#include <mpi.h>
+
+#if MPI_VERSION >= 3
+#define HAVE_NEIGHBOR_COLL
+#endif
+
+enum TopoType {
+    TOPO_CART2D = 0,    /* 2D periodic Cartesian grid */
+    TOPO_CART3D = 1,    /* 3D periodic Cartesian grid */
+    TOPO_GRAPH = 2      /* Random k-regular distributed graph */
+};
+
+enum {
+    TOPO_GRAPH_DEGREE_DEFAULT = 4
+};
+
+/* topo_parse: Parses topology string: cart2d, cart3d, graph[:k]. */
+int topo_parse(const char *s, int *type, int *degree);
+
+/*
+ * topo_createcomm: Creates communicator with virtual topology
+ *                  (-k option) on processes of comm (collective call).
+ */
+MPI_Comm topo_createcomm(MPI_Comm comm);
+
+/* topo_neighbors_count: Returns number of neighbors of calling process. */
+int topo_neighbors_count(MPI_Comm topocomm, int *indegree, int *outdegree);
+
+void topo_print_info();
+
+#endif /* TOPO_H */
@@ -158,3 +158,76 @@ int parse_intval(char *s)
     return val * scale;
 }
 
+/*
+ * thread_level_lookup: Returns MPI thread level by name (single, funneled,
+ *                      serialized, multiple) or -1.
+ */
+int thread_level_lookup(const char *name)
+{
+    if (strcasecmp(name, "single") == 0)
+        return MPI_THREAD_SINGLE;
+    else if (strcasecmp(name, "funneled") == 0)
+        return MPI_THREAD_FUNNELED;
+    else if (strcasecmp(name, "serialized") == 0)
+        return MPI_THREAD_SERIALIZED;
+    else if (strcasecmp(name, "multiple") == 0)
+        return MPI_THREAD_MULTIPLE;
+    return -1;
+}
+
+/* thread_level_name: */
+const char *thread_level_name(int level)
+{
+    if (level == MPI_THREAD_SINGLE)
+        return "MPI_THREAD_SINGLE";
+    else if (level == MPI_THREAD_FUNNELED)
+        return "MPI_THREAD_FUNNELED";
+    else if (level == MPI_THREAD_SERIALIZED)
+        return "MPI_THREAD_SERIALIZED";
+    else if (level == MPI_THREAD_MULTIPLE)
+        return "MPI_THREAD_MULTIPLE";
+    return "unknown";
+}
+
+/* rng_next: xorshift64* generator. */
+uint64_t rng_next(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+ * rng_range: Returns uniformly distributed integer in [0, n).
+ *            Values of the incomplete last interval of size n are
+ *            rejected, so the reduction by modulo is unbiased.
+ */
+int rng_range(uint64_t *state, int n)
+{
+    uint64_t x, limit;
+
+    if (n <= 1)
+        return 0;
+    limit = UINT64_MAX - UINT64_MAX % (uint64_t)n;
+    do {
+        x = rng_next(state);
+    } while (x >= limit);
+    return (int)(x % (uint64_t)n);
+}
+
+/* rng_shuffle: */
+void rng_shuffle(uint64_t *state, int *a, int n)
+{
+    int i, j, t;
+
+    for (i = n - 1; i > 0; i--) {
+        j = rng_range(state, i + 1);
+        t = a[i];
+        a[i] = a[j];
+        a[j] = t;
+    }
+}
@@ -7,8 +7,14 @@
 #ifndef UTIL_H
 #define UTIL_H
 
+#include <stdint.h>
+
 #include <mpi.h>
 
+enum {
+    RNG_SEED = 12345    /* Seed of sequences which are the same in all processes */
+};
+
 void *xmalloc(size_t size);
 void *xrealloc(void *ptr, size_t size);
 void print_error(const char *format, ...);
@@ -17,6 +23,21 @@ void exit_success();
 int getworldrank(MPI_Comm comm, int rank);
 MPI_Comm createcomm(MPI_Comm comm, int size);
 int parse_intval(char *s);
+int thread_level_lookup(const char *name);
+const char *thread_level_name(int level);
+
+/*
+ * rng_next: xorshift64* generator. State must be nonzero.
+ *           Sequence depends only on the state, so processes started
+ *           with the same state get the same sequence.
+ */
+uint64_t rng_next(uint64_t *state);
+
+/* rng_range: Returns uniformly distributed integer in [0, n). */
+int rng_range(uint64_t *state, int n);
+
+/* rng_shuffle: Random permutation of array a[0..n-1] (Fisher-Yates). */
+void rng_shuffle(uint64_t *state, int *a, int n);
 
 #endif /* UTIL_H */
 